@@ -0,0 +1,538 @@
+#pragma once
+
+#include <HTTPClient.h>
+#include <WiFiClientSecure.h>
+
+// ---------------------------------------------------------------------------
+// Shared keep-alive HTTPS connection pool
+//
+// Every data source used to `new WiFiClientSecure` per request and pay a full
+// TLS handshake.  Here each host gets one persistent WiFiClientSecure +
+// HTTPClient pair, so back-to-back requests (3x SWPC, /points + /forecast,
+// forecast <-> alerts) reuse one TLS session over HTTP/1.1 keep-alive.
+//
+// An idle session still holds ~40 KB of mbedTLS buffers, so slots are
+// LRU-evicted and pool_tick() closes anything idle for POOL_IDLE_MS.
+// ---------------------------------------------------------------------------
+#define POOL_SLOTS        2
+#define POOL_IDLE_MS      (20UL * 1000UL)   // close sessions idle this long
+#define POOL_TIMEOUT_MS   15000             // per-request read timeout
+#define POOL_MAX_REDIRECT 3
+#define POOL_MIN_HEAP     (48 * 1024)       // drop idle sessions below this
+#define POOL_POLL_MS      10                // socket poll step while waiting for data
+#define POOL_ERROR_CANCELLED (-100)         // request abandoned via its cancel token
+
+struct PoolConn {
+  char             host[64];   // "" = free slot
+  WiFiClientSecure client;
+  HTTPClient       http;
+  unsigned long    last_used;
+  bool             busy;       // between pool_get() and pool_end()
+};
+
+static PoolConn pool_slots[POOL_SLOTS];
+
+// Stats (printed by loop() with the heap line)
+static uint32_t pool_requests   = 0;
+static uint32_t pool_handshakes = 0;
+
+// Response headers the pool exposes via conn->http.header(...)
+static const char *pool_header_keys[] = {
+  "Location", "Transfer-Encoding", "ETag", "Last-Modified"
+};
+
+// Cache validators for conditional GET (If-None-Match / If-Modified-Since)
+struct PoolValidator {
+  char etag[72];
+  char last_modified[32];
+};
+
+static void pool_validator_clear(PoolValidator *v) {
+  v->etag[0] = v->last_modified[0] = '\0';
+}
+
+// Cancellation token: the work is abandoned once *gen moves away from want.
+// The owner of the pool installs one in pool_cancel for the request in
+// progress; every socket wait polls it, so a transfer dies within one
+// POOL_POLL_MS step instead of running out its POOL_TIMEOUT_MS.
+struct PoolCancel {
+  const volatile uint32_t *gen;
+  uint32_t                 want;
+};
+
+static const PoolCancel *pool_cancel = nullptr;
+
+static bool pool_cancelled(const PoolCancel *t) {
+  return t && *t->gen != t->want;
+}
+
+// Copy the host part of "https://host/path" into out. Returns false if malformed.
+static bool pool_host_of(const String &url, char *out, size_t outLen) {
+  int s = url.indexOf("://");
+  if (s < 0) return false;
+  s += 3;
+  int e = s;
+  while (e < (int)url.length() && url[e] != '/' && url[e] != ':' && url[e] != '?') e++;
+  if (e == s || (size_t)(e - s) >= outLen) return false;
+  memcpy(out, url.c_str() + s, e - s);
+  out[e - s] = '\0';
+  return true;
+}
+
+static void pool_close(PoolConn *c) {
+  if (c->client.connected()) Serial.printf("[Pool] close %s\n", c->host);
+  c->client.stop();
+  c->host[0] = '\0';
+  c->busy    = false;
+}
+
+// Close every idle session (WiFi loss, portal, or before a big allocation)
+static void pool_close_all() {
+  for (int i = 0; i < POOL_SLOTS; i++) {
+    if (!pool_slots[i].busy) pool_close(&pool_slots[i]);
+  }
+}
+
+// Find the slot for host, or claim a free / least-recently-used one.
+static PoolConn *pool_acquire(const char *host) {
+  PoolConn *victim = nullptr;
+  for (int i = 0; i < POOL_SLOTS; i++) {
+    PoolConn *c = &pool_slots[i];
+    if (!c->busy && strcmp(c->host, host) == 0) return c;
+  }
+  for (int i = 0; i < POOL_SLOTS; i++) {
+    PoolConn *c = &pool_slots[i];
+    if (c->busy) continue;
+    if (c->host[0] == '\0') { victim = c; break; }
+    if (!victim || c->last_used < victim->last_used) victim = c;
+  }
+  if (!victim) return nullptr;
+
+  pool_close(victim);
+  // A second TLS session must not starve the first of heap
+  if (ESP.getMaxAllocHeap() < POOL_MIN_HEAP) pool_close_all();
+
+  strncpy(victim->host, host, sizeof(victim->host) - 1);
+  victim->host[sizeof(victim->host) - 1] = '\0';
+  victim->client.setInsecure();
+  victim->http.setReuse(true);
+  victim->http.setTimeout(POOL_TIMEOUT_MS);
+  // Redirects are followed by pool_get() so they land on the right slot
+  victim->http.setFollowRedirects(HTTPC_DISABLE_FOLLOW_REDIRECTS);
+  return victim;
+}
+
+// Finish a request started by pool_get(). Pass keep=false when the body was
+// not read to its end — leftover bytes would corrupt the next response.
+static void pool_end(PoolConn *c, bool keep = true) {
+  if (!c) return;
+  c->http.end();
+  c->busy      = false;
+  c->last_used = millis();
+  if (!keep) pool_close(c);
+}
+
+static bool pool_is_redirect(int code) {
+  return code == 301 || code == 302 || code == 307 || code == 308;
+}
+
+// Issue a GET on the pooled connection for url's host.
+// hdrs is a nullptr-terminated list of name/value pairs.
+// If v is given the request is conditional on its stored validators (a 304
+// means the resource is unchanged and has no body), and a 200 refreshes them.
+// On return *conn holds the response (caller must pool_end() it), or is
+// nullptr if no request could be made. Returns the HTTP code (<0 on error).
+static int pool_get(String url, const char *const *hdrs, PoolConn **conn,
+                    PoolValidator *v = nullptr) {
+  *conn = nullptr;
+  for (int hop = 0; hop <= POOL_MAX_REDIRECT; hop++) {
+    if (pool_cancelled(pool_cancel)) return POOL_ERROR_CANCELLED;
+    char host[64];
+    if (!pool_host_of(url, host, sizeof(host))) return HTTPC_ERROR_CONNECTION_REFUSED;
+    PoolConn *c = pool_acquire(host);
+    if (!c) return HTTPC_ERROR_CONNECTION_REFUSED;
+    if (!c->http.begin(c->client, url)) {
+      pool_close(c);
+      return HTTPC_ERROR_CONNECTION_REFUSED;
+    }
+    c->busy = true;
+    for (const char *const *h = hdrs; h && h[0]; h += 2) c->http.addHeader(h[0], h[1]);
+    if (v && v->etag[0])          c->http.addHeader("If-None-Match",     v->etag);
+    if (v && v->last_modified[0]) c->http.addHeader("If-Modified-Since", v->last_modified);
+    c->http.collectHeaders(pool_header_keys, sizeof(pool_header_keys) / sizeof(pool_header_keys[0]));
+
+    bool warm = c->client.connected();
+    int code = c->http.GET();
+    pool_requests++;
+    if (!warm) pool_handshakes++;
+    if ((code == HTTPC_ERROR_CONNECTION_LOST || code == HTTPC_ERROR_SEND_HEADER_FAILED) && warm &&
+        !pool_cancelled(pool_cancel)) {
+      // Server dropped the idle keep-alive session before answering — reconnect
+      // once. A read timeout is not retried: the server may have the request.
+      Serial.printf("[Pool] stale session to %s, reconnecting\n", host);
+      pool_handshakes++;
+      code = c->http.GET();
+    }
+
+    if (pool_is_redirect(code)) {
+      String loc = c->http.header("Location");
+      int len = c->http.getSize();
+      if (len > 0) c->http.getString();  // drain so the session stays reusable
+      pool_end(c, len >= 0);
+      if (loc.isEmpty()) return code;
+      if (loc[0] == '/') {
+        int p = url.indexOf('/', url.indexOf("://") + 3);
+        url = (p < 0 ? url : url.substring(0, p)) + loc;
+      } else {
+        url = loc;
+      }
+      Serial.printf("[Pool] redirect -> %s\n", url.c_str());
+      continue;
+    }
+    if (code < 0) {
+      pool_end(c, false);
+      return code;
+    }
+    if (v && code == HTTP_CODE_OK) {
+      c->http.header("ETag").toCharArray(v->etag, sizeof(v->etag));
+      c->http.header("Last-Modified").toCharArray(v->last_modified, sizeof(v->last_modified));
+    }
+    *conn = c;
+    return code;
+  }
+  return HTTPC_ERROR_CONNECTION_REFUSED;
+}
+
+// ---------------------------------------------------------------------------
+// Body framing for raw socket reads
+//
+// HTTPClient only de-chunks inside getString()/writeToStream(). Code that
+// reads the socket itself (JPEG streaming, fixed buffers, file downloads)
+// goes through PoolBody instead: it understands Content-Length, chunked and
+// connection-close framing, writes straight into the caller's buffer, and
+// flags end-of-body the moment the last byte arrives rather than waiting out
+// the read timeout.
+// ---------------------------------------------------------------------------
+struct PoolBody {
+  PoolConn *conn;
+  const PoolCancel *cancel;  // pool_cancel when the body was started
+  int32_t   left;      // bytes left in the body / current chunk (-1 = until close)
+  int32_t   total;     // body bytes delivered so far
+  bool      chunked;
+  bool      framed;    // length known up front (Content-Length or chunked)
+  bool      done;      // body fully consumed, framing included
+  bool      error;     // bad framing or timeout — session is not reusable
+};
+
+// Wait for body bytes. Returns the number available, or 0 on timeout, close
+// or cancellation (sets b->error unless the peer closed cleanly).
+static int pool_body_wait(PoolBody *b) {
+  WiFiClientSecure &cl = b->conn->client;
+  unsigned long t0 = millis();
+  int avail;
+  while ((avail = cl.available()) <= 0) {
+    if (pool_cancelled(b->cancel)) { b->error = true; return 0; }
+    if (!cl.connected()) return 0;
+    if (millis() - t0 >= POOL_TIMEOUT_MS) { b->error = true; return 0; }
+    delay(POOL_POLL_MS);
+  }
+  return avail;
+}
+
+// Read one CRLF-terminated line into buf (truncated to len-1). False on timeout.
+static bool pool_body_line(PoolBody *b, char *buf, size_t len) {
+  size_t n = 0;
+  for (;;) {
+    if (pool_body_wait(b) <= 0) return false;
+    int ch = b->conn->client.read();
+    if (ch < 0) return false;
+    if (ch == '\n') break;
+    if (ch != '\r' && n + 1 < len) buf[n++] = (char)ch;
+  }
+  buf[n] = '\0';
+  return true;
+}
+
+// Parse the next chunk-size line; after the 0-chunk, skip trailers and finish.
+static void pool_body_next_chunk(PoolBody *b) {
+  char line[24];
+  if (!pool_body_line(b, line, sizeof(line))) { b->error = true; return; }
+  char *end;
+  long size = strtol(line, &end, 16);  // stops at any ";ext"
+  if (end == line || size < 0) { b->error = true; return; }
+  if (size > 0) { b->left = size; return; }
+  do {
+    if (!pool_body_line(b, line, sizeof(line))) { b->error = true; return; }
+  } while (line[0]);
+  b->done = true;
+}
+
+// Set up framing for a body that starts at the current socket position.
+// length is the Content-Length, or -1 for none.
+static void pool_body_frame(PoolBody *b, bool chunked, int32_t length) {
+  b->total   = 0;
+  b->done    = false;
+  b->error   = false;
+  b->chunked = chunked;
+  if (chunked) {
+    b->framed = true;
+    b->left   = 0;
+    pool_body_next_chunk(b);
+  } else {
+    b->left   = length;
+    b->framed = (length >= 0);
+    if (length == 0) b->done = true;
+  }
+}
+
+// Start reading the body of a response obtained from pool_get().
+static void pool_body_begin(PoolBody *b, PoolConn *c) {
+  b->conn   = c;
+  b->cancel = pool_cancel;
+  b->error  = false;
+  pool_body_frame(b, c->http.header("Transfer-Encoding").indexOf("chunked") >= 0,
+                  c->http.getSize());  // -1 when there is no Content-Length
+}
+
+// Read up to len body bytes into buf. Returns the byte count; 0 at end of
+// body or on error (check b->done / b->error).
+static int32_t pool_body_read(PoolBody *b, uint8_t *buf, int32_t len) {
+  WiFiClientSecure &cl = b->conn->client;
+  int32_t got = 0;
+  while (got < len && !b->done && !b->error) {
+    if (b->chunked && b->left == 0) {
+      // End of chunk data: CRLF, then the next size line
+      char crlf[4];
+      if (!pool_body_line(b, crlf, sizeof(crlf)) || crlf[0]) { b->error = true; break; }
+      pool_body_next_chunk(b);
+      continue;
+    }
+    int32_t want = len - got;
+    if (b->left > 0 && want > b->left) want = b->left;
+
+    // Take whatever has arrived; waits poll the cancel token
+    int avail = pool_body_wait(b);
+    if (avail <= 0) {
+      if (b->error) break;
+      if (b->left < 0) b->done  = true;  // close-delimited: peer closed = end
+      else             b->error = true;  // closed mid-body
+      break;
+    }
+    int32_t r = cl.read(buf + got, want < avail ? want : avail);
+    if (r <= 0) { b->error = true; break; }
+
+    got      += r;
+    b->total += r;
+    if (b->left > 0) {
+      b->left -= r;
+      if (b->left == 0 && !b->chunked) b->done = true;
+    }
+  }
+  return got;
+}
+
+// True if the body was consumed exactly, so the session can serve another request
+static bool pool_body_reusable(const PoolBody *b) {
+  return b->framed && b->done && !b->error;
+}
+
+// GET a URL over the pool and return the body as a String (200 only).
+// Read through PoolBody so a cancelled job stops mid-body. With a validator
+// the GET is conditional; pass code to tell a 304 apart from an error.
+static String pool_get_string(const String &url, const char *const *hdrs, const char *tag,
+                              PoolValidator *v = nullptr, int *code_out = nullptr) {
+  PoolConn *c;
+  int code = pool_get(url, hdrs, &c, v);
+  if (code_out) *code_out = code;
+  String body;
+  if (code == HTTP_CODE_NOT_MODIFIED && v) {
+    pool_end(c);  // no body, session stays warm
+    return body;
+  }
+  if (code != HTTP_CODE_OK) {
+    if (code == POOL_ERROR_CANCELLED) Serial.printf("[%s] cancelled\n", tag);
+    else                              Serial.printf("[%s] HTTP error: %d\n", tag, code);
+    pool_end(c, false);  // error bodies are left unread
+    return body;
+  }
+  PoolBody b;
+  pool_body_begin(&b, c);
+  if (b.left > 0) body.reserve(b.left);
+  uint8_t buf[512];
+  int32_t n;
+  while ((n = pool_body_read(&b, buf, sizeof(buf))) > 0) body.concat((const char *)buf, n);
+  if (!b.done) {
+    Serial.printf("[%s] body %s after %d B\n", tag,
+                  pool_cancelled(b.cancel) ? "cancelled" : "truncated", (int)b.total);
+    body = String();
+    if (v) pool_validator_clear(v);  // never 304 against a body we dropped
+  }
+  pool_end(c, pool_body_reusable(&b));
+  return body;
+}
+
+// ---------------------------------------------------------------------------
+// Pipelined GETs
+//
+// HTTPClient sends one request and waits for its response, so n small GETs
+// to one host cost n round trips even on a warm session. pool_pipeline()
+// writes all n requests back-to-back on the host's pooled socket and then
+// reads the responses as they arrive — HTTP/1.1 returns them in request
+// order — handing each to the sink framed as a PoolBody. Whatever the sink
+// leaves unread is drained before the next response is parsed.
+//
+// Servers may refuse to pipeline (Connection: close, or dropping the socket
+// part way); every request the pipeline did not answer is then re-issued
+// one at a time through pool_get(), so the sink always sees all n. So is
+// every 3xx, which pool_get() follows. A server that goes quiet is not
+// asked again: once a read times out the rest fail with that code.
+// ---------------------------------------------------------------------------
+#define POOL_PIPE_MAX   4
+#define POOL_PIPE_DRAIN (16 * 1024)   // past this, closing beats draining
+
+// One response: code is the HTTP status (<0 if none came) and body is framed
+// at its first byte, or nullptr when there is no body to read.
+typedef void (*PoolPipeSink)(void *ctx, int index, int code, PoolBody *body);
+
+// Why a response head could not be read: the request was cancelled, the
+// server went quiet, or it hung up (closed_code says whether before a byte).
+static int pool_raw_failure(PoolBody *b, int closed_code) {
+  if (pool_cancelled(b->cancel)) return POOL_ERROR_CANCELLED;
+  return b->error ? HTTPC_ERROR_READ_TIMEOUT : closed_code;
+}
+
+// Read a raw status line and headers into b's framing. Returns the status
+// code, or HTTPC_ERROR_CONNECTION_LOST if the peer closed before sending a
+// byte (the only failure a fresh session can fix), HTTPC_ERROR_READ_TIMEOUT
+// if it went quiet, or HTTPC_ERROR_NO_HTTP_SERVER for a cut or garbled head.
+// *keep is cleared if the server will close the session after this response.
+static int pool_raw_response(PoolBody *b, bool *keep) {
+  char line[96];
+  b->total = 0;
+  b->error = false;
+  if (pool_body_wait(b) <= 0) return pool_raw_failure(b, HTTPC_ERROR_CONNECTION_LOST);
+  if (!pool_body_line(b, line, sizeof(line))) return pool_raw_failure(b, HTTPC_ERROR_NO_HTTP_SERVER);
+  if (strncmp(line, "HTTP/1.", 7) != 0) return HTTPC_ERROR_NO_HTTP_SERVER;
+  int code = atoi(line + 9);
+  if (line[7] == '0') *keep = false;  // HTTP/1.0 closes by default
+
+  bool    chunked = false;
+  int32_t length  = -1;
+  for (;;) {
+    if (!pool_body_line(b, line, sizeof(line))) return pool_raw_failure(b, HTTPC_ERROR_NO_HTTP_SERVER);
+    if (!line[0]) break;
+    if (strncasecmp(line, "Content-Length:", 15) == 0) {
+      length = atol(line + 15);
+    } else if (strncasecmp(line, "Transfer-Encoding:", 18) == 0) {
+      chunked = strstr(line + 18, "chunked") != nullptr;
+    } else if (strncasecmp(line, "Connection:", 11) == 0) {
+      if (strstr(line + 11, "close") || strstr(line + 11, "Close")) *keep = false;
+    }
+  }
+  if (code == HTTP_CODE_NOT_MODIFIED || code == HTTP_CODE_NO_CONTENT) length = 0;
+  pool_body_frame(b, chunked, length);
+  return code;
+}
+
+// Issue n GETs for paths on host, pipelined on one session. hdrs (name/value
+// pairs, nullptr-terminated) go on every request. Returns how many responses
+// the sink got over the pipeline; the rest were fetched one by one.
+static int pool_pipeline(const char *host, const char *const *paths, int n,
+                         const char *const *hdrs, PoolPipeSink sink, void *ctx) {
+  if (n > POOL_PIPE_MAX) n = POOL_PIPE_MAX;
+  int      got        = 0;   // responses read off the pipeline, 3xx included
+  int      fail       = 0;   // why the pipeline stopped short, 0 = it did not
+  uint32_t redirected = 0;   // bit i: request i answered 3xx
+
+  PoolConn *c = pool_cancelled(pool_cancel) ? nullptr : pool_acquire(host);
+  for (int attempt = 0; c && attempt < 2 && got == 0; attempt++) {
+    fail = 0;
+    c->busy = true;
+    bool warm = c->client.connected();
+    if (!warm) {
+      pool_handshakes++;
+      if (!c->client.connect(host, 443)) break;
+    }
+
+    String req;
+    req.reserve(n * 160);
+    for (int i = 0; i < n; i++) {
+      req += "GET "; req += paths[i]; req += " HTTP/1.1\r\nHost: "; req += host;
+      req += "\r\nUser-Agent: ESP32HTTPClient\r\nConnection: keep-alive\r\n";
+      for (const char *const *h = hdrs; h && h[0]; h += 2) {
+        req += h[0]; req += ": "; req += h[1]; req += "\r\n";
+      }
+      req += "\r\n";
+    }
+    if (c->client.write((const uint8_t *)req.c_str(), req.length()) != req.length()) {
+      pool_close(c);
+      c = pool_acquire(host);
+      continue;
+    }
+    pool_requests += n;
+
+    PoolBody b;
+    b.conn   = c;
+    b.cancel = pool_cancel;
+    bool keep = true;
+    while (got < n && keep) {
+      int code = pool_raw_response(&b, &keep);
+      if (code < 0) { fail = code; break; }
+      if (pool_is_redirect(code)) redirected |= 1u << got;
+      else                        sink(ctx, got, code, &b);
+      uint8_t junk[256];
+      int32_t drained = 0, r;
+      while (!b.done && !b.error && drained < POOL_PIPE_DRAIN &&
+             (r = pool_body_read(&b, junk, sizeof(junk))) > 0) drained += r;
+      got++;
+      if (!pool_body_reusable(&b)) { keep = false; break; }
+    }
+    if (got == 0 && warm && fail == HTTPC_ERROR_CONNECTION_LOST && !pool_cancelled(pool_cancel)) {
+      // Server dropped the idle keep-alive session — reconnect once
+      Serial.printf("[Pool] stale session to %s, reconnecting\n", host);
+      pool_close(c);
+      c = pool_acquire(host);
+      continue;
+    }
+    c->busy      = false;
+    c->last_used = millis();
+    if (!keep || got < n) pool_close(c);
+    break;
+  }
+  if (c && c->busy) pool_close(c);
+
+  // Anything the pipeline did not answer (or redirected) goes the slow way
+  int piped = 0;
+  for (int i = 0; i < n; i++) {
+    if (i < got && !(redirected & (1u << i))) {
+      piped++;
+      continue;
+    }
+    if (i >= got && fail == HTTPC_ERROR_READ_TIMEOUT) {
+      sink(ctx, i, fail, nullptr);
+      continue;
+    }
+    Serial.printf("[Pool] %s: request %d of %d sequential (%s)\n", host, i + 1, n,
+                  i < got ? "redirected" : "not answered");
+    String url = String("https://") + host + paths[i];
+    PoolConn *sc;
+    int code = pool_get(url, hdrs, &sc);
+    if (!sc) {
+      sink(ctx, i, code, nullptr);
+      continue;
+    }
+    PoolBody b;
+    pool_body_begin(&b, sc);
+    sink(ctx, i, code, &b);
+    pool_end(sc, pool_body_reusable(&b));
+  }
+  return piped;
+}
+
+// Call from the pool owner between requests: releases TLS sessions nobody has used for POOL_IDLE_MS
+static void pool_tick() {
+  for (int i = 0; i < POOL_SLOTS; i++) {
+    PoolConn *c = &pool_slots[i];
+    if (!c->busy && c->host[0] && millis() - c->last_used > POOL_IDLE_MS) pool_close(c);
+  }
+}
@@ -4,153 +4,104 @@
 #include <HTTPClient.h>
 #include <WiFiClientSecure.h>
 
-/* https://www.nmc.cn/publish/satellite/fy4b-visible.htm */
-const char *rootCACertificate = R"string_literal(
------BEGIN CERTIFICATE-----
-MIIFjTCCA3WgAwIBAgIEGErM1jANBgkqhkiG9w0BAQsFADBWMQswCQYDVQQGEwJD
-TjEwMC4GA1UECgwnQ2hpbmEgRmluYW5jaWFsIENlcnRpZmljYXRpb24gQXV0aG9y
-aXR5MRUwEwYDVQQDDAxDRkNBIEVWIFJPT1QwHhcNMTIwODA4MDMwNzAxWhcNMjkx
-MjMxMDMwNzAxWjBWMQswCQYDVQQGEwJDTjEwMC4GA1UECgwnQ2hpbmEgRmluYW5j
-aWFsIENlcnRpZmljYXRpb24gQXV0aG9yaXR5MRUwEwYDVQQDDAxDRkNBIEVWIFJP
-T1QwggIiMA0GCSqGSIb3DQEBAQUAA4ICDwAwggIKAoICAQDXXWvNED8fBVnVBU03
-sQ7smCuOFR36k0sXgiFxEFLXUWRwFsJVaU2OFW2fvwwbwuCjZ9YMrM8irq93VCpL
-TIpTUnrD7i7es3ElweldPe6hL6P3KjzJIx1qqx2hp/Hz7KDVRM8Vz3IvHWOX6Jn5
-/ZOkVIBMUtRSqy5J35DNuF++P96hyk0g1CXohClTt7GIH//62pCfCqktQT+x8Rgp
-7hZZLDRJGqgG16iI0gNyejLi6mhNbiyWZXvKWfry4t3uMCz7zEasxGPrb382KzRz
-EpR/38wmnvFyXVBlWY9ps4deMm/DGIq1lY+wejfeWkU7xzbh72fROdOXW3NiGUgt
-hxwG+3SYIElz8AXSG7Ggo7cbcNOIabla1jj0Ytwli3i/+Oh+uFzJlU9fpy25IGvP
-a931DfSCt/SyZi4QKPaXWnuWFo8BGS1sbn85WAZkgwGDg8NNkt0yxoekN+kWzqot
-aK8KgWU6cMGbrU1tVMoqLUuFG7OA5nBFDWteNfB/O7ic5ARwiRIlk9oKmSJgamNg
-TnYGmE69g60dWIolhdLHZR4tjsbftsbhf4oEIRUpdPA+nJCdDC7xij5aqgwJHsfV
-PKPtl8MeNPo4+QgO48BdK4PRVmrJtqhUUy54Mmc9gn900PvhtgVguXDbjgv5E1hv
-cWAQUhC5wUEJ73IfZzF4/5YFjQIDAQABo2MwYTAfBgNVHSMEGDAWgBTj/i39KNAL
-tbq2osS/BqoFjJP7LzAPBgNVHRMBAf8EBTADAQH/MA4GA1UdDwEB/wQEAwIBBjAd
-BgNVHQ4EFgQU4/4t/SjQC7W6tqLEvwaqBYyT+y8wDQYJKoZIhvcNAQELBQADggIB
-ACXGumvrh8vegjmWPfBEp2uEcwPenStPuiB/vHiyz5ewG5zz13ku9Ui20vsXiObT
-ej/tUxPQ4i9qecsAIyjmHjdXNYmEwnZPNDatZ8POQQaIxffu2Bq41gt/UP+TqhdL
-jOztUmCypAbqTuv0axn96/Ua4CUqmtzHQTb3yHQFhDmVOdYLO6Qn+gjYXB74BGBS
-ESgoA//vU2YApUo0FmZ8/Qmkrp5nGm9BC2sGE5uPhnEFtC+NiWYzKXZUmhH4J/qy
-P5Hgzg0b8zAarb8iXRvTvyUFTeGSGn+ZnzxEk8rUQElsgIfXBDrDMlI1Dlb4pd19
-xIsNER9Tyx6yF7Zod1rg1MvIB671Oi6ON7fQAUtDKXeMOZePglr4UeWJoBjnaH9d
-Ci77o0cOPaYjesYBx4/IXr9tgFa+iiS6M+qf4TIRnvHST4D2G0CvOJ4RUHlzEhLN
-5mydLIhyPDCBBpEi6lmt2hkuIsKNuYyH4Ga8cyNfIWRjgEj1oDwYPZTISEEdQLpe
-/v5WOaHIz16eGWRGENoXkbcFgKyLmZJ956LYBws2J+dIeWCKw9cTXPhyQN9Ky8+Z
-AAoACxGV2lZFA4gKn2fQ1XmxqI1AbQ3CekD6819kR5LLU7m7Wc5P/dAVUwHY3+vZ
-5nbv0CO7O6l5s9UCKc2Jo5YPSjXnTkLAdc0Hz+Ys63su
------END CERTIFICATE-----
-)string_literal";
+#include "HTTPPool.h"
+#include "JPEG.h"
 
 String https_get_string(String uri) {
   Serial.printf("https_get_string(%s)\n", uri.c_str());
-
-  WiFiClientSecure *client = new WiFiClientSecure;
-  String payload;
-  if (client) {
-    client->setInsecure();
-    {
-      // Add a scoping block for HTTPClient https to make sure it is destroyed before WiFiClientSecure *client is
-      HTTPClient https;
-
-      Serial.print("[HTTPS] begin...\n");
-      if (https.begin(*client, uri)) {  // HTTPS
-        Serial.print("[HTTPS] GET...\n");
-        // start connection and send HTTP header
-        int httpCode = https.GET();
-
-        // httpCode will be negative on error
-        if (httpCode > 0) {
-          // HTTP header has been send and Server response header has been handled
-          Serial.printf("[HTTPS] GET... code: %d\n", httpCode);
-
-          // file found at server
-          if (httpCode == HTTP_CODE_OK || httpCode == HTTP_CODE_MOVED_PERMANENTLY) {
-            payload = https.getString();
-          }
-        } else {
-          Serial.printf("[HTTPS] GET... failed, error: %s\n", https.errorToString(httpCode).c_str());
-        }
-
-        https.end();
-      } else {
-        Serial.printf("[HTTPS] Unable to connect\n");
-      }
-      // End extra scoping block
-    }
-
-    delete client;
-  } else {
-    Serial.println("Unable to create client");
-  }
-  return payload;
+  return pool_get_string(uri, nullptr, "HTTPS");
 }
 
-uint8_t *https_response_buf = nullptr;
-int https_response_len = 0;
 int https_last_http_code = 0;
 
-void https_get_response_buf(String uri) {
-  // Reset state from any previous call
-  https_response_buf = nullptr;
-  https_response_len = 0;
+// Start a GOES download and hand the socket to JPEGDEC (see JPEG.h) so the
+// image is decoded as it arrives — no full-size buffer, no 100 KB size cap.
+// On success the caller runs jpeg.decode() and jpeg.close() ends the request.
+// With a validator the GET is conditional: an unchanged image returns false
+// with https_last_http_code == 304, having allocated and decoded nothing.
+bool https_open_jpeg_stream(String uri, JPEG_DRAW_CALLBACK *draw, PoolValidator *v = nullptr) {
   https_last_http_code = 0;
 
-  Serial.printf("https_request(%s)\n", uri.c_str());
+  Serial.printf("https_stream(%s)\n", uri.c_str());
   Serial.printf("Free heap: %d\n", ESP.getFreeHeap());
 
-  WiFiClientSecure *client = new WiFiClientSecure;
-  if (!client) {
-    Serial.println("[HTTPS] Failed to create client");
-    return;
-  }
-
-  client->setInsecure();
-
-  HTTPClient https;
-  https.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
-  https.addHeader("User-Agent", "ESP32/WeatherCore");
-  https.setTimeout(15000);
-
-  if (!https.begin(*client, uri)) {
-    Serial.println("[HTTPS] Unable to connect");
-    delete client;
-    return;
-  }
-
-  int httpCode = https.GET();
+  static const char *const hdrs[] = { "User-Agent", "ESP32/WeatherCore", nullptr };
+  PoolConn *conn;
+  int httpCode = pool_get(uri, hdrs, &conn, v);
   https_last_http_code = httpCode;
   Serial.printf("[HTTPS] code: %d\n", httpCode);
 
-  if (httpCode == HTTP_CODE_OK || httpCode == HTTP_CODE_MOVED_PERMANENTLY) {
-    int contentLen = https.getSize(); // -1 if chunked/unknown, 0 if not provided
-    Serial.printf("[HTTPS] content-length: %d, heap: %d\n", contentLen, ESP.getFreeHeap());
+  if (httpCode == HTTP_CODE_NOT_MODIFIED) {
+    pool_end(conn);  // 304 has no body, so the session stays warm
+    return false;
+  }
+  if (httpCode != HTTP_CODE_OK) {
+    if (httpCode < 0) Serial.printf("[HTTPS] error: %s\n", HTTPClient::errorToString(httpCode).c_str());
+    pool_end(conn, false);
+    return false;
+  }
 
-    const int MAX_SIZE = 100 * 1024; // 100KB cap - fits comfortably in ESP32 heap
+  Serial.printf("[HTTPS] content-length: %d\n", conn->http.getSize()); // -1 if chunked/unknown
+  return jpeg_open_stream(conn, draw);
+}
 
-    // Allocate MAX_SIZE regardless - handles chunked (==-1), unknown (==0), or known size
-    int allocSize = (contentLen > 0 && contentLen <= MAX_SIZE) ? contentLen : MAX_SIZE;
-    https_response_buf = (uint8_t *)malloc(allocSize);
+// A whole compressed GOES image held in RAM (see Prefetch.h)
+struct HttpsJpeg {
+  uint8_t      *buf;
+  int32_t       len;
+  unsigned long fetched_ms;
+  PoolValidator validator;   // of this copy, so a later refresh can 304 against it
+};
+
+static void https_jpeg_free(HttpsJpeg *j) {
+  if (!j) return;
+  free(j->buf);
+  delete j;
+}
 
-    if (!https_response_buf) {
-      Serial.printf("[HTTPS] malloc(%d) failed (heap=%d)\n", allocSize, ESP.getFreeHeap());
-    } else {
-      client->setTimeout(15); // 15s timeout
-      int total = client->readBytes(https_response_buf, allocSize);
-      Serial.printf("[HTTPS] Read %d bytes\n", total);
-      if (total > 0) {
-        https_response_len = total;
-        uint8_t *shrunk = (uint8_t *)realloc(https_response_buf, total);
-        if (shrunk) https_response_buf = shrunk;
-      } else {
-        free(https_response_buf);
-        https_response_buf = nullptr;
-      }
-    }
-  } else {
-    Serial.printf("[HTTPS] error: %s\n", https.errorToString(httpCode).c_str());
+// Download a GOES image into RAM, giving up if it is larger than max_len.
+// Returns nullptr on any failure (nothing is left allocated).
+HttpsJpeg *https_get_jpeg_buf(String uri, int32_t max_len) {
+  Serial.printf("https_get_jpeg_buf(%s, max %d)\n", uri.c_str(), (int)max_len);
+
+  HttpsJpeg *j = new HttpsJpeg;
+  pool_validator_clear(&j->validator);
+  static const char *const hdrs[] = { "User-Agent", "ESP32/WeatherCore", nullptr };
+  PoolConn *conn;
+  int httpCode = pool_get(uri, hdrs, &conn, &j->validator);
+  if (httpCode != HTTP_CODE_OK) {
+    Serial.printf("[HTTPS] code: %d\n", httpCode);
+    pool_end(conn, false);
+    delete j;
+    return nullptr;
   }
 
-  https.end();
-  delete client;
+  PoolBody body;
+  pool_body_begin(&body, conn);
+  int32_t allocSize = (body.framed && !body.chunked) ? body.left : max_len;
+  if (allocSize > max_len) {
+    Serial.printf("[HTTPS] %d B image exceeds %d B budget\n", (int)allocSize, (int)max_len);
+    pool_end(conn, false);
+    delete j;
+    return nullptr;
+  }
+  j->buf = (uint8_t *)malloc(allocSize);
+  j->len = j->buf ? pool_body_read(&body, j->buf, allocSize) : 0;
+  bool complete = body.done;
+  pool_end(conn, pool_body_reusable(&body));
+
+  if (!complete || j->len <= 0) {
+    // Malloc failure, cancellation, timeout, or larger than the budget
+    Serial.printf("[HTTPS] image buffer incomplete (%d B)\n", (int)j->len);
+    https_jpeg_free(j);
+    return nullptr;
+  }
+  if (j->len < allocSize) {
+    uint8_t *shrunk = (uint8_t *)realloc(j->buf, j->len);
+    if (shrunk) j->buf = shrunk;
+  }
+  j->fetched_ms = millis();
+  return j;
 }
 
 #define FILE_BUFFER_SIZE 4096
@@ -162,56 +113,28 @@ void https_fs_download(String uri, fs::FS &fs, String path) {
   if (!file) {
     Serial.printf("file open %s failed!\n", path.c_str());
   } else {
-    WiFiClientSecure *client = new WiFiClientSecure;
-    if (client) {
-      client->setInsecure();
-      {
-        // Add a scoping block for HTTPClient https to make sure it is destroyed before WiFiClientSecure *client is
-        HTTPClient https;
-
-        Serial.print("[HTTPS] begin...\n");
-        if (https.begin(*client, uri)) {  // HTTPS
-          Serial.print("[HTTPS] GET...\n");
-          // start connection and send HTTP header
-          int httpCode = https.GET();
-
-          // httpCode will be negative on error
-          if (httpCode > 0) {
-            // HTTP header has been send and Server response header has been handled
-            Serial.printf("[HTTPS] GET... code: %d\n", httpCode);
-
-            // file found at server
-            if (httpCode == HTTP_CODE_OK || httpCode == HTTP_CODE_MOVED_PERMANENTLY) {
-              int remain = https.getSize();
-              int read = 0;
-              int loop_count = 0;
-              while (remain && (loop_count < 1000)) {
-                if (client->available()) {
-                  read = client->readBytes(file_buf, (remain > FILE_BUFFER_SIZE) ? FILE_BUFFER_SIZE : remain);
-                  file.write(file_buf, read);
-                  remain -= read;
-                  // Serial.printf("read: %d, remain: %d\n", read, remain);
-                } else {
-                  delay(10);
-                }
-                ++loop_count;
-              }
-            }
-          } else {
-            Serial.printf("[HTTPS] GET... failed, error: %s\n", https.errorToString(httpCode).c_str());
-          }
-
-          https.end();
-        } else {
-          Serial.printf("[HTTPS] Unable to connect\n");
+    PoolConn *conn;
+    int httpCode = pool_get(uri, nullptr, &conn);
+    bool keep = false;
+
+    // httpCode will be negative on error
+    if (httpCode > 0) {
+      Serial.printf("[HTTPS] GET... code: %d\n", httpCode);
+
+      // file found at server
+      if (httpCode == HTTP_CODE_OK) {
+        PoolBody body;
+        pool_body_begin(&body, conn);
+        int32_t read;
+        while ((read = pool_body_read(&body, file_buf, FILE_BUFFER_SIZE)) > 0) {
+          file.write(file_buf, read);
         }
-        // End extra scoping block
+        keep = pool_body_reusable(&body);
       }
-
-      delete client;
     } else {
-      Serial.println("Unable to create client");
+      Serial.printf("[HTTPS] GET... failed, error: %s\n", HTTPClient::errorToString(httpCode).c_str());
     }
+    pool_end(conn, keep);
     file.flush();
     file.close();
   }
@@ -2,35 +2,84 @@
 
 #include <HTTPClient.h>
 #include <WiFiClientSecure.h>
-#include <ArduinoJson.h>
 #include <Arduino_GFX_Library.h>
+#include <Preferences.h>
 #include <math.h>
+#include <time.h>
 
-#define ISS_UPDATE_INTERVAL (30UL * 1000UL)  // 30 seconds
+#include "HTTPPool.h"
+#include "SGP4.h"
+#include "Screen.h"
+
+#define ISS_TLE_INTERVAL  (24UL * 60UL * 60UL * 1000UL)  // refresh the element set daily
+#define ISS_TLE_MAX_AGE   (14.0 * 86400.0)  // never propagate elements older than this (s)
+#define ISS_TICK_MS       1000               // on-screen position refresh
+#define ISS_MAX_PASSES    4                  // upcoming passes kept per element set
+#define ISS_PASS_WINDOW   (24.0 * 3600.0)    // how far ahead passes are searched (s)
+#define ISS_PASS_STEP     120.0              // coarse elevation scan step (s)
+#define ISS_PASS_TOL      1.0                // AOS / LOS / culmination resolution (s)
+#define ISS_TLE_URL       "https://celestrak.org/NORAD/elements/gp.php?CATNR=25544&FORMAT=TLE"
 
 extern Arduino_GFX *gfx;
 
+// One pass over the observer: acquisition, culmination and loss of signal
+struct IssPass {
+  double aos, tmax, los;   // unix times
+  float  max_el;           // degrees
+};
+
+
+// ---------------------------------------------------------------------------
+// Orbit source: a two-line element set from Celestrak, fetched once a day
+// and kept in NVS so a reboot needs no network at all. Position, altitude
+// and velocity come from the local SGP4 propagator, so the screen ticks
+// every second without a single request.
 // ---------------------------------------------------------------------------
-// HTTP helper
-// ---------------------------------------------------------------------------
-static String iss_https_get(const String &url) {
-  Serial.printf("[ISS] GET %s\n", url.c_str());
-  WiFiClientSecure *client = new WiFiClientSecure;
-  if (!client) return "";
-  client->setInsecure();
-  String body;
-  {
-    HTTPClient https;
-    https.begin(*client, url);
-    https.setTimeout(15000);
-    https.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
-    int code = https.GET();
-    if (code == HTTP_CODE_OK) body = https.getString();
-    else Serial.printf("[ISS] HTTP error: %d\n", code);
-    https.end();
+struct IssOrbit {
+  Sgp4     sat;
+  char     line1[72];
+  char     line2[72];
+  uint32_t fetched;        // unix time the TLE was downloaded
+  IssPass  pass[ISS_MAX_PASSES];
+  int      npass;
+  double   scanned_until;  // passes are known up to this unix time
+};
+
+static bool iss_tle_load(IssOrbit *o) {
+  Preferences p;
+  p.begin("isstle", true);
+  bool ok = p.getString("l1", o->line1, sizeof(o->line1)) > 0 &&
+            p.getString("l2", o->line2, sizeof(o->line2)) > 0;
+  o->fetched = p.getULong("fetched", 0);
+  p.end();
+  return ok && sgp4Parse(o->line1, o->line2, &o->sat);
+}
+
+static void iss_tle_store(const IssOrbit *o) {
+  Preferences p;
+  p.begin("isstle", false);
+  p.putString("l1", o->line1);
+  p.putString("l2", o->line2);
+  p.putULong("fetched", o->fetched);
+  p.end();
+}
+
+// Pull the "1 ..." and "2 ..." lines out of a Celestrak TLE response
+static bool iss_tle_parse(const String &body, IssOrbit *o) {
+  o->line1[0] = o->line2[0] = '\0';
+  int pos = 0;
+  while (pos < (int)body.length()) {
+    int eol = body.indexOf('\n', pos);
+    if (eol < 0) eol = body.length();
+    String line = body.substring(pos, eol);
+    line.trim();
+    if (line.length() >= 69 && line[1] == ' ') {
+      if (line[0] == '1') line.toCharArray(o->line1, sizeof(o->line1));
+      if (line[0] == '2') line.toCharArray(o->line2, sizeof(o->line2));
+    }
+    pos = eol + 1;
   }
-  delete client;
-  return body;
+  return o->line1[0] && o->line2[0] && sgp4Parse(o->line1, o->line2, &o->sat);
 }
 
 // ---------------------------------------------------------------------------
@@ -74,39 +123,263 @@ static float iss_elevation_deg(float surfDistKm, float altKm) {
   return atan2f(cosf(ca) - R / (R + altKm), sinf(ca)) * 180.0f / (float)M_PI;
 }
 
-// Track slant distance between updates to detect approaching vs receding
-static float iss_prev_slant = -1.0f;
+// ---------------------------------------------------------------------------
+// Low-precision solar direction (unit vector, equatorial frame), good to
+// ~0.01° — plenty for deciding whether the ISS is in Earth's shadow.
+// ---------------------------------------------------------------------------
+static void iss_sun_dir(double utc, double s[3]) {
+  double n   = utc / 86400.0 + 2440587.5 - 2451545.0;
+  double L   = (280.460 + 0.9856474 * n) * SGP4_DEG2RAD;
+  double g   = (357.528 + 0.9856003 * n) * SGP4_DEG2RAD;
+  double lam = L + (1.915 * sin(g) + 0.020 * sin(2.0 * g)) * SGP4_DEG2RAD;
+  double eps = (23.439 - 0.0000004 * n) * SGP4_DEG2RAD;
+  s[0] = cos(lam);
+  s[1] = cos(eps) * sin(lam);
+  s[2] = sin(eps) * sin(lam);
+}
+
+// Sub-satellite point, altitude and speed at a unix time. False if the
+// elements are unusable at that time (decayed, or far too old).
+static bool iss_state(const IssOrbit *o, double utc, double *lat, double *lon, double *alt,
+                      double r[3], double *speed) {
+  if (fabs(utc - o->sat.epoch_unix) > ISS_TLE_MAX_AGE) return false;
+  double v[3];
+  if (!sgp4Propagate(&o->sat, sgp4Minutes(&o->sat, utc), r, v)) return false;
+  sgp4Geodetic(r, sgp4Gmst(utc), lat, lon, alt);
+  *speed = sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+  return true;
+}
 
 // ---------------------------------------------------------------------------
-// Fetch live ISS position and draw on screen.
-// API: https://api.wheretheiss.at/v1/satellites/25544  (free, no key, HTTPS)
-// Returns true on success.
+// Pass prediction
+//
+// Elevation over time has one broad peak per orbit. A coarse scan at
+// ISS_PASS_STEP brackets each peak, golden-section search finds its time and
+// height, and every peak that clears the horizon has its AOS and LOS pinned
+// down by bisection. A 24 h window costs roughly 720 scan steps plus a dozen
+// evaluations per peak — each one an SGP4 step.
 // ---------------------------------------------------------------------------
-bool issFetchAndDisplay(const char *userLat, const char *userLon, bool useMetric) {
-  String body = iss_https_get("https://api.wheretheiss.at/v1/satellites/25544");
-  if (body.isEmpty()) return false;
+static uint32_t iss_evals = 0;   // propagations made by the last pass search
+
+static float iss_elev_at(const IssOrbit *o, float uLat, float uLon, double t) {
+  double lat, lon, alt, r[3], speed;
+  iss_evals++;
+  if (!iss_state(o, t, &lat, &lon, &alt, r, &speed)) return -90.0f;
+  return iss_elevation_deg(iss_haversine(uLat, uLon, (float)lat, (float)lon), (float)alt);
+}
+
+// Horizon crossing in [a, b]; rising = below at a and above at b
+static double iss_bisect(const IssOrbit *o, float uLat, float uLon, double a, double b, bool rising) {
+  while (b - a > ISS_PASS_TOL) {
+    double m = 0.5 * (a + b);
+    if ((iss_elev_at(o, uLat, uLon, m) >= 0.0f) == rising) b = m;
+    else                                                    a = m;
+  }
+  return 0.5 * (a + b);
+}
+
+// Time of the elevation maximum inside [a, b] (golden-section search)
+static double iss_golden(const IssOrbit *o, float uLat, float uLon, double a, double b, float *maxEl) {
+  const double g = 0.6180339887498949;
+  double c = b - g * (b - a), d = a + g * (b - a);
+  float fc = iss_elev_at(o, uLat, uLon, c), fd = iss_elev_at(o, uLat, uLon, d);
+  while (b - a > ISS_PASS_TOL) {
+    if (fc > fd) {
+      b = d; d = c; fd = fc;
+      c = b - g * (b - a);
+      fc = iss_elev_at(o, uLat, uLon, c);
+    } else {
+      a = c; c = d; fc = fd;
+      d = a + g * (b - a);
+      fd = iss_elev_at(o, uLat, uLon, d);
+    }
+  }
+  *maxEl = fc > fd ? fc : fd;
+  return 0.5 * (a + b);
+}
+
+// Record the pass culminating at tmax, pinning its AOS and LOS down
+static void iss_add_pass(IssOrbit *o, float uLat, float uLon, double tmax, float maxEl) {
+  const double step = ISS_PASS_STEP;
+  double a = tmax - step, b = tmax + step;
+  for (int i = 0; i < 10 && iss_elev_at(o, uLat, uLon, a) >= 0.0f; i++) a -= step;
+  for (int i = 0; i < 10 && iss_elev_at(o, uLat, uLon, b) >= 0.0f; i++) b += step;
+  IssPass &p = o->pass[o->npass++];
+  p.aos    = iss_bisect(o, uLat, uLon, a, tmax, true);
+  p.los    = iss_bisect(o, uLat, uLon, tmax, b, false);
+  p.tmax   = tmax;
+  p.max_el = maxEl;
+}
 
-  DynamicJsonDocument doc(1024);
-  if (deserializeJson(doc, body)) {
-    Serial.println("[ISS] JSON parse failed");
-    return false;
+// Fill o->pass with up to ISS_MAX_PASSES passes from `from` (a pass already
+// in progress is included) over the next ISS_PASS_WINDOW.
+static void iss_find_passes(IssOrbit *o, float uLat, float uLon, double from) {
+  unsigned long t0 = millis();
+  const double step = ISS_PASS_STEP, end = from + ISS_PASS_WINDOW;
+  iss_evals = 0;
+  o->npass  = 0;
+  double t  = from;
+  float  e0 = iss_elev_at(o, uLat, uLon, t - step);
+  float  e1 = iss_elev_at(o, uLat, uLon, t);
+  if (e1 >= 0.0f && e1 < e0) {
+    // Up and already sinking: the scan only sees peaks ahead of it, so walk
+    // back until elevation stops rising to bracket this pass's culmination
+    double a = t - step;
+    float  ea = e0, eb;
+    for (int i = 0; i < 10 && (eb = iss_elev_at(o, uLat, uLon, a - step)) > ea; i++) {
+      a -= step;
+      ea = eb;
+    }
+    float maxEl;
+    double tmax = iss_golden(o, uLat, uLon, a - step, a + step, &maxEl);
+    iss_add_pass(o, uLat, uLon, tmax, maxEl);
+  }
+  for (; t < end && o->npass < ISS_MAX_PASSES; t += step) {
+    float e2 = iss_elev_at(o, uLat, uLon, t + step);
+    if (e1 >= e0 && e1 > e2 && e1 > -30.0f) {   // a peak lies in [t - step, t + step]
+      float maxEl;
+      double tmax = iss_golden(o, uLat, uLon, t - step, t + step, &maxEl);
+      if (maxEl > 0.0f) iss_add_pass(o, uLat, uLon, tmax, maxEl);
+    }
+    e0 = e1;
+    e1 = e2;
   }
+  o->scanned_until = t;
+  Serial.printf("[ISS] %d passes in the next %.0f h, found in %lu ms (%u SGP4 steps)\n",
+                o->npass, (t - from) / 3600.0, millis() - t0, (unsigned)iss_evals);
+}
+
+// True once every predicted pass is over and a new search is due
+static bool issPassesStale(const IssOrbit *o, time_t utc) {
+  return (double)utc > (o->npass ? o->pass[o->npass - 1].los : o->scanned_until);
+}
+
+// ISS snapshot relative to the observer (metric; units are applied at draw time)
+struct IssData {
+  float       lat, lon;      // sub-satellite point
+  float       alt;           // km
+  float       vel;           // km/h
+  const char *vis;           // "visible" / "daylight" / "eclipsed"
+  float       slant;         // line-of-sight distance, km
+  float       bearing;       // degrees from N
+  float       elev;          // degrees above horizon
+  bool        approaching;
+  float       tle_age;       // days since the element set's epoch
+  IssPass     next[2];       // current / upcoming passes
+  int         nnext;
+};
 
-  float  issLat = doc["latitude"]  | 0.0f;
-  float  issLon = doc["longitude"] | 0.0f;
-  float  issAlt = doc["altitude"]  | 0.0f;   // km
-  float  issVel = doc["velocity"]  | 0.0f;   // km/h
-  String vis    = doc["visibility"] | "unknown";
+// ---------------------------------------------------------------------------
+// Propagate the orbit to utc and derive observer geometry (no drawing, no
+// network). Runs on loop()'s core once a second while the mode is visible.
+// ---------------------------------------------------------------------------
+static bool issCompute(const IssOrbit *o, float uLat, float uLon, time_t utc, IssData *d) {
+  double lat, lon, alt, r[3], speed;
+  if (!iss_state(o, (double)utc, &lat, &lon, &alt, r, &speed)) return false;
 
-  float uLat = atof(userLat);
-  float uLon = atof(userLon);
+  // Slant range ten seconds on tells approaching from receding
+  double lat2, lon2, alt2, r2[3], speed2;
+  if (!iss_state(o, (double)utc + 10.0, &lat2, &lon2, &alt2, r2, &speed2)) return false;
 
-  float surfDist   = iss_haversine(uLat, uLon, issLat, issLon);
-  float slantDist  = sqrtf(surfDist * surfDist + issAlt * issAlt);
-  float brng       = iss_bearing(uLat, uLon, issLat, issLon);
-  float elevDeg    = iss_elevation_deg(surfDist, issAlt);
-  bool  approaching = (iss_prev_slant > 0.0f && slantDist < iss_prev_slant);
-  iss_prev_slant   = slantDist;
+  float surfDist  = iss_haversine(uLat, uLon, (float)lat, (float)lon);
+  float slantDist = sqrtf(surfDist * surfDist + (float)(alt * alt));
+  float surf2     = iss_haversine(uLat, uLon, (float)lat2, (float)lon2);
+  float slant2    = sqrtf(surf2 * surf2 + (float)(alt2 * alt2));
+
+  // In Earth's (cylindrical) shadow when behind the planet and within one
+  // Earth radius of the Sun-Earth line
+  double s[3];
+  iss_sun_dir((double)utc, s);
+  double along = r[0] * s[0] + r[1] * s[1] + r[2] * s[2];
+  double px = r[0] - along * s[0], py = r[1] - along * s[1], pz = r[2] - along * s[2];
+  bool sunlit = along > 0.0 || sqrt(px * px + py * py + pz * pz) > SGP4_RE;
+
+  d->lat         = (float)lat;
+  d->lon         = (float)lon;
+  d->alt         = (float)alt;
+  d->vel         = (float)(speed * 3600.0);
+  d->slant       = slantDist;
+  d->bearing     = iss_bearing(uLat, uLon, (float)lat, (float)lon);
+  d->elev        = iss_elevation_deg(surfDist, (float)alt);
+  d->approaching = slant2 < slantDist;
+  d->tle_age     = (float)(((double)utc - o->sat.epoch_unix) / 86400.0);
+  d->nnext       = 0;
+  for (int i = 0; i < o->npass && d->nnext < 2; i++) {
+    if (o->pass[i].los > (double)utc) d->next[d->nnext++] = o->pass[i];
+  }
+  d->vis         = "eclipsed";
+  if (sunlit) {
+    // Naked-eye visible: sunlit ISS above the horizon in a dark sky
+    double g = sgp4Gmst((double)utc);
+    double ex = cos(g) * s[0] + sin(g) * s[1], ey = -sin(g) * s[0] + cos(g) * s[1];
+    double la = uLat * SGP4_DEG2RAD, lo = uLon * SGP4_DEG2RAD;
+    double sunUp = cos(la) * cos(lo) * ex + cos(la) * sin(lo) * ey + sin(la) * s[2];
+    d->vis = (d->elev > 0.0f && sunUp < -0.105) ? "visible" : "daylight";  // sun below -6°
+  }
+  return true;
+}
+
+// Element set + propagator for now (NVS first, CelesTrak once a day)
+static IssOrbit *iss_load_orbit() {
+  IssOrbit *o = new IssOrbit;
+  time_t now = time(nullptr);
+  bool cached = iss_tle_load(o);
+  if (cached && (uint32_t)now - o->fetched < ISS_TLE_INTERVAL / 1000UL) {
+    Serial.printf("[ISS] TLE from NVS, epoch %.1f d old\n", (now - o->sat.epoch_unix) / 86400.0);
+    return o;
+  }
+
+  Serial.printf("[ISS] GET %s\n", ISS_TLE_URL);
+  String body = pool_get_string(ISS_TLE_URL, nullptr, "ISS");
+  IssOrbit fresh;
+  if (!body.isEmpty() && iss_tle_parse(body, &fresh)) {
+    fresh.fetched = (uint32_t)now;
+    iss_tle_store(&fresh);
+    *o = fresh;
+    Serial.printf("[ISS] TLE updated, epoch %.1f d old\n", (now - o->sat.epoch_unix) / 86400.0);
+    return o;
+  }
+
+  if (cached && fabs(now - o->sat.epoch_unix) < ISS_TLE_MAX_AGE) {
+    Serial.println("[ISS] TLE fetch failed, propagating the cached set");
+    return o;
+  }
+  Serial.println("[ISS] no usable TLE");
+  delete o;
+  return nullptr;
+}
+
+// ---------------------------------------------------------------------------
+// Load the element set, initialise the propagator and predict the next
+// passes over the observer. Runs on the fetch worker; returns a new orbit
+// owned by the caller, or nullptr if no usable TLE could be had.
+// ---------------------------------------------------------------------------
+IssOrbit *issFetch(const char *userLat, const char *userLon) {
+  IssOrbit *o = iss_load_orbit();
+  if (o) iss_find_passes(o, atof(userLat), atof(userLon), (double)time(nullptr));
+  return o;
+}
+
+// ---------------------------------------------------------------------------
+// Draw an ISS snapshot in km or miles.
+//
+// Every label and readout is a screen-model widget, so the 1 Hz tick only
+// repaints the readouts whose text changed (see Screen.h).
+// ---------------------------------------------------------------------------
+
+// "HH:MM" (UTC) of a unix time
+static void iss_hhmm(double utc, char out[8]) {
+  time_t t = (time_t)utc;
+  struct tm tm;
+  gmtime_r(&t, &tm);
+  snprintf(out, 8, "%02d:%02d", tm.tm_hour, tm.tm_min);
+}
+
+void issDraw(const IssData *d, bool useMetric) {
+  const float  issLat = d->lat, issLon = d->lon;
+  const float  issAlt = d->alt, issVel = d->vel;
+  const float  slantDist = d->slant, brng = d->bearing, elevDeg = d->elev;
+  const bool   approaching = d->approaching;
 
   // Unit conversions
   const float KM_TO_MI = 0.621371f;
@@ -116,132 +389,93 @@ bool issFetchAndDisplay(const char *userLat, const char *userLon, bool useMetric
   const char *distUnit = useMetric ? "km"   : "mi";
   const char *velUnit  = useMetric ? "km/h" : "mph";
 
-  // ── Draw ──────────────────────────────────────────────────────────────────
-  gfx->fillRect(0, 20, gfx->width(), gfx->height() - 20, RGB565_BLACK);
-
-  // Sub-header bar
-  gfx->fillRect(0, 20, gfx->width(), 12, 0x0841);
-  gfx->setTextColor(0x07FF);
-  gfx->setTextSize(1);
-  gfx->setCursor(4, 22);
+  // ── Sub-header bar ───────────────────────────────────────────────────────
+  scrRect(0, 20, gfx->width(), 12, 0x0841);
   char titleBuf[24];
   snprintf(titleBuf, sizeof(titleBuf), "ISS Tracker [%s]", distUnit);
-  gfx->print(titleBuf);
+  scrText(4, 22, 1, 0x07FF, titleBuf, 0x0841);
 
   // Visibility badge in top-right: VISIBLE=green, DAYLIGHT=yellow, ECLIPSED=gray
-  String visUpper = vis;
-  visUpper.toUpperCase();
-  uint16_t visColor = (vis == "visible") ? 0x07E0 :
-                      (vis == "daylight") ? 0xFFE0 : 0x7BEF;
-  gfx->setTextColor(visColor);
-  gfx->setCursor(gfx->width() - (int)visUpper.length() * 6 - 4, 22);
-  gfx->print(visUpper);
-
-  int y = 36;
-
-  // ── ISS header ───────────────────────────────────────────────────────────
-  gfx->setTextColor(0x07FF);
-  gfx->setTextSize(2);
-  gfx->setCursor(4, y);
-  gfx->print("ISS Position");
-  y += 20;
-
-  // Lat / Lon
+  int vis = d->vis[0] == 'v' ? 0 : d->vis[0] == 'd' ? 1 : 2;
+  const char *visUpper[] = { "VISIBLE", "DAYLIGHT", "ECLIPSED" };
+  const uint16_t visColor[] = { 0x07E0, 0xFFE0, 0x7BEF };
+  char badge[12];
+  snprintf(badge, sizeof(badge), "%8s", visUpper[vis]);
+  scrText(gfx->width() - 8 * 6 - 4, 22, 1, visColor[vis], badge, 0x0841);
+
+  // ── Position ─────────────────────────────────────────────────────────────
+  scrText(4, 36, 2, 0x07FF, "ISS Position");
+
   char buf[56];
-  gfx->setTextColor(RGB565_WHITE);
-  gfx->setTextSize(1);
   snprintf(buf, sizeof(buf), "Lat: %+.2f    Lon: %+.2f", issLat, issLon);
-  gfx->setCursor(4, y); gfx->print(buf);
-  y += 12;
+  scrText(4, 56, 1, RGB565_WHITE, buf);
 
-  // Altitude + velocity
-  gfx->setTextColor(0xFD20);
   snprintf(buf, sizeof(buf), "Alt: %.0f %s    Vel: %.0f %s", dispAlt, distUnit, dispVel, velUnit);
-  gfx->setCursor(4, y); gfx->print(buf);
-  y += 14;
+  scrText(4, 68, 1, 0xFD20, buf);
 
-  // Divider
-  gfx->drawFastHLine(0, y, gfx->width(), 0x2104);
-  y += 6;
-
-  // ── Distance from user ────────────────────────────────────────────────────
-  gfx->setTextColor(0xFFE0);
-  gfx->setTextSize(2);
+  // ── Distance from user ───────────────────────────────────────────────────
+  scrRect(0, 82, gfx->width(), 1, 0x2104);
   snprintf(buf, sizeof(buf), "%.0f %s", dispDist, distUnit);
-  gfx->setCursor(4, y); gfx->print(buf);
-  y += 22;
-
-  gfx->setTextColor(0x7BEF);
-  gfx->setTextSize(1);
-  gfx->setCursor(4, y);
-  gfx->print("line-of-sight from your location");
-  y += 12;
+  scrText(4, 88, 2, 0xFFE0, buf);
+  scrText(4, 110, 1, 0x7BEF, "line-of-sight from your location");
 
-  // Bearing
-  gfx->setTextColor(0x07FF);
   snprintf(buf, sizeof(buf), "Bearing: %.0f%c (%s)", brng, 176, iss_compass(brng));
-  gfx->setCursor(4, y); gfx->print(buf);
-  y += 14;
+  scrText(4, 122, 1, 0x07FF, buf);
+  scrRect(0, 136, gfx->width(), 1, 0x2104);
 
-  // Divider
-  gfx->drawFastHLine(0, y, gfx->width(), 0x2104);
-  y += 5;
-
-  // ── Elevation + Radio window ──────────────────────────────────────────────
   // Elevation angle
-  uint16_t elevColor = (elevDeg >= 0.0f) ? 0x07E0 : 0x7BEF;
-  gfx->setTextColor(elevColor);
-  char elBuf[44];
   if (elevDeg >= 0.0f)
-    snprintf(elBuf, sizeof(elBuf), "Elev: +%.1f%c  above horizon", elevDeg, 176);
+    snprintf(buf, sizeof(buf), "Elev: +%.1f%c  above horizon", elevDeg, 176);
   else
-    snprintf(elBuf, sizeof(elBuf), "Elev: %.1f%c  below horizon",  elevDeg, 176);
-  gfx->setCursor(4, y); gfx->print(elBuf);
-  y += 12;
-
-  // Divider + Radio section header
-  gfx->drawFastHLine(0, y, gfx->width(), 0x2104);
-  y += 4;
-  gfx->setTextColor(0xFD20);
-  gfx->setTextSize(1);
-  gfx->setCursor(4, y);
-  gfx->print("[ 145.800 MHz FM  ISS Radio ]");
-  y += 12;
+    snprintf(buf, sizeof(buf), "Elev: %.1f%c  below horizon",  elevDeg, 176);
+  scrText(4, 141, 1, (elevDeg >= 0.0f) ? 0x07E0 : 0x7BEF, buf);
+
+  // ── Radio window ─────────────────────────────────────────────────────────
+  scrRect(0, 153, gfx->width(), 1, 0x2104);
+  scrText(4, 157, 1, 0xFD20, "[ 145.800 MHz FM  ISS Radio ]");
 
+  int y = 169;
   if (elevDeg >= 0.0f) {
     // Radio is receivable right now
     uint16_t rc = (elevDeg > 10.0f) ? 0x07E0 : 0xFFE0;  // green>10°, yellow 0-10°
-    gfx->setTextColor(rc);
-    gfx->setTextSize(2);
-    gfx->setCursor(4, y);
-    gfx->print(elevDeg > 10.0f ? "RADIO ACTIVE" : "WEAK SIGNAL");
+    scrText(4, y, 2, rc, elevDeg > 10.0f ? "RADIO ACTIVE" : "WEAK SIGNAL");
     y += 20;
-    gfx->setTextSize(1);
-    gfx->setTextColor(rc);
     char sb[48];
     snprintf(sb, sizeof(sb), "%s  |  %s",
              elevDeg > 10.0f ? "Strong signal" : "Marginal copy",
              approaching ? "approaching" : "receding");
-    gfx->setCursor(4, y); gfx->print(sb);
+    scrText(4, y, 1, rc, sb);
+    if (d->nnext) {
+      y += 12;
+      char aosT[8], losT[8];
+      iss_hhmm(d->next[0].aos, aosT);
+      iss_hhmm(d->next[0].los, losT);
+      snprintf(sb, sizeof(sb), "Pass %s-%s UTC, max %.0f%c", aosT, losT, d->next[0].max_el, 176);
+      scrText(4, y, 1, 0x7BEF, sb);
+    }
   } else {
     // Radio offline
-    gfx->setTextColor(0x7BEF);
-    gfx->setTextSize(1);
-    char ob[44];
+    char ob[48];
     snprintf(ob, sizeof(ob), "Offline  (%s)",
              approaching ? "approaching horizon" : "receding");
-    gfx->setCursor(4, y); gfx->print(ob);
+    scrText(4, y, 1, 0x7BEF, ob);
     y += 12;
-    gfx->setTextColor(0x4208);
-    gfx->setCursor(4, y);
-    gfx->print("Passes ~every 90 min. Tune 145.800");
-    y += 11;
-    gfx->setCursor(4, y);
-    gfx->print("Best window: 5-10 min above 10");
-    gfx->print((char)176);
+    if (!d->nnext) {
+      snprintf(ob, sizeof(ob), "No pass above 0%c in the next 24 h", 176);
+      scrText(4, y, 1, 0x4208, ob);
+    }
+    for (int i = 0; i < d->nnext; i++) {
+      const IssPass &p = d->next[i];
+      char aosT[8];
+      iss_hhmm(p.aos, aosT);
+      snprintf(ob, sizeof(ob), "%s %s UTC  max %.0f%c  %d min", i == 0 ? "Next" : "Then",
+               aosT, p.max_el, 176, (int)((p.los - p.aos + 30.0) / 60.0));
+      scrText(4, y, 1, i == 0 ? (p.max_el > 10.0f ? 0x07E0 : 0xFFE0) : 0x4208, ob);
+      y += 11;
+    }
   }
 
-  Serial.printf("[ISS] Lat=%.2f Lon=%.2f Alt=%.0fkm Dist=%.0fkm Bear=%.0f Elev=%.1f Vis=%s\n",
-                issLat, issLon, issAlt, slantDist, brng, elevDeg, vis.c_str());
-  return true;
+  // Element set age (SGP4 error grows ~1-3 km per day from epoch)
+  snprintf(buf, sizeof(buf), "TLE %.1f d old", d->tle_age);
+  scrText(4, gfx->height() - 10, 1, 0x4208, buf);
 }
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <Arduino.h>
+#include "HTTPPool.h"
+
+// ---------------------------------------------------------------------------
+// Streaming JSON tokenizer
+//
+// Parses a response body straight off the pooled socket (through PoolBody)
+// without ever holding it in a String or building a JsonDocument. The only
+// state is a 256-byte read window and the path stack, so peak heap is
+// whatever the sink chooses to keep.
+//
+// The sink sees every scalar together with the path that leads to it and
+// picks out what it needs with jsonPathIs(js, "properties.periods[0].name").
+// String values arrive unescaped in pieces of up to JSON_STREAM_PIECE bytes
+// (`done` marks the last one); numbers, true/false and null arrive whole as
+// their raw text. Setting js->stop ends the parse early — the rest of the
+// body is drained so the keep-alive session survives.
+// ---------------------------------------------------------------------------
+#define JSON_STREAM_DEPTH    16
+#define JSON_STREAM_KEY      24     // longer keys are cut short and never match
+#define JSON_STREAM_PIECE    64
+#define JSON_STREAM_WINDOW   256
+#define JSON_STREAM_DRAIN    (64 * 1024)  // past this, closing beats draining
+#define JSON_STREAM_BAD_BODY (-101)       // 200 whose body was not valid JSON
+
+struct JsonLevel {
+  bool array;
+  int  index;                    // arrays: position of the current element
+  char key[JSON_STREAM_KEY];     // objects: key of the current member
+};
+
+struct JsonStream;
+typedef void (*JsonSink)(void *ctx, JsonStream *js, const char *text, size_t len,
+                         bool isString, bool done);
+
+struct JsonStream {
+  PoolBody *body;
+  uint8_t   win[JSON_STREAM_WINDOW];
+  int       pos, len;
+  JsonLevel level[JSON_STREAM_DEPTH];
+  int       depth;
+  JsonSink  sink;
+  void     *ctx;
+  bool      stop;                // set by the sink once it has what it needs
+  uint32_t  heap_min;
+};
+
+static int json_peek(JsonStream *js) {
+  if (js->pos >= js->len) {
+    if (js->stop) return -1;
+    int32_t n = pool_body_read(js->body, js->win, sizeof(js->win));
+    if (n <= 0) return -1;
+    js->pos = 0;
+    js->len = n;
+    uint32_t heap = ESP.getFreeHeap();
+    if (heap < js->heap_min) js->heap_min = heap;
+  }
+  return js->win[js->pos];
+}
+
+static int json_next(JsonStream *js) {
+  int c = json_peek(js);
+  if (c >= 0) js->pos++;
+  return c;
+}
+
+static int json_skip_ws(JsonStream *js) {
+  int c;
+  while ((c = json_peek(js)) == ' ' || c == '\n' || c == '\r' || c == '\t') js->pos++;
+  return c;
+}
+
+static int json_hex(int c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+// Read a string whose opening quote was consumed. With key, store it there
+// (truncated); otherwise hand it to the sink piece by piece.
+static bool json_string(JsonStream *js, char *key, size_t keyCap) {
+  char   piece[JSON_STREAM_PIECE];
+  size_t n = 0;
+  for (;;) {
+    int c = json_next(js);
+    if (c < 0) return false;
+    if (c == '"') break;
+    if (c == '\\') {
+      c = json_next(js);
+      switch (c) {
+        case 'n': c = '\n'; break;
+        case 't': c = '\t'; break;
+        case 'r': c = '\r'; break;
+        case 'b': c = '\b'; break;
+        case 'f': c = '\f'; break;
+        case 'u': {
+          int cp = 0;
+          for (int i = 0; i < 4; i++) {
+            int h = json_hex(json_next(js));
+            if (h < 0) return false;
+            cp = (cp << 4) | h;
+          }
+          c = cp < 0x80 ? cp : '?';  // the display font is ASCII only
+          break;
+        }
+        case -1: return false;
+        default: break;              // \" \\ \/
+      }
+    }
+    if (key) {
+      if (n + 1 < keyCap) key[n++] = (char)c;
+      else                key[n - 1] = '\x01';  // cut: must not match its own prefix
+    } else {
+      piece[n++] = (char)c;
+      if (n == sizeof(piece)) {
+        js->sink(js->ctx, js, piece, n, true, false);
+        n = 0;
+      }
+    }
+  }
+  if (key) key[n] = '\0';
+  else     js->sink(js->ctx, js, piece, n, true, true);
+  return true;
+}
+
+// Number / true / false / null, delivered as raw text
+static bool json_scalar(JsonStream *js) {
+  char buf[32];
+  size_t n = 0;
+  int c;
+  while ((c = json_peek(js)) >= 0 && !strchr(",]} \t\r\n", c)) {
+    if (n + 1 < sizeof(buf)) buf[n++] = (char)c;
+    js->pos++;
+  }
+  if (n == 0) return false;
+  buf[n] = '\0';
+  js->sink(js->ctx, js, buf, n, false, true);
+  return true;
+}
+
+static bool json_value(JsonStream *js) {
+  int c = json_skip_ws(js);
+  if (c == '"') {
+    js->pos++;
+    return json_string(js, nullptr, 0);
+  }
+  if (c != '{' && c != '[') return c >= 0 && json_scalar(js);
+
+  if (js->depth >= JSON_STREAM_DEPTH) return false;
+  js->pos++;
+  JsonLevel &lv = js->level[js->depth++];
+  lv.array  = (c == '[');
+  lv.index  = 0;
+  lv.key[0] = '\0';
+  const int close = lv.array ? ']' : '}';
+
+  if (json_skip_ws(js) == close) {
+    js->pos++;
+    js->depth--;
+    return true;
+  }
+  for (;;) {
+    if (!lv.array) {
+      if (json_skip_ws(js) != '"') return false;
+      js->pos++;
+      if (!json_string(js, lv.key, sizeof(lv.key))) return false;
+      if (json_skip_ws(js) != ':') return false;
+      js->pos++;
+    }
+    if (!json_value(js)) return false;
+    if (js->stop) return true;
+    c = json_skip_ws(js);
+    if (c < 0) return false;
+    js->pos++;
+    if (c == close) break;
+    if (c != ',') return false;
+    if (lv.array) lv.index++;
+  }
+  js->depth--;
+  return true;
+}
+
+// True if the value being delivered sits at pattern, e.g.
+// "properties.periods[0].name" or "features[*].properties.event".
+static bool jsonPathIs(const JsonStream *js, const char *p) {
+  for (int i = 0; i < js->depth; i++) {
+    const JsonLevel &lv = js->level[i];
+    if (lv.array) {
+      if (*p++ != '[') return false;
+      if (*p == '*') {
+        p++;
+      } else {
+        if (!isdigit((unsigned char)*p)) return false;
+        int n = 0;
+        while (isdigit((unsigned char)*p)) n = n * 10 + (*p++ - '0');
+        if (n != lv.index) return false;
+      }
+      if (*p++ != ']') return false;
+    } else {
+      if (*p == '.') p++;
+      size_t n = strcspn(p, ".[");
+      if (strlen(lv.key) != n || strncmp(lv.key, p, n) != 0) return false;
+      p += n;
+    }
+  }
+  return *p == '\0';
+}
+
+// Index of the array at stack level `level` (0 = outermost container)
+static int jsonIndexAt(const JsonStream *js, int level) {
+  return level < js->depth ? js->level[level].index : -1;
+}
+
+// Append a string piece to a fixed buffer, truncating at cap-1
+static void jsonAppend(char *dst, size_t cap, const char *text, size_t len) {
+  size_t have = strlen(dst);
+  if (have + 1 >= cap) return;
+  if (len > cap - 1 - have) len = cap - 1 - have;
+  memcpy(dst + have, text, len);
+  dst[have + len] = '\0';
+}
+
+// GET url over the pool and stream its JSON body through sink.
+// Returns the HTTP code (304 only with a validator), or JSON_STREAM_BAD_BODY
+// when a 200 body did not parse.
+static int jsonStreamGet(const String &url, const char *const *hdrs, const char *tag,
+                         JsonSink sink, void *ctx, PoolValidator *v = nullptr) {
+  PoolConn *c;
+  int code = pool_get(url, hdrs, &c, v);
+  if (code == HTTP_CODE_NOT_MODIFIED && v) {
+    pool_end(c);  // no body, session stays warm
+    return code;
+  }
+  if (code != HTTP_CODE_OK) {
+    if (code == POOL_ERROR_CANCELLED) Serial.printf("[%s] cancelled\n", tag);
+    else                              Serial.printf("[%s] HTTP error: %d\n", tag, code);
+    pool_end(c, false);  // error bodies are left unread
+    return code;
+  }
+
+  unsigned long t0 = millis();
+  uint32_t heap0 = ESP.getFreeHeap();
+  PoolBody body;
+  pool_body_begin(&body, c);
+  JsonStream js;
+  js.body     = &body;
+  js.pos      = js.len = 0;
+  js.depth    = 0;
+  js.sink     = sink;
+  js.ctx      = ctx;
+  js.stop     = false;
+  js.heap_min = heap0;
+
+  bool ok = json_value(&js);
+  unsigned long parse_ms = millis() - t0;
+
+  // Drain whatever the sink did not need so the session stays reusable
+  int32_t drained = 0, n;
+  while (!body.done && !body.error && drained < JSON_STREAM_DRAIN &&
+         (n = pool_body_read(&body, js.win, sizeof(js.win))) > 0) drained += n;
+  pool_end(c, pool_body_reusable(&body));
+
+  Serial.printf("[%s] streamed %d B (parsed in %lu ms), heap low-water %u (peak use %u B)\n",
+                tag, (int)body.total, parse_ms, (unsigned)js.heap_min,
+                (unsigned)(heap0 - js.heap_min));
+  if (!ok) {
+    Serial.printf("[%s] JSON stream parse failed at depth %d\n", tag, js.depth);
+    if (v) pool_validator_clear(v);
+    return JSON_STREAM_BAD_BODY;
+  }
+  return code;
+}
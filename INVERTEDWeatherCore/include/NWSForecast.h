@@ -2,8 +2,12 @@
 
 #include <HTTPClient.h>
 #include <WiFiClientSecure.h>
-#include <ArduinoJson.h>
 #include <Arduino_GFX_Library.h>
+#include <Preferences.h>
+
+#include "HTTPPool.h"
+#include "JsonStream.h"
+#include "Screen.h"
 
 #define NWS_USER_AGENT      "esp32-cyd-weather (github.com/Coreymillia)"
 #define NWS_UPDATE_INTERVAL (30UL * 60UL * 1000UL)  // 30 minutes (forecast + hourly)
@@ -12,36 +16,21 @@
 // gfx is defined in main.cpp
 extern Arduino_GFX *gfx;
 
-// Fetch a URL with the NWS-required User-Agent and return the body as a String.
-static String nws_https_get(const String &url) {
+// GET a URL with the NWS-required User-Agent and stream the JSON body
+// through sink (see JsonStream.h). Returns the HTTP code.
+static int nws_stream_get(const String &url, JsonSink sink, void *ctx, PoolValidator *v = nullptr) {
   Serial.printf("[NWS] GET %s\n", url.c_str());
-  WiFiClientSecure *client = new WiFiClientSecure;
-  if (!client) return "";
-  client->setInsecure();
-  String body;
-  {
-    HTTPClient https;
-    https.begin(*client, url);
-    https.addHeader("User-Agent", NWS_USER_AGENT);
-    https.addHeader("Accept", "application/geo+json");
-    https.setTimeout(15000);
-    https.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
-    int code = https.GET();
-    if (code == HTTP_CODE_OK) {
-      body = https.getString();
-    } else {
-      Serial.printf("[NWS] HTTP error: %d\n", code);
-    }
-    https.end();
-  }
-  delete client;
-  return body;
+  static const char *const hdrs[] = {
+    "User-Agent", NWS_USER_AGENT,
+    "Accept",     "application/geo+json",
+    nullptr
+  };
+  return jsonStreamGet(url, hdrs, "NWS", sink, ctx, v);
 }
 
 // Word-wrap and draw text on the display. Returns the y position after the last line.
+// Each line is one screen-model widget.
 static int nws_draw_wrapped(const String &text, int x, int y, int maxW, uint16_t color, int maxY = 228) {
-  gfx->setTextColor(color);
-  gfx->setTextSize(1);
   const int charW = 6, lineH = 10;
   int charsPerLine = maxW / charW;
   int pos = 0, len = text.length();
@@ -57,8 +46,7 @@ static int nws_draw_wrapped(const String &text, int x, int y, int maxW, uint16_t
     }
     String line = text.substring(pos, end);
     line.trim();
-    gfx->setCursor(x, y);
-    gfx->print(line);
+    scrText(x, y, 1, color, line.c_str());
     y += lineH;
     pos = end;
     while (pos < len && text[pos] == ' ') pos++;
@@ -66,147 +54,353 @@ static int nws_draw_wrapped(const String &text, int x, int y, int maxW, uint16_t
   return y;
 }
 
-// Fetch the NWS forecast for the given lat/lon and draw it on screen.
-// Returns true on success, false on any failure.
-bool nwsFetchAndDisplay(const char *lat, const char *lon) {
-  // ── Step 1: /points → resolve the forecast URL for this location ──────────
-  String pointsUrl = String("https://api.weather.gov/points/") + lat + "," + lon;
-  String pointsBody = nws_https_get(pointsUrl);
-  if (pointsBody.isEmpty()) return false;
+// ── /points resolution cache ─────────────────────────────────────────────────
+// api.weather.gov/points/{lat},{lon} only maps a location to its forecast
+// office grid and never changes for a fixed location, so the answer is kept
+// in NVS and the forecast refresh goes straight to the gridpoint URL. The
+// cache is dropped when the location changes or the cached URL returns 404
+// (NWS occasionally re-grids an office).
+struct NwsPoint {
+  char key[34];          // "lat,lon" this entry resolves
+  char office[8];        // gridId, e.g. "BOU"
+  int  gridX, gridY;
+  char forecast[96];
+  char hourly[104];
+  char stations[96];
+};
 
-  DynamicJsonDocument pointsDoc(4096);
-  if (deserializeJson(pointsDoc, pointsBody)) {
-    Serial.println("[NWS] Points JSON parse failed");
-    return false;
+static NwsPoint nws_point;
+static bool     nws_point_valid = false;
+
+// Point nws_point at lat,lon from RAM or NVS. False if not cached.
+static bool nws_point_load(const char *key) {
+  if (nws_point_valid && strcmp(nws_point.key, key) == 0) return true;
+  Preferences prefs;
+  prefs.begin("nwspoint", true);
+  size_t n = prefs.getBytes("point", &nws_point, sizeof(nws_point));
+  prefs.end();
+  nws_point_valid = (n == sizeof(nws_point) && strcmp(nws_point.key, key) == 0);
+  return nws_point_valid;
+}
+
+static void nws_point_forget() {
+  nws_point_valid = false;
+  Preferences prefs;
+  prefs.begin("nwspoint", false);
+  prefs.remove("point");
+  prefs.end();
+}
+
+static void nws_points_sink(void *ctx, JsonStream *js, const char *text, size_t len,
+                            bool isString, bool done) {
+  NwsPoint *pt = (NwsPoint *)ctx;
+  if (js->depth != 2) return;  // everything wanted is directly under properties
+  if (isString) {
+    if      (jsonPathIs(js, "properties.gridId"))              jsonAppend(pt->office,   sizeof(pt->office),   text, len);
+    else if (jsonPathIs(js, "properties.forecast"))            jsonAppend(pt->forecast, sizeof(pt->forecast), text, len);
+    else if (jsonPathIs(js, "properties.forecastHourly"))      jsonAppend(pt->hourly,   sizeof(pt->hourly),   text, len);
+    else if (jsonPathIs(js, "properties.observationStations")) jsonAppend(pt->stations, sizeof(pt->stations), text, len);
+  } else {
+    if      (jsonPathIs(js, "properties.gridX")) pt->gridX = atoi(text);
+    else if (jsonPathIs(js, "properties.gridY")) pt->gridY = atoi(text);
   }
-  String forecastUrl = pointsDoc["properties"]["forecast"] | "";
-  pointsDoc.clear();
+}
 
-  if (forecastUrl.isEmpty()) {
-    Serial.println("[NWS] No forecast URL in points response");
+// Resolve lat,lon via /points and persist the result
+static bool nws_point_resolve(const char *key) {
+  memset(&nws_point, 0, sizeof(nws_point));
+  nws_point_valid = false;
+  int code = nws_stream_get(String("https://api.weather.gov/points/") + key,
+                            nws_points_sink, &nws_point);
+  if (code != HTTP_CODE_OK) return false;
+  if (!nws_point.forecast[0] || strlen(nws_point.forecast) + 1 >= sizeof(nws_point.forecast)) {
+    Serial.println("[NWS] No usable forecast URL in points response");
     return false;
   }
-  Serial.printf("[NWS] Forecast URL: %s\n", forecastUrl.c_str());
+  strncpy(nws_point.key, key, sizeof(nws_point.key) - 1);
+  nws_point_valid = true;
 
-  // ── Step 2: forecast → extract first period ───────────────────────────────
-  String forecastBody = nws_https_get(forecastUrl);
-  if (forecastBody.isEmpty()) return false;
+  Preferences prefs;
+  prefs.begin("nwspoint", false);
+  prefs.putBytes("point", &nws_point, sizeof(nws_point));
+  prefs.end();
+  Serial.printf("[NWS] Resolved %s -> %s %d,%d (cached)\n", key,
+                nws_point.office, nws_point.gridX, nws_point.gridY);
+  return true;
+}
 
-  // Filter to only parse the fields we need (reduces JsonDocument size)
-  StaticJsonDocument<256> filter;
-  filter["properties"]["periods"][0]["name"] = true;
-  filter["properties"]["periods"][0]["detailedForecast"] = true;
-  filter["properties"]["periods"][1]["name"] = true;
-  filter["properties"]["periods"][1]["detailedForecast"] = true;
+// Parsed forecast snapshot: built by the fetch worker, drawn by loop()
+#define NWS_DETAIL_MAX 600   // longest detailedForecast kept (the screen shows far less)
 
-  DynamicJsonDocument forecastDoc(8192);
-  if (deserializeJson(forecastDoc, forecastBody, DeserializationOption::Filter(filter))) {
-    Serial.println("[NWS] Forecast JSON parse failed");
-    return false;
-  }
+struct NwsForecastData {
+  String p0Name, p0Detail;
+  String p1Name, p1Detail;
+};
+
+static void nws_append(String &dst, const char *text, size_t len, size_t cap) {
+  if (dst.length() >= cap) return;
+  if (len > cap - dst.length()) len = cap - dst.length();
+  dst.concat(text, len);
+}
+
+// Keeps periods[0..1].name/detailedForecast, stops once periods[1] is read
+static void nws_forecast_sink(void *ctx, JsonStream *js, const char *text, size_t len,
+                              bool isString, bool done) {
+  NwsForecastData *d = (NwsForecastData *)ctx;
+  if (!isString || js->depth != 4) return;
+  if      (jsonPathIs(js, "properties.periods[0].name"))             nws_append(d->p0Name,   text, len, 64);
+  else if (jsonPathIs(js, "properties.periods[0].detailedForecast")) nws_append(d->p0Detail, text, len, NWS_DETAIL_MAX);
+  else if (jsonPathIs(js, "properties.periods[1].name"))             nws_append(d->p1Name,   text, len, 64);
+  else if (jsonPathIs(js, "properties.periods[1].detailedForecast")) nws_append(d->p1Detail, text, len, NWS_DETAIL_MAX);
+  else if (jsonIndexAt(js, 2) > 1 && jsonPathIs(js, "properties.periods[*].name")) js->stop = true;
+}
+
+// Fetch and parse the NWS forecast for the given lat/lon (no drawing).
+// Returns a new snapshot owned by the caller, or nullptr on any failure.
+NwsForecastData *nwsFetchForecast(const char *lat, const char *lon) {
+  char key[sizeof(nws_point.key)];
+  snprintf(key, sizeof(key), "%s,%s", lat, lon);
 
-  String p0Name   = forecastDoc["properties"]["periods"][0]["name"]            | "Unknown";
-  String p0Detail = forecastDoc["properties"]["periods"][0]["detailedForecast"] | "No forecast available.";
-  String p1Name   = forecastDoc["properties"]["periods"][1]["name"]            | "";
-  String p1Detail = forecastDoc["properties"]["periods"][1]["detailedForecast"] | "";
-  forecastDoc.clear();
+  // ── Step 1: grid forecast URL, from the cache or a /points lookup ─────────
+  bool cached = nws_point_load(key);
+  if (!cached && !nws_point_resolve(key)) return nullptr;
+  Serial.printf("[NWS] Forecast URL: %s%s\n", nws_point.forecast, cached ? " (cached)" : "");
 
-  Serial.printf("[NWS] %s: %s\n", p0Name.c_str(), p0Detail.c_str());
+  // ── Step 2: forecast → stream out the first two periods ───────────────────
+  NwsForecastData *d = new NwsForecastData;
+  int code = nws_stream_get(nws_point.forecast, nws_forecast_sink, d);
+  if (code == HTTP_CODE_NOT_FOUND && cached) {
+    // Office re-gridded: resolve again and retry once
+    Serial.println("[NWS] Cached forecast URL is gone, re-resolving");
+    nws_point_forget();
+    if (nws_point_resolve(key)) {
+      *d   = NwsForecastData();
+      code = nws_stream_get(nws_point.forecast, nws_forecast_sink, d);
+    }
+  }
+  if (code != HTTP_CODE_OK) {
+    delete d;
+    return nullptr;
+  }
+  if (d->p0Name.isEmpty())   d->p0Name   = "Unknown";
+  if (d->p0Detail.isEmpty()) d->p0Detail = "No forecast available.";
 
-  // ── Draw on screen ────────────────────────────────────────────────────────
-  gfx->fillRect(0, 20, gfx->width(), gfx->height() - 20, RGB565_BLACK);
+  Serial.printf("[NWS] %s: %s\n", d->p0Name.c_str(), d->p0Detail.c_str());
+  return d;
+}
 
+// Draw a forecast snapshot on screen.
+void nwsDrawForecast(const NwsForecastData *d) {
   // Period 0 name in cyan at text size 2
-  gfx->setTextColor(0x07FF);
-  gfx->setTextSize(2);
-  gfx->setCursor(4, 25);
-  gfx->print(p0Name);
+  scrText(4, 25, 2, 0x07FF, d->p0Name.c_str());
 
   // Period 0 detailed forecast word-wrapped, capped at y=113
-  nws_draw_wrapped(p0Detail, 4, 44, gfx->width() - 8, RGB565_WHITE, 113);
+  nws_draw_wrapped(d->p0Detail, 4, 44, gfx->width() - 8, RGB565_WHITE, 113);
 
   // Period 1 (if available)
-  if (p1Name.length() > 0) {
-    gfx->drawFastHLine(0, 115, gfx->width(), 0x2104);
-    gfx->setTextColor(0xFFE0);  // yellow
-    gfx->setTextSize(1);
-    gfx->setCursor(4, 119);
-    gfx->print(p1Name);
-    nws_draw_wrapped(p1Detail, 4, 130, gfx->width() - 8, 0xC618, 228);  // light gray
+  if (d->p1Name.length() > 0) {
+    scrRect(0, 115, gfx->width(), 1, 0x2104);
+    scrText(4, 119, 1, 0xFFE0, d->p1Name.c_str());  // yellow
+    nws_draw_wrapped(d->p1Detail, 4, 130, gfx->width() - 8, 0xC618, 228);  // light gray
   }
-
-  return true;
 }
 
 // ── NWS Active Alerts ─────────────────────────────────────────────────────────
-// Fetches active NWS alerts for the given location and displays them.
-// Shows "No active alerts" when the area is clear.
-bool nwsFetchAndDisplayAlerts(const char *lat, const char *lon) {
-  String url = String("https://api.weather.gov/alerts/active?point=") + lat + "," + lon;
-  String body = nws_https_get(url);
-  if (body.isEmpty()) return false;
-
-  StaticJsonDocument<128> filter;
-  filter["features"][0]["properties"]["event"]    = true;
-  filter["features"][0]["properties"]["headline"] = true;
-
-  DynamicJsonDocument doc(3072);
-  if (deserializeJson(doc, body, DeserializationOption::Filter(filter))) {
-    Serial.println("[NWS] Alerts JSON parse failed");
-    return false;
+// Polled in the background whatever the mode. A poll where nothing changed
+// costs one conditional GET (usually 304) or, failing that, one streamed pass
+// over the body with no String or JsonDocument — the snapshot is only kept
+// (and the screen only touched) when the set of alert IDs moved.
+#define NWS_MAX_SHOWN_ALERTS 2
+#define NWS_MAX_TRACKED      8
+
+struct NwsAlertsData {
+  int    count;                           // total active alerts
+  String event[NWS_MAX_SHOWN_ALERTS];     // first alerts, already truncated for display
+  String headline[NWS_MAX_SHOWN_ALERTS];
+  char   banner[40];                      // new or upgraded alert to announce, "" = none
+};
+
+// What the last parsed poll saw (worker-only state)
+struct NwsAlertSeen {
+  uint32_t id;        // FNV-1a of the alert id
+  uint32_t event;     // FNV-1a of the event name ("Tornado Warning")
+  uint8_t  severity;  // nws_severity_rank()
+};
+
+static char          nws_alerts_where[34] = "";   // "lat,lon" the state below belongs to
+static PoolValidator nws_alerts_validator;
+static bool          nws_alerts_parsed = false;   // nws_alerts_sig/seen are valid
+static uint32_t      nws_alerts_sig = 0;          // signature of the last ID set
+static NwsAlertSeen  nws_alerts_seen[NWS_MAX_TRACKED];
+static int           nws_alerts_seen_n = 0;
+
+static uint32_t nws_fnv1a(const char *p, size_t n, uint32_t h = 2166136261u) {
+  while (n--) { h ^= (uint8_t)*p++; h *= 16777619u; }
+  return h;
+}
+
+static uint8_t nws_severity_rank(const char *sev) {
+  if (!strcmp(sev, "Extreme"))  return 4;
+  if (!strcmp(sev, "Severe"))   return 3;
+  if (!strcmp(sev, "Moderate")) return 2;
+  if (!strcmp(sev, "Minor"))    return 1;
+  return 0;
+}
+
+// One streamed pass over alerts/active: fields of the feature being read,
+// plus everything needed to build the snapshot if the ID set turns out new
+struct NwsAlertScan {
+  NwsAlertsData *d;
+  int           cur;                     // features[] index being read, -1 = none yet
+  uint32_t      id;                      // FNV-1a of its properties.id so far
+  char          event[36];
+  char          severity[12];
+  char          headline[121];
+  uint32_t      sig;                     // order-independent sum of id hashes
+  NwsAlertSeen  seen[NWS_MAX_TRACKED];
+  int           seenN;
+  uint8_t       bannerSev;
+};
+
+// The feature at scan->cur is complete: fold it into the scan
+static void nws_alert_finish(NwsAlertScan *sc) {
+  if (sc->cur < 0) return;
+  NwsAlertsData *d = sc->d;
+  const char *ev = sc->event[0] ? sc->event : "Unknown Event";
+  NwsAlertSeen a = { sc->id, nws_fnv1a(ev, strlen(ev)), nws_severity_rank(sc->severity) };
+  sc->sig += a.id;
+
+  // New = an id we have not seen whose event was not already active at
+  // this severity or higher. Routine re-issues of the same alert stay quiet.
+  bool known = false, upgraded = true;
+  for (int i = 0; i < nws_alerts_seen_n; i++) {
+    if (nws_alerts_seen[i].id == a.id) known = true;
+    if (nws_alerts_seen[i].event == a.event && nws_alerts_seen[i].severity >= a.severity) upgraded = false;
+  }
+  if (!known && upgraded && (!d->banner[0] || a.severity > sc->bannerSev)) {
+    strncpy(d->banner, ev, sizeof(d->banner) - 1);
+    d->banner[sizeof(d->banner) - 1] = '\0';
+    sc->bannerSev = a.severity;
+  }
+  if (sc->seenN < NWS_MAX_TRACKED) sc->seen[sc->seenN++] = a;
+
+  if (d->count < NWS_MAX_SHOWN_ALERTS) {
+    d->event[d->count]    = ev;      // already capped at 35 chars
+    d->headline[d->count] = sc->headline;
+  }
+  d->count++;
+}
+
+static void nws_alerts_sink(void *ctx, JsonStream *js, const char *text, size_t len,
+                            bool isString, bool done) {
+  NwsAlertScan *sc = (NwsAlertScan *)ctx;
+  // Only features[*].properties.<field> matters; compare the levels directly
+  if (!isString || js->depth != 4) return;
+  if (strcmp(js->level[0].key, "features") || strcmp(js->level[2].key, "properties")) return;
+  int idx = jsonIndexAt(js, 1);
+  const char *field = js->level[3].key;
+
+  if (idx != sc->cur) {
+    nws_alert_finish(sc);
+    sc->cur = idx;
+    sc->id  = 2166136261u;
+    sc->event[0] = sc->severity[0] = sc->headline[0] = '\0';
+  }
+  if      (!strcmp(field, "id"))       sc->id = nws_fnv1a(text, len, sc->id);
+  else if (!strcmp(field, "event"))    jsonAppend(sc->event,    sizeof(sc->event),    text, len);
+  else if (!strcmp(field, "severity")) jsonAppend(sc->severity, sizeof(sc->severity), text, len);
+  else if (!strcmp(field, "headline")) jsonAppend(sc->headline, sizeof(sc->headline), text, len);
+}
+
+// Fetch active NWS alerts for the given location (no drawing).
+// Returns a new snapshot owned by the caller, or nullptr on failure or when
+// nothing changed since the last poll (*unchanged is then set).
+NwsAlertsData *nwsFetchAlerts(const char *lat, const char *lon, bool *unchanged) {
+  *unchanged = false;
+  char where[sizeof(nws_alerts_where)];
+  snprintf(where, sizeof(where), "%s,%s", lat, lon);
+  if (strcmp(where, nws_alerts_where) != 0) {
+    // New location: forget what the old one had active
+    strcpy(nws_alerts_where, where);
+    pool_validator_clear(&nws_alerts_validator);
+    nws_alerts_parsed = false;
+    nws_alerts_seen_n = 0;
+  }
+
+  NwsAlertScan sc;
+  NwsAlertsData *d = new NwsAlertsData;
+  d->count     = 0;
+  d->banner[0] = '\0';
+  sc.d         = d;
+  sc.cur       = -1;
+  sc.sig       = 0;
+  sc.seenN     = 0;
+  sc.bannerSev = 0;
+
+  String url = String("https://api.weather.gov/alerts/active?point=") + where;
+  int code = nws_stream_get(url, nws_alerts_sink, &sc, &nws_alerts_validator);
+  if (code == HTTP_CODE_NOT_MODIFIED) {
+    delete d;
+    *unchanged = true;
+    return nullptr;
   }
+  if (code != HTTP_CODE_OK) {
+    delete d;
+    return nullptr;
+  }
+  nws_alert_finish(&sc);
+
+  uint32_t sig = sc.sig ^ ((uint32_t)d->count * 0x9E3779B9u);
+  if (nws_alerts_parsed && sig == nws_alerts_sig) {
+    Serial.println("[NWS] Alerts unchanged");
+    delete d;
+    *unchanged = true;
+    return nullptr;
+  }
+  memcpy(nws_alerts_seen, sc.seen, sizeof(sc.seen[0]) * sc.seenN);
+  nws_alerts_seen_n = sc.seenN;
+  nws_alerts_sig    = sig;
+  nws_alerts_parsed = true;
 
-  JsonArray features = doc["features"];
-  int alertCount = features.size();
+  Serial.printf("[NWS] Alerts: %d active%s%s\n", d->count,
+                d->banner[0] ? ", new: " : "", d->banner);
+  return d;
+}
 
-  // ── Draw on screen ────────────────────────────────────────────────────────
-  gfx->fillRect(0, 20, gfx->width(), gfx->height() - 20, RGB565_BLACK);
+// Red banner across the top of the content area, drawn over any mode
+void nwsDrawAlertBanner(const char *event) {
+  gfx->fillRect(0, 20, gfx->width(), 14, 0xF800);  // red
+  gfx->setTextColor(RGB565_WHITE);
+  gfx->setTextSize(1);
+  gfx->setCursor(4, 23);
+  gfx->print("NWS ALERT: ");
+  gfx->print(event);
+}
 
-  if (alertCount == 0) {
+// Draw an alerts snapshot. Shows "No active alerts" when the area is clear.
+void nwsDrawAlerts(const NwsAlertsData *d) {
+  if (d->count == 0) {
     // All clear
-    gfx->setTextColor(0x07E0);  // green
-    gfx->setTextSize(2);
-    gfx->setCursor(4, 30);
-    gfx->print("NWS Alerts");
-    gfx->setTextColor(RGB565_WHITE);
-    gfx->setTextSize(1);
-    gfx->setCursor(4, 58);
-    gfx->print("No active alerts");
-    gfx->setCursor(4, 70);
-    gfx->print("for your area.");
-  } else {
-    // Show alert count header in red
-    gfx->setTextColor(0xF800);  // red
-    gfx->setTextSize(2);
-    gfx->setCursor(4, 25);
-    char title[24];
-    snprintf(title, sizeof(title), "%d Alert%s!", alertCount, alertCount > 1 ? "s" : "");
-    gfx->print(title);
-
-    // Show up to 2 alerts
-    int y = 46;
-    int shown = 0;
-    for (JsonObject feature : features) {
-      if (shown >= 2) break;
-      String event    = feature["properties"]["event"]    | "Unknown Event";
-      String headline = feature["properties"]["headline"] | "";
-
-      // Event name in yellow
-      gfx->setTextColor(0xFFE0);
-      gfx->setTextSize(1);
-      gfx->setCursor(4, y);
-      if (event.length() > 35) event = event.substring(0, 34);
-      gfx->print(event);
-      y += 12;
-
-      // Headline word-wrapped in white
-      if (headline.length() > 120) headline = headline.substring(0, 119);
-      y = nws_draw_wrapped(headline, 4, y, gfx->width() - 8, RGB565_WHITE);
-      y += 4;  // small gap between alerts
-      shown++;
-    }
+    scrText(4, 30, 2, 0x07E0, "NWS Alerts");  // green
+    scrText(4, 58, 1, RGB565_WHITE, "No active alerts");
+    scrText(4, 70, 1, RGB565_WHITE, "for your area.");
+    return;
   }
 
-  Serial.printf("[NWS] Alerts: %d active\n", alertCount);
-  return true;
+  // Show alert count header in red
+  char title[24];
+  snprintf(title, sizeof(title), "%d Alert%s!", d->count, d->count > 1 ? "s" : "");
+  scrText(4, 25, 2, 0xF800, title);
+
+  // Show up to 2 alerts
+  int y = 46;
+  for (int i = 0; i < d->count && i < NWS_MAX_SHOWN_ALERTS; i++) {
+    // Event name in yellow
+    scrText(4, y, 1, 0xFFE0, d->event[i].c_str());
+    y += 12;
+
+    // Headline word-wrapped in white
+    y = nws_draw_wrapped(d->headline[i], 4, y, gfx->width() - 8, RGB565_WHITE);
+    y += 4;  // small gap between alerts
+  }
 }
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ---------------------------------------------------------------------------
+// Double-buffered pixel pipeline for GOES decode output
+//
+// JPEGDEC decodes on the fetch worker (core 0). With JPEG_USES_DMA it writes
+// alternate MCU strips into the two halves of its pixel buffer, so strip N+1
+// can be decoded while strip N is still being shifted out to the ILI9341.
+// The push itself runs in a small task on core 1: JPEGDraw hands it strip N
+// and returns at once, after waiting only for strip N-1 (the half the decoder
+// is about to overwrite) to finish. At most one strip is in flight, so the
+// decoder never writes into the half being pushed.
+//
+// The push handler returns false once the image is stale; the next
+// pipePost() then returns false and JPEGDEC stops decoding.
+// ---------------------------------------------------------------------------
+#define PIPE_CORE     1
+#define PIPE_STACK    3072
+#define PIPE_PRIORITY 2       // above loop(): a waiting strip stalls the decoder
+
+struct PipeStrip {
+  int16_t   x, y, w, h;
+  uint16_t *pixels;    // one half of JPEGDEC's pixel buffer
+};
+
+// Runs on the push task: draw one strip, false to abort the decode
+typedef bool (*PipeHandler)(const PipeStrip &strip);
+
+static QueueHandle_t     pipe_strips  = nullptr;
+static SemaphoreHandle_t pipe_idle    = nullptr;  // given while no strip is in flight
+static PipeHandler       pipe_handler = nullptr;
+static volatile bool     pipe_abort   = false;
+
+// Stats for the image in progress (reset by pipeStart)
+static volatile uint32_t pipe_n        = 0;   // strips pushed
+static volatile uint32_t pipe_busy_us  = 0;   // push task drawing
+static uint32_t          pipe_stall_us = 0;   // decoder waiting for the bus
+
+static void pipe_task(void *) {
+  PipeStrip s;
+  for (;;) {
+    if (xQueueReceive(pipe_strips, &s, portMAX_DELAY) != pdTRUE) continue;
+    unsigned long t0 = micros();
+    if (!pipe_abort && !pipe_handler(s)) pipe_abort = true;
+    pipe_busy_us += micros() - t0;
+    pipe_n++;
+    xSemaphoreGive(pipe_idle);
+  }
+}
+
+// Start the push task. handler runs every strip on core 1.
+static void pipeBegin(PipeHandler handler) {
+  pipe_handler = handler;
+  pipe_strips  = xQueueCreate(1, sizeof(PipeStrip));
+  pipe_idle    = xSemaphoreCreateBinary();
+  xSemaphoreGive(pipe_idle);
+  xTaskCreatePinnedToCore(pipe_task, "pixpush", PIPE_STACK, nullptr,
+                          PIPE_PRIORITY, nullptr, PIPE_CORE);
+}
+
+// Before each decode: clear the abort flag and the stats
+static void pipeStart() {
+  pipe_abort    = false;
+  pipe_n        = 0;
+  pipe_busy_us  = 0;
+  pipe_stall_us = 0;
+}
+
+// Decoder side: wait for the previous strip, then queue this one.
+// Returns false if the decode should stop.
+static bool pipePost(int x, int y, int w, int h, uint16_t *pixels) {
+  unsigned long t0 = micros();
+  xSemaphoreTake(pipe_idle, portMAX_DELAY);
+  pipe_stall_us += micros() - t0;
+  if (pipe_abort) {
+    xSemaphoreGive(pipe_idle);
+    return false;
+  }
+  PipeStrip s = { (int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h, pixels };
+  xQueueSend(pipe_strips, &s, portMAX_DELAY);
+  return true;
+}
+
+// After the decode: wait for the last strip to reach the panel.
+// Returns false if the handler aborted the image.
+static bool pipeFlush() {
+  unsigned long t0 = micros();
+  xSemaphoreTake(pipe_idle, portMAX_DELAY);
+  pipe_stall_us += micros() - t0;
+  xSemaphoreGive(pipe_idle);
+  return !pipe_abort;
+}
@@ -14,32 +14,33 @@ extern Arduino_GFX *gfx;
 struct CameraOption {
   const char *name;
   const char *url;
-  int x_off;  // JPEGDEC decode x offset (negative = crop from left of image)
-  int y_off;  // JPEGDEC decode y offset (negative = crop from top of image)
-  // x_off > 0 means image is narrower than screen; side bars need clearing
 };
 
+// Every product is laid out from its JPEG header (goesLayout in main.cpp):
+// the cheapest JPEGDEC scale (1, 1/2, 1/4, 1/8) whose output still covers
+// 320x240, centred. For the sizes below that is full scale and the offsets
+// that used to be hand-tuned per camera:
 // CONUS (416x250): crop to fill 320x240 with offset (-48, -5)
 // Square (250x250): center horizontally (35px bars each side), clip 5px from top
 // Full Disk (339x339): center crop to 320x240 (-9, -49)
-// Mesoscale (250x250): same layout as square sectors
+// A larger product (e.g. CONUS 1250x750, Full Disk 678x678) decodes at 1/2.
 static const CameraOption CAMERAS[] = {
   { "GOES-East CONUS (default)",
-    "https://cdn.star.nesdis.noaa.gov/GOES16/ABI/CONUS/GEOCOLOR/416x250.jpg",      -48, -5 },
+    "https://cdn.star.nesdis.noaa.gov/GOES16/ABI/CONUS/GEOCOLOR/416x250.jpg" },
   { "GOES-West CONUS",
-    "https://cdn.star.nesdis.noaa.gov/GOES18/ABI/CONUS/GEOCOLOR/416x250.jpg",      -48, -5 },
+    "https://cdn.star.nesdis.noaa.gov/GOES18/ABI/CONUS/GEOCOLOR/416x250.jpg" },
   { "Eastern US",
-    "https://cdn.star.nesdis.noaa.gov/GOES19/ABI/SECTOR/eus/GEOCOLOR/250x250.jpg",  35, -5 },
+    "https://cdn.star.nesdis.noaa.gov/GOES19/ABI/SECTOR/eus/GEOCOLOR/250x250.jpg" },
   { "Gulf of Mexico",
-    "https://cdn.star.nesdis.noaa.gov/GOES19/ABI/SECTOR/mex/GEOCOLOR/250x250.jpg",  35, -5 },
+    "https://cdn.star.nesdis.noaa.gov/GOES19/ABI/SECTOR/mex/GEOCOLOR/250x250.jpg" },
   { "Caribbean",
-    "https://cdn.star.nesdis.noaa.gov/GOES19/ABI/SECTOR/car/GEOCOLOR/250x250.jpg",  35, -5 },
+    "https://cdn.star.nesdis.noaa.gov/GOES19/ABI/SECTOR/car/GEOCOLOR/250x250.jpg" },
   { "Alaska",
-    "https://cdn.star.nesdis.noaa.gov/GOES18/ABI/SECTOR/ak/GEOCOLOR/250x250.jpg",   35, -5 },
+    "https://cdn.star.nesdis.noaa.gov/GOES18/ABI/SECTOR/ak/GEOCOLOR/250x250.jpg" },
   { "Full Earth Disk",
-    "https://cdn.star.nesdis.noaa.gov/GOES16/ABI/FD/GEOCOLOR/339x339.jpg",          -9,-49 },
+    "https://cdn.star.nesdis.noaa.gov/GOES16/ABI/FD/GEOCOLOR/339x339.jpg" },
   { "Mesoscale (hi-refresh)",
-    "https://cdn.star.nesdis.noaa.gov/GOES16/ABI/MESO/M1/GEOCOLOR/250x250.jpg",    35, -5 },
+    "https://cdn.star.nesdis.noaa.gov/GOES16/ABI/MESO/M1/GEOCOLOR/250x250.jpg" },
 };
 static const int NUM_CAMERAS = 8;
 
@@ -61,6 +62,7 @@ static char wc_lat[16]       = "";
 static char wc_lon[16]       = "";
 static bool wc_has_settings  = false;  // true if SSID was previously saved
 static bool wc_use_metric    = true;   // true = km/km/h, false = mi/mph
+static bool wc_fit_whole     = false;  // shrink wide GOES frames to fit instead of cropping
 
 // ---------------------------------------------------------------------------
 // Portal state
@@ -81,6 +83,7 @@ static void wcLoadSettings() {
   String lon  = prefs.getString("lon",  "");
   wc_camera_idx = prefs.getInt("camera", 0);
   wc_use_metric = prefs.getBool("metric", true);
+  wc_fit_whole  = prefs.getBool("fitwhole", false);
   prefs.end();
 
   wc_camera_idx = constrain(wc_camera_idx, 0, NUM_MODES - 1);
@@ -92,7 +95,7 @@ static void wcLoadSettings() {
 }
 
 static void wcSaveSettings(const char *ssid, const char *pass, int camera,
-                           const char *lat, const char *lon) {
+                           const char *lat, const char *lon, bool fitWhole) {
   Preferences prefs;
   prefs.begin("weathercore", false);
   prefs.putString("ssid",   ssid);
@@ -100,6 +103,7 @@ static void wcSaveSettings(const char *ssid, const char *pass, int camera,
   prefs.putInt   ("camera", camera);
   prefs.putString("lat",    lat);
   prefs.putString("lon",    lon);
+  prefs.putBool  ("fitwhole", fitWhole);
   prefs.end();
 
   strncpy(wc_wifi_ssid, ssid, sizeof(wc_wifi_ssid) - 1);
@@ -107,6 +111,7 @@ static void wcSaveSettings(const char *ssid, const char *pass, int camera,
   strncpy(wc_lat, lat, sizeof(wc_lat) - 1);
   strncpy(wc_lon, lon, sizeof(wc_lon) - 1);
   wc_camera_idx   = camera;
+  wc_fit_whole    = fitWhole;
   wc_has_settings = true;
 }
 
@@ -199,6 +204,7 @@ static void wcHandleRoot() {
     "label{display:block;text-align:left;margin:14px 0 4px;color:#88ddff;font-weight:bold;}"
     "input,select{width:100%;box-sizing:border-box;background:#002244;color:#00ccff;"
                  "border:2px solid #0066aa;border-radius:6px;padding:10px;font-size:1em;}"
+    "input[type=checkbox]{width:auto;margin-right:8px;}"
     ".btn{display:block;width:100%;padding:14px;margin:10px 0;font-size:1.05em;"
          "border-radius:8px;border:none;cursor:pointer;font-weight:bold;}"
     ".btn-save{background:#004488;color:#00ffff;border:2px solid #0099dd;}"
@@ -250,6 +256,9 @@ static void wcHandleRoot() {
     "<input type='text' name='lon' value='";
   html += String(wc_lon);
   html += "' placeholder='e.g. -77.0352' maxlength='15'>"
+    "<label><input type='checkbox' name='fitwhole' value='1'";
+  if (wc_fit_whole) html += " checked";
+  html += "> Show whole satellite frame (shrink to fit instead of cropping the edges)</label>"
     "<br><button class='btn btn-save' type='submit'>&#128190; Save &amp; Connect</button>"
     "</form>";
   if (wc_has_settings) {
@@ -270,6 +279,7 @@ static void wcHandleSave() {
   int    camera = portalServer->hasArg("camera") ? portalServer->arg("camera").toInt()  : 0;
   String lat    = portalServer->hasArg("lat")    ? portalServer->arg("lat")             : "";
   String lon    = portalServer->hasArg("lon")    ? portalServer->arg("lon")             : "";
+  bool   fit    = portalServer->hasArg("fitwhole");
   camera = constrain(camera, 0, NUM_MODES - 1);
 
   if (ssid.length() == 0) {
@@ -281,7 +291,7 @@ static void wcHandleSave() {
     return;
   }
 
-  wcSaveSettings(ssid.c_str(), pass.c_str(), camera, lat.c_str(), lon.c_str());
+  wcSaveSettings(ssid.c_str(), pass.c_str(), camera, lat.c_str(), lon.c_str(), fit);
 
   const char *modeName;
   if      (camera == NWS_FORECAST_MODE)  modeName = "NWS Forecast (Text)";
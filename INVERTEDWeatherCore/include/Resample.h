@@ -0,0 +1,180 @@
+#pragma once
+
+#include <Arduino.h>
+#include "PixelPipe.h"
+
+// ---------------------------------------------------------------------------
+// Streaming area-averaging resampler for GOES decode output
+//
+// Sits between JPEGDraw and the pixel pipeline when a frame is shrunk to fit
+// the panel instead of cropped (CONUS 416x250 -> 320x192). JPEGDEC hands over
+// MCU strips left to right, one MCU row (band) at a time; each strip is
+// averaged horizontally into a band buffer as it arrives, and once a band is
+// complete its rows are averaged vertically into output rows, which go to the
+// pipeline in double-buffered strips. Nothing is kept across bands but one
+// row of vertical accumulators, so there is no frame buffer.
+//
+// Fixed point: an RGB565 pixel is spread over a 32-bit word as 0x07E0F81F
+// (G moved to the top half), which leaves 5 guard bits above each channel.
+// One multiply-accumulate then weights R, G and B together. The weights of
+// every output pixel sum to exactly 32 (per axis), so an accumulator never
+// overflows and normalising is one add, a shift and a mask.
+//
+// Source pixels arrive little-endian (native); output is big-endian for
+// draw16bitBeRGBBitmap like the unscaled path. Shrinking only: each output
+// pixel covers at least one source pixel per axis.
+// ---------------------------------------------------------------------------
+#define RS_BAND_ROWS 16       // tallest MCU row JPEGDEC emits
+#define RS_OUT_ROWS  8        // output rows per pipeline strip
+#define RS_MASK      0x07E0F81Fu
+#define RS_ROUND     0x02008010u   // 16 in each spread channel: round to nearest
+
+// Per source column (or row): weight into the output pixel in progress, weight
+// carried into the next one, and whether the output pixel completes here
+struct RsTap {
+  uint16_t out;       // output column (row) that `w` goes to
+  uint8_t  w, wnext;
+  bool     emit;
+};
+
+struct Resampler {
+  int       sw, sh, dw, dh;   // source and output size
+  int       dx, dy;           // output position on screen
+  RsTap    *htap, *vtap;      // sw and sh entries
+  uint16_t *band;             // RS_BAND_ROWS rows of dw, horizontally averaged
+  uint32_t  carry[RS_BAND_ROWS];  // horizontal accumulator at a strip boundary
+  uint32_t *vacc;             // dw vertical accumulators
+  uint16_t *out[2];           // double-buffered output strips, RS_OUT_ROWS x dw
+  int       half, out_rows, out_y;
+  uint32_t  us;               // time spent resampling this frame
+};
+
+static Resampler *rs = nullptr;   // non-null while a shrinking decode runs
+
+static inline uint32_t rs_spread(uint16_t c) {
+  return (c | ((uint32_t)c << 16)) & RS_MASK;
+}
+
+static inline uint16_t rs_pack(uint32_t acc) {
+  uint32_t v = ((acc + RS_ROUND) >> 5) & RS_MASK;
+  return (uint16_t)(v | (v >> 16));
+}
+
+// Split n source pixels over m output pixels by area. Output pixel j covers
+// [j*n, (j+1)*n) in units of 1/m source pixel; a source pixel's weight is its
+// share of that span in 32nds, rounded so that every output pixel sums to 32.
+static void rs_taps(RsTap *t, int n, int m) {
+  int j = 0, pos = 0;   // output pixel in progress, position within it (0..n)
+  for (int i = 0; i < n; i++) {
+    int end = pos + m;
+    t[i].out = j;
+    if (end < n) {
+      t[i].w = (end * 32) / n - (pos * 32) / n;
+      t[i].wnext = 0;
+      t[i].emit = false;
+      pos = end;
+    } else {
+      t[i].w = 32 - (pos * 32) / n;
+      pos = end - n;
+      t[i].wnext = (pos * 32) / n;
+      t[i].emit = true;
+      j++;
+    }
+  }
+}
+
+// Push the output rows collected so far
+static bool rs_flush_out() {
+  if (!rs->out_rows) return true;
+  bool ok = pipePost(rs->dx, rs->dy + rs->out_y, rs->dw, rs->out_rows, rs->out[rs->half]);
+  rs->out_y   += rs->out_rows;
+  rs->out_rows = 0;
+  rs->half    ^= 1;   // pipePost waited for the strip that used this half
+  return ok;
+}
+
+// Average the finished band (rows y..y+h-1) vertically into output rows
+static bool rs_band(int y, int h) {
+  for (int r = 0; r < h && y + r < rs->sh; r++) {
+    const RsTap t = rs->vtap[y + r];
+    const uint16_t *src = rs->band + r * rs->dw;
+    uint32_t *acc = rs->vacc;
+    if (!t.emit) {
+      for (int c = 0; c < rs->dw; c++) acc[c] += rs_spread(src[c]) * t.w;
+      continue;
+    }
+    uint16_t *dst = rs->out[rs->half] + rs->out_rows * rs->dw;
+    for (int c = 0; c < rs->dw; c++) {
+      uint32_t s = rs_spread(src[c]);
+      uint16_t px = rs_pack(acc[c] + s * t.w);
+      dst[c] = (uint16_t)((px << 8) | (px >> 8));
+      acc[c] = s * t.wnext;
+    }
+    if (++rs->out_rows == RS_OUT_ROWS && !rs_flush_out()) return false;
+  }
+  return true;
+}
+
+// Set up a sw x sh -> dw x dh resample drawn at (dx, dy). False if out of RAM.
+static bool rsBegin(int sw, int sh, int dw, int dh, int dx, int dy) {
+  const size_t taps = sizeof(RsTap) * (sw + sh);
+  const size_t px   = sizeof(uint16_t) * dw * (RS_BAND_ROWS + 2 * RS_OUT_ROWS);
+  const size_t acc  = sizeof(uint32_t) * dw;
+  rs = (Resampler *)malloc(sizeof(Resampler) + taps + px + acc);
+  if (!rs) {
+    Serial.printf("[Resample] malloc(%u) failed\n", (unsigned)(sizeof(Resampler) + taps + px + acc));
+    return false;
+  }
+  memset(rs, 0, sizeof(Resampler));
+  rs->sw = sw; rs->sh = sh; rs->dw = dw; rs->dh = dh; rs->dx = dx; rs->dy = dy;
+  rs->vacc   = (uint32_t *)(rs + 1);
+  rs->htap   = (RsTap *)(rs->vacc + dw);
+  rs->vtap   = rs->htap + sw;
+  rs->band   = (uint16_t *)(rs->vtap + sh);
+  rs->out[0] = rs->band + dw * RS_BAND_ROWS;
+  rs->out[1] = rs->out[0] + dw * RS_OUT_ROWS;
+  memset(rs->vacc, 0, acc);
+  rs_taps(rs->htap, sw, dw);
+  rs_taps(rs->vtap, sh, dh);
+  return true;
+}
+
+// One decoded strip at (x, y) in source coordinates, `pitch` pixels per row.
+// Returns false if the decode should stop.
+static bool rsStrip(int x, int y, int w, int h, int pitch, const uint16_t *pixels) {
+  if (x >= rs->sw) return true;       // MCU padding past the right edge
+  unsigned long t0 = micros();
+  if (h > RS_BAND_ROWS) h = RS_BAND_ROWS;
+  const int x1 = min(x + w, rs->sw);   // the last MCU may run past the edge
+  for (int r = 0; r < h; r++) {
+    const uint16_t *src = pixels + r * pitch;
+    uint16_t *dst = rs->band + r * rs->dw;
+    uint32_t acc = x ? rs->carry[r] : 0;
+    for (int i = x; i < x1; i++) {
+      const RsTap &t = rs->htap[i];
+      uint32_t s = rs_spread(src[i - x]);
+      acc += s * t.w;
+      if (t.emit) {
+        dst[t.out] = rs_pack(acc);
+        acc = s * t.wnext;
+      }
+    }
+    rs->carry[r] = acc;
+  }
+  bool ok = x1 < rs->sw || rs_band(y, h);   // band complete at the right edge
+  rs->us += micros() - t0;
+  return ok;
+}
+
+// After the decode: push the last output rows. Returns false on abort.
+static bool rsFinish() {
+  unsigned long t0 = micros();
+  bool ok = rs_flush_out();
+  rs->us += micros() - t0;
+  return ok;
+}
+
+static void rsEnd() {
+  free(rs);
+  rs = nullptr;
+}
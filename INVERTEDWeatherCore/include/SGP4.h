@@ -0,0 +1,330 @@
+#pragma once
+
+#include <Arduino.h>
+#include <math.h>
+#include <cmath>
+
+// ---------------------------------------------------------------------------
+// SGP4 orbit propagator (near-earth branch)
+//
+// Propagates a two-line element set to a TEME position/velocity at any time
+// with no network access. Follows Vallado's revised sgp4unit ("improved"
+// mode, WGS-72 constants) for orbits with a period under 225 minutes — the
+// ISS and everything else in low earth orbit. Deep-space (SDP4) sets are
+// rejected by sgp4Parse.
+//
+// The elements are integrated over days in double: float's 24-bit mantissa
+// loses whole kilometres in the mean anomaly within hours. The firmware runs
+// the rest in double too; test/test_sgp4 times a float kernel against it.
+// ---------------------------------------------------------------------------
+#define SGP4_RE        6378.135                        // km (WGS-72)
+#define SGP4_XKE       0.0743669161331734132           // sqrt(GM) in er^1.5/min
+#define SGP4_J2        0.001082616
+#define SGP4_J3        (-0.00000253881)
+#define SGP4_J4        (-0.00000165597)
+#define SGP4_TWO_PI    6.283185307179586476925287
+#define SGP4_DEG2RAD   (M_PI / 180.0)
+
+struct Sgp4 {
+  double epoch_unix;                  // TLE epoch, seconds since 1970 (UTC)
+  double bstar, inclo, nodeo, ecco, argpo, mo, no;   // no = un-Kozai'd mean motion, rad/min
+  bool   isimp;
+  double aycof, con41, cc1, cc4, cc5, d2, d3, d4, delmo, eta, argpdot, omgcof, sinmao,
+         t2cof, t3cof, t4cof, t5cof, x1mth2, x7thm1, mdot, nodedot, xlcof, xmcof, nodecf;
+};
+
+// Stats (printed with the ISS log line)
+static uint32_t sgp4_last_us = 0;    // duration of the last sgp4Propagate call
+
+// Copy len characters from 1-based column col of a TLE line and parse as a double
+static double sgp4_field(const char *line, int col, int len) {
+  char buf[16];
+  memcpy(buf, line + col - 1, len);
+  buf[len] = '\0';
+  return atof(buf);
+}
+
+// TLE "assumed decimal point" exponent field, e.g. " 66816-4" = 0.66816e-4
+static double sgp4_exp_field(const char *line, int col) {
+  char buf[10] = "0.";
+  memcpy(buf + 2, line + col, 5);
+  buf[7] = '\0';
+  double v = atof(buf);
+  if (line[col - 1] == '-') v = -v;
+  int e = line[col + 6] - '0';
+  if (line[col + 5] == '-') e = -e;
+  return v * pow(10.0, e);
+}
+
+// Mod-10 checksum in column 69: digits count their value, '-' counts 1
+static bool sgp4_checksum(const char *line) {
+  int sum = 0;
+  for (int i = 0; i < 68; i++) {
+    if (isdigit((unsigned char)line[i])) sum += line[i] - '0';
+    else if (line[i] == '-')             sum += 1;
+  }
+  return line[68] - '0' == sum % 10;
+}
+
+// Days from 1970-01-01 to 1 January of year
+static long sgp4_days_to_year(int year) {
+  long days = 0;
+  for (int y = 1970; y < year; y++) days += (y % 4 == 0 && (y % 100 != 0 || y % 400 == 0)) ? 366 : 365;
+  return days;
+}
+
+// Parse a TLE and initialise the propagator. False on a malformed or
+// deep-space element set.
+static bool sgp4Parse(const char *l1, const char *l2, Sgp4 *s) {
+  if (strlen(l1) < 69 || strlen(l2) < 69 || l1[0] != '1' || l2[0] != '2') return false;
+  if (!sgp4_checksum(l1) || !sgp4_checksum(l2)) return false;
+
+  int year = (int)sgp4_field(l1, 19, 2);
+  year += year < 57 ? 2000 : 1900;
+  double day = sgp4_field(l1, 21, 12);
+  s->epoch_unix = (sgp4_days_to_year(year) + day - 1.0) * 86400.0;
+  s->bstar = sgp4_exp_field(l1, 54);
+
+  s->inclo = sgp4_field(l2, 9, 8)  * SGP4_DEG2RAD;
+  s->nodeo = sgp4_field(l2, 18, 8) * SGP4_DEG2RAD;
+  char ecc[10] = "0.";
+  memcpy(ecc + 2, l2 + 26, 7);
+  ecc[9] = '\0';
+  s->ecco  = atof(ecc);
+  s->argpo = sgp4_field(l2, 35, 8) * SGP4_DEG2RAD;
+  s->mo    = sgp4_field(l2, 44, 8) * SGP4_DEG2RAD;
+  double no_kozai = sgp4_field(l2, 53, 11) * SGP4_TWO_PI / 1440.0;  // rev/day -> rad/min
+  if (no_kozai <= 0) return false;
+
+  const double x2o3 = 2.0 / 3.0, j3oj2 = SGP4_J3 / SGP4_J2;
+
+  // Recover the original mean motion and semi-major axis from the Kozai elements
+  double eccsq  = s->ecco * s->ecco;
+  double omeosq = 1.0 - eccsq;
+  double rteosq = sqrt(omeosq);
+  double cosio  = cos(s->inclo);
+  double cosio2 = cosio * cosio;
+  double ak     = pow(SGP4_XKE / no_kozai, x2o3);
+  double d1     = 0.75 * SGP4_J2 * (3.0 * cosio2 - 1.0) / (rteosq * omeosq);
+  double del    = d1 / (ak * ak);
+  double adel   = ak * (1.0 - del * del - del * (1.0 / 3.0 + 134.0 * del * del / 81.0));
+  del   = d1 / (adel * adel);
+  s->no = no_kozai / (1.0 + del);
+  if (SGP4_TWO_PI / s->no >= 225.0) return false;  // deep space: SDP4 not implemented
+
+  double ao    = pow(SGP4_XKE / s->no, x2o3);
+  double sinio = sin(s->inclo);
+  double po    = ao * omeosq;
+  double con42 = 1.0 - 5.0 * cosio2;
+  s->con41     = -con42 - cosio2 - cosio2;
+  double posq  = po * po;
+  double rp    = ao * (1.0 - s->ecco);
+
+  s->isimp = rp < 220.0 / SGP4_RE + 1.0;
+  double sfour  = 78.0 / SGP4_RE + 1.0;
+  double qzms24 = pow((120.0 - 78.0) / SGP4_RE, 4);
+  double perige = (rp - 1.0) * SGP4_RE;
+  if (perige < 156.0) {
+    sfour = perige < 98.0 ? 20.0 : perige - 78.0;
+    qzms24 = pow((120.0 - sfour) / SGP4_RE, 4);
+    sfour  = sfour / SGP4_RE + 1.0;
+  }
+  double pinvsq = 1.0 / posq;
+  double tsi    = 1.0 / (ao - sfour);
+  s->eta        = ao * s->ecco * tsi;
+  double etasq  = s->eta * s->eta;
+  double eeta   = s->ecco * s->eta;
+  double psisq  = fabs(1.0 - etasq);
+  double coef   = qzms24 * pow(tsi, 4);
+  double coef1  = coef / pow(psisq, 3.5);
+  double cc2    = coef1 * s->no * (ao * (1.0 + 1.5 * etasq + eeta * (4.0 + etasq)) +
+                  0.375 * SGP4_J2 * tsi / psisq * s->con41 * (8.0 + 3.0 * etasq * (8.0 + etasq)));
+  s->cc1 = s->bstar * cc2;
+  double cc3 = s->ecco > 1.0e-4 ? -2.0 * coef * tsi * j3oj2 * s->no * sinio / s->ecco : 0.0;
+  s->x1mth2 = 1.0 - cosio2;
+  s->cc4 = 2.0 * s->no * coef1 * ao * omeosq *
+           (s->eta * (2.0 + 0.5 * etasq) + s->ecco * (0.5 + 2.0 * etasq) -
+            SGP4_J2 * tsi / (ao * psisq) *
+            (-3.0 * s->con41 * (1.0 - 2.0 * eeta + etasq * (1.5 - 0.5 * eeta)) +
+             0.75 * s->x1mth2 * (2.0 * etasq - eeta * (1.0 + etasq)) * cos(2.0 * s->argpo)));
+  s->cc5 = 2.0 * coef1 * ao * omeosq * (1.0 + 2.75 * (etasq + eeta) + eeta * etasq);
+
+  double cosio4 = cosio2 * cosio2;
+  double temp1  = 1.5 * SGP4_J2 * pinvsq * s->no;
+  double temp2  = 0.5 * temp1 * SGP4_J2 * pinvsq;
+  double temp3  = -0.46875 * SGP4_J4 * pinvsq * pinvsq * s->no;
+  s->mdot    = s->no + 0.5 * temp1 * rteosq * s->con41 +
+               0.0625 * temp2 * rteosq * (13.0 - 78.0 * cosio2 + 137.0 * cosio4);
+  s->argpdot = -0.5 * temp1 * con42 + 0.0625 * temp2 * (7.0 - 114.0 * cosio2 + 395.0 * cosio4) +
+               temp3 * (3.0 - 36.0 * cosio2 + 49.0 * cosio4);
+  double xhdot1 = -temp1 * cosio;
+  s->nodedot = xhdot1 + (0.5 * temp2 * (4.0 - 19.0 * cosio2) + 2.0 * temp3 * (3.0 - 7.0 * cosio2)) * cosio;
+  s->omgcof  = s->bstar * cc3 * cos(s->argpo);
+  s->xmcof   = s->ecco > 1.0e-4 ? -x2o3 * coef * s->bstar / eeta : 0.0;
+  s->nodecf  = 3.5 * omeosq * xhdot1 * s->cc1;
+  s->t2cof   = 1.5 * s->cc1;
+  double den = fabs(cosio + 1.0) > 1.5e-12 ? 1.0 + cosio : 1.5e-12;
+  s->xlcof   = -0.25 * j3oj2 * sinio * (3.0 + 5.0 * cosio) / den;
+  s->aycof   = -0.5 * j3oj2 * sinio;
+  s->delmo   = pow(1.0 + s->eta * cos(s->mo), 3);
+  s->sinmao  = sin(s->mo);
+  s->x7thm1  = 7.0 * cosio2 - 1.0;
+
+  s->d2 = s->d3 = s->d4 = s->t3cof = s->t4cof = s->t5cof = 0.0;
+  if (!s->isimp) {
+    double cc1sq = s->cc1 * s->cc1;
+    s->d2 = 4.0 * ao * tsi * cc1sq;
+    double temp = s->d2 * tsi * s->cc1 / 3.0;
+    s->d3 = (17.0 * ao + sfour) * temp;
+    s->d4 = 0.5 * temp * ao * tsi * (221.0 * ao + 31.0 * sfour) * s->cc1;
+    s->t3cof = s->d2 + 2.0 * cc1sq;
+    s->t4cof = 0.25 * (3.0 * s->d3 + s->cc1 * (12.0 * s->d2 + 10.0 * cc1sq));
+    s->t5cof = 0.2 * (3.0 * s->d4 + 12.0 * s->cc1 * s->d3 + 6.0 * s->d2 * s->d2 +
+                      15.0 * cc1sq * (2.0 * s->d2 + cc1sq));
+  }
+  return true;
+}
+
+// Minutes from the element set's epoch to a unix time
+static double sgp4Minutes(const Sgp4 *s, double utc) {
+  return (utc - s->epoch_unix) / 60.0;
+}
+
+// Position r (km) and velocity v (km/s) in TEME, t minutes after epoch.
+// False if the orbit has decayed or the elements diverged. The secular terms
+// are always double; T is the working type of the periodics and Kepler
+// solve after them (the firmware uses double; float is there to compare).
+template <typename T = double>
+static bool sgp4Propagate(const Sgp4 *s, double t, double r[3], double v[3]) {
+  unsigned long t0 = micros();
+  const double x2o3 = 2.0 / 3.0;
+
+  // Secular gravity and atmospheric drag
+  double xmdf   = s->mo + s->mdot * t;
+  double argpdf = s->argpo + s->argpdot * t;
+  double nodedf = s->nodeo + s->nodedot * t;
+  double argpm  = argpdf;
+  double mm     = xmdf;
+  double t2     = t * t;
+  double nodem  = nodedf + s->nodecf * t2;
+  double tempa  = 1.0 - s->cc1 * t;
+  double tempe  = s->bstar * s->cc4 * t;
+  double templ  = s->t2cof * t2;
+  if (!s->isimp) {
+    double delomg = s->omgcof * t;
+    double delm   = s->xmcof * (pow(1.0 + s->eta * cos(xmdf), 3) - s->delmo);
+    mm    = xmdf + delomg + delm;
+    argpm = argpdf - delomg - delm;
+    double t3 = t2 * t, t4 = t3 * t;
+    tempa = tempa - s->d2 * t2 - s->d3 * t3 - s->d4 * t4;
+    tempe = tempe + s->bstar * s->cc5 * (sin(mm) - s->sinmao);
+    templ = templ + s->t3cof * t3 + t4 * (s->t4cof + t * s->t5cof);
+  }
+
+  double am = pow(SGP4_XKE / s->no, x2o3) * tempa * tempa;
+  double nm = SGP4_XKE / pow(am, 1.5);
+  double em = s->ecco - tempe;
+  if (em >= 1.0 || em < -0.001) return false;
+  if (em < 1.0e-6) em = 1.0e-6;
+  mm += s->no * templ;
+  double xlm = mm + argpm + nodem;
+  nodem = fmod(nodem, SGP4_TWO_PI);
+  argpm = fmod(argpm, SGP4_TWO_PI);
+  xlm   = fmod(xlm, SGP4_TWO_PI);
+  mm    = fmod(xlm - argpm - nodem, SGP4_TWO_PI);
+
+  // Long-period periodics. From here on every angle is reduced, so the
+  // kernel runs in T.
+  const T one = 1, half = T(0.5), j2 = (T)SGP4_J2, xke = (T)SGP4_XKE;
+  const T con41 = (T)s->con41, x1mth2 = (T)s->x1mth2;
+  T sinip = std::sin((T)s->inclo), cosip = std::cos((T)s->inclo);
+  T emT   = (T)em, amT = (T)am, nodemT = (T)nodem;
+  T axnl  = emT * std::cos((T)argpm);
+  T temp  = one / (amT * (one - emT * emT));
+  T aynl  = emT * std::sin((T)argpm) + temp * (T)s->aycof;
+  T xl    = (T)mm + (T)argpm + nodemT + temp * (T)s->xlcof * axnl;
+
+  // Kepler's equation
+  T u = std::fmod(xl - nodemT, (T)SGP4_TWO_PI);
+  T eo1 = u, tem5 = 9999, sineo1 = 0, coseo1 = 0;
+  const T tol = sizeof(T) < sizeof(double) ? T(1.0e-6) : T(1.0e-12);   // float cannot resolve 1e-12
+  for (int ktr = 0; std::fabs(tem5) >= tol && ktr < 10; ktr++) {
+    sineo1 = std::sin(eo1);
+    coseo1 = std::cos(eo1);
+    tem5 = (u - aynl * coseo1 + axnl * sineo1 - eo1) / (one - coseo1 * axnl - sineo1 * aynl);
+    if (std::fabs(tem5) >= T(0.95)) tem5 = tem5 > 0 ? T(0.95) : T(-0.95);
+    eo1 += tem5;
+  }
+
+  // Short-period periodics
+  T ecose = axnl * coseo1 + aynl * sineo1;
+  T esine = axnl * sineo1 - aynl * coseo1;
+  T el2   = axnl * axnl + aynl * aynl;
+  T pl    = amT * (one - el2);
+  if (pl < 0) return false;
+  T rl     = amT * (one - ecose);
+  T rdotl  = std::sqrt(amT) * esine / rl;
+  T rvdotl = std::sqrt(pl) / rl;
+  T betal  = std::sqrt(one - el2);
+  temp = esine / (one + betal);
+  T sinu  = amT / rl * (sineo1 - aynl - axnl * temp);
+  T cosu  = amT / rl * (coseo1 - axnl + aynl * temp);
+  T su    = std::atan2(sinu, cosu);
+  T sin2u = (cosu + cosu) * sinu;
+  T cos2u = one - 2 * sinu * sinu;
+  temp = one / pl;
+  T temp1 = half * j2 * temp;
+  T temp2 = temp1 * temp;
+
+  T mrt   = rl * (one - T(1.5) * temp2 * betal * con41) + half * temp1 * x1mth2 * cos2u;
+  su      = su - T(0.25) * temp2 * (T)s->x7thm1 * sin2u;
+  T xnode = nodemT + T(1.5) * temp2 * cosip * sin2u;
+  T xinc  = (T)s->inclo + T(1.5) * temp2 * cosip * sinip * cos2u;
+  T mvt   = rdotl - (T)nm * temp1 * x1mth2 * sin2u / xke;
+  T rvdot = rvdotl + (T)nm * temp1 * (x1mth2 * cos2u + T(1.5) * con41) / xke;
+  if (mrt < one) return false;  // below the surface: decayed
+
+  // Orientation vectors
+  T sinsu = std::sin(su), cossu = std::cos(su);
+  T snod  = std::sin(xnode), cnod = std::cos(xnode);
+  T sini  = std::sin(xinc), cosi = std::cos(xinc);
+  T xmx = -snod * cosi, xmy = cnod * cosi;
+  T ux = xmx * sinsu + cnod * cossu, uy = xmy * sinsu + snod * cossu, uz = sini * sinsu;
+  T vx = xmx * cossu - cnod * sinsu, vy = xmy * cossu - snod * sinsu, vz = sini * cossu;
+
+  const T re = (T)SGP4_RE, vkmpersec = re * xke / 60;
+  r[0] = mrt * ux * re;
+  r[1] = mrt * uy * re;
+  r[2] = mrt * uz * re;
+  v[0] = (mvt * ux + rvdot * vx) * vkmpersec;
+  v[1] = (mvt * uy + rvdot * vy) * vkmpersec;
+  v[2] = (mvt * uz + rvdot * vz) * vkmpersec;
+  sgp4_last_us = micros() - t0;
+  return true;
+}
+
+// Greenwich mean sidereal time (IAU-82) in radians at a UTC unix time (UT1 ~ UTC)
+static double sgp4Gmst(double utc) {
+  double tut1 = (utc / 86400.0 + 2440587.5 - 2451545.0) / 36525.0;
+  double sec  = -6.2e-6 * tut1 * tut1 * tut1 + 0.093104 * tut1 * tut1 +
+                (876600.0 * 3600.0 + 8640184.812866) * tut1 + 67310.54841;
+  double g = fmod(sec * SGP4_DEG2RAD / 240.0, SGP4_TWO_PI);
+  return g < 0.0 ? g + SGP4_TWO_PI : g;
+}
+
+// TEME position -> geodetic latitude / longitude (degrees) and height (km), WGS-84
+static void sgp4Geodetic(const double r[3], double gmst, double *lat, double *lon, double *alt) {
+  const double a = 6378.137, e2 = 0.00669437999014;
+  double x = cos(gmst) * r[0] + sin(gmst) * r[1];
+  double y = -sin(gmst) * r[0] + cos(gmst) * r[1];
+  double p = sqrt(x * x + y * y);
+  double phi = atan2(r[2], p * (1.0 - e2)), n = a;
+  for (int i = 0; i < 4; i++) {
+    double sp = sin(phi);
+    n   = a / sqrt(1.0 - e2 * sp * sp);
+    phi = atan2(r[2] + e2 * n * sp, p);
+  }
+  *lat = phi / SGP4_DEG2RAD;
+  *lon = atan2(y, x) / SGP4_DEG2RAD;
+  *alt = p / cos(phi) - n;
+}
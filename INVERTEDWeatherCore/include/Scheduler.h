@@ -0,0 +1,130 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ---------------------------------------------------------------------------
+// Refresh scheduler
+//
+// Every data source (one per mode) sits in a small indexed min-heap keyed by
+// the millis() it is next due. loop() asks for the most urgent due source
+// and hands it to the fetch worker; on completion the source is put back
+// with its next deadline. The visible mode always goes first; background
+// sources are spaced SCHED_BG_GAP_MS apart and held back when the heap is
+// short, so they never compete with the screen for bandwidth or TLS memory.
+//
+// Deadlines are compared as signed differences, so millis() wrap is safe.
+// ---------------------------------------------------------------------------
+#define SCHED_MAX          16
+#define SCHED_BG_GAP_MS    5000            // min spacing between background fetches
+#define SCHED_BG_MIN_HEAP  (60 * 1024)     // skip background work below this
+
+struct SchedEntry {
+  unsigned long due;
+  int8_t        src;
+};
+
+static SchedEntry    sched_heap[SCHED_MAX];
+static int8_t        sched_pos[SCHED_MAX];     // heap index of each source, -1 = idle
+static int           sched_n = 0;
+static unsigned long sched_last_bg = 0;        // when the last background job went out
+
+// Stats (printed by loop() with the heap line)
+static uint16_t sched_runs[SCHED_MAX];         // fetches dispatched per source
+
+static bool sched_before(const SchedEntry &a, const SchedEntry &b) {
+  return (long)(a.due - b.due) < 0;
+}
+
+static void sched_swap(int i, int j) {
+  SchedEntry t = sched_heap[i];
+  sched_heap[i] = sched_heap[j];
+  sched_heap[j] = t;
+  sched_pos[sched_heap[i].src] = i;
+  sched_pos[sched_heap[j].src] = j;
+}
+
+static void sched_up(int i) {
+  while (i > 0) {
+    int p = (i - 1) / 2;
+    if (!sched_before(sched_heap[i], sched_heap[p])) break;
+    sched_swap(i, p);
+    i = p;
+  }
+}
+
+static void sched_down(int i) {
+  for (;;) {
+    int l = 2 * i + 1, r = l + 1, m = i;
+    if (l < sched_n && sched_before(sched_heap[l], sched_heap[m])) m = l;
+    if (r < sched_n && sched_before(sched_heap[r], sched_heap[m])) m = r;
+    if (m == i) break;
+    sched_swap(i, m);
+    i = m;
+  }
+}
+
+static void schedInit() {
+  sched_n = 0;
+  for (int i = 0; i < SCHED_MAX; i++) sched_pos[i] = -1;
+}
+
+// Take src off the schedule (no-op if it is not on it)
+static void schedCancel(int src) {
+  int i = sched_pos[src];
+  if (i < 0) return;
+  sched_pos[src] = -1;
+  if (--sched_n == i) return;
+  int moved = sched_heap[sched_n].src;
+  sched_heap[i] = sched_heap[sched_n];
+  sched_pos[moved] = i;
+  sched_up(i);
+  sched_down(sched_pos[moved]);
+}
+
+// (Re)schedule src to run at due
+static void schedAt(int src, unsigned long due) {
+  int i = sched_pos[src];
+  if (i < 0) {
+    i = sched_n++;
+    sched_heap[i].src = src;
+    sched_pos[src] = i;
+  }
+  sched_heap[i].due = due;
+  sched_up(i);
+  sched_down(sched_pos[src]);
+}
+
+// Schedule src at due unless it is already due sooner
+static void schedNoLaterThan(int src, unsigned long due) {
+  int i = sched_pos[src];
+  if (i >= 0 && (long)(sched_heap[i].due - due) <= 0) return;
+  schedAt(src, due);
+}
+
+static bool schedPending(int src) {
+  return sched_pos[src] >= 0;
+}
+
+// Deadline of src (only meaningful if schedPending)
+static unsigned long schedDue(int src) {
+  return sched_pos[src] >= 0 ? sched_heap[sched_pos[src]].due : 0;
+}
+
+// Pop the source to fetch now, or -1. `visible` wins whenever it is due;
+// otherwise the earliest due source runs if the background budget allows.
+static int schedNext(int visible, bool allowBackground) {
+  unsigned long now = millis();
+  int src = -1;
+  if (visible >= 0 && sched_pos[visible] >= 0 && (long)(schedDue(visible) - now) <= 0) {
+    src = visible;
+  } else if (sched_n > 0 && (long)(sched_heap[0].due - now) <= 0 && allowBackground &&
+             now - sched_last_bg >= SCHED_BG_GAP_MS &&
+             ESP.getMaxAllocHeap() >= SCHED_BG_MIN_HEAP) {
+    src = sched_heap[0].src;
+    sched_last_bg = now;
+  }
+  if (src < 0) return -1;
+  schedCancel(src);
+  sched_runs[src]++;
+  return src;
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <Arduino_GFX_Library.h>
+
+extern Arduino_GFX *gfx;
+
+// ---------------------------------------------------------------------------
+// Retained screen model for the text modes
+//
+// A text mode is drawn as an ordered list of widgets (text runs, filled
+// rectangles, custom blocks) between scrBegin() and scrEnd(). Each widget
+// carries a hash of everything that affects its pixels. The list of the frame
+// on screen is kept, and the next frame of the same mode is diffed against it
+// slot by slot: an unchanged widget costs no SPI traffic at all, a changed one
+// has its old rectangle erased (if it moved or shrank) and is repainted, and
+// widgets that overlap anything repainted this frame are repainted after it.
+// A periodic refresh therefore only pushes the rectangles whose values moved.
+//
+// Anything that paints the content area behind the model's back (mode switch
+// "Loading...", GOES decode, banner taken down) calls scrInvalidate(), and the
+// next frame is a full repaint. Everything here runs under the GfxLock.
+// ---------------------------------------------------------------------------
+#define SCR_MAX_WIDGETS 48
+#define SCR_TOP         20    // content area starts below the status bar
+
+struct ScrWidget {
+  int16_t  x, y, w, h;
+  uint16_t bg;        // what erasing this widget paints
+  uint32_t hash;
+  bool     painted;   // new frame: painted (not skipped) this frame
+  bool     done;      // old frame: matched, erased or repainted already
+  bool     erased;    // old frame: its rectangle was cleared this frame
+};
+
+static ScrWidget scr_prev[SCR_MAX_WIDGETS], scr_cur[SCR_MAX_WIDGETS];
+static int       scr_nprev = 0, scr_n = 0;
+static int       scr_screen = -1;      // mode whose widgets are on screen, -1 = unknown
+static bool      scr_full = false;     // this frame repaints everything
+static bool      scr_damaged = false;  // an erase hit a widget already passed
+static bool      scr_painted_top = false;
+
+// Stats (printed by loop() with the heap line)
+static uint32_t scr_frames   = 0;   // frames drawn
+static uint32_t scr_repaints = 0;   // widgets painted
+static uint32_t scr_skipped  = 0;   // widgets left alone
+static uint32_t scr_bytes    = 0;   // pixel bytes pushed, erases included
+
+static uint32_t scrHash(const void *p, size_t n, uint32_t h = 2166136261u) {
+  const uint8_t *b = (const uint8_t *)p;
+  while (n--) { h ^= *b++; h *= 16777619u; }
+  return h;
+}
+
+static bool scr_overlap(const ScrWidget &a, int x, int y, int w, int h) {
+  return a.x < x + w && x < a.x + a.w && a.y < y + h && y < a.y + a.h;
+}
+
+static void scr_fill(int x, int y, int w, int h, uint16_t color) {
+  gfx->fillRect(x, y, w, h, color);
+  scr_bytes += (uint32_t)w * h * 2;
+  if (y < SCR_TOP + 14) scr_painted_top = true;
+}
+
+// Clear old widget k. New widgets [0, passed) are already final on screen;
+// if the erase cuts into one of them the frame is damaged
+static void scr_erase(int k, int passed) {
+  ScrWidget &o = scr_prev[k];
+  o.done = o.erased = true;
+  scr_fill(o.x, o.y, o.w, o.h, o.bg);
+  for (int i = 0; i < passed; i++)
+    if (scr_overlap(scr_cur[i], o.x, o.y, o.w, o.h)) scr_damaged = true;
+}
+
+// Forget what is on screen: the next frame repaints in full
+void scrInvalidate() { scr_screen = -1; }
+
+// Start a frame of `screen`. Returns true if it is a full repaint.
+bool scrBegin(int screen) {
+  scr_full        = (screen != scr_screen);
+  scr_screen      = screen;
+  scr_n           = 0;
+  scr_damaged     = false;
+  scr_painted_top = false;
+  if (scr_full) {
+    scr_nprev = 0;
+    scr_fill(0, SCR_TOP, gfx->width(), gfx->height() - SCR_TOP, RGB565_BLACK);
+  }
+  for (int k = 0; k < scr_nprev; k++) scr_prev[k].done = scr_prev[k].erased = false;
+  scr_frames++;
+  return scr_full;
+}
+
+// Declare the next widget. Returns true if the caller must paint it now
+// (covering the whole rectangle); false if the screen already shows it.
+bool scrWidget(int x, int y, int w, int h, uint32_t hash, uint16_t bg = RGB565_BLACK) {
+  if (scr_n >= SCR_MAX_WIDGETS) return true;   // untracked overflow: always paint
+  const int slot = scr_n++;
+  ScrWidget &c = scr_cur[slot];
+  c = { (int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h, bg, hash, false, false, false };
+
+  if (!scr_full && slot < scr_nprev) {
+    ScrWidget &o = scr_prev[slot];
+    bool sameRect = o.x == x && o.y == y && o.w == w && o.h == h;
+    bool same = sameRect && !o.done && o.hash == hash;
+    // Painted over or wiped earlier this frame: it has to go on top again
+    for (int i = 0; same && i < slot; i++)
+      if (scr_cur[i].painted && scr_overlap(scr_cur[i], x, y, w, h)) same = false;
+    for (int k = 0; same && k < scr_nprev; k++)
+      if (scr_prev[k].erased && scr_overlap(scr_prev[k], x, y, w, h)) same = false;
+    if (same) {
+      o.done = true;
+      scr_skipped++;
+      return false;
+    }
+    // Repainting the same rectangle covers the old pixels; anything else the
+    // old frame left underneath is cleared first
+    if (sameRect) o.done = true;
+    for (int k = 0; k < scr_nprev; k++)
+      if (!scr_prev[k].done && (k == slot || scr_overlap(scr_prev[k], x, y, w, h))) scr_erase(k, slot);
+  }
+  c.painted = true;
+  scr_repaints++;
+  scr_bytes += (uint32_t)w * h * 2;
+  if (y < SCR_TOP + 14) scr_painted_top = true;
+  return true;
+}
+
+// Text run at (x, y), painted opaquely on bg. Returns the x just past it.
+int scrText(int x, int y, uint8_t size, uint16_t fg, const char *text, uint16_t bg = RGB565_BLACK) {
+  const int w = (int)strlen(text) * 6 * size, h = 8 * size;
+  if (!w) return x;
+  uint32_t hv = scrHash(text, strlen(text), scrHash(&fg, sizeof(fg), size));
+  if (scrWidget(x, y, w, h, hv, bg)) {
+    gfx->setTextColor(fg, bg);
+    gfx->setTextSize(size);
+    gfx->setCursor(x, y);
+    gfx->print(text);
+  }
+  return x + w;
+}
+
+// Solid rectangle (bars, divider lines)
+void scrRect(int x, int y, int w, int h, uint16_t color) {
+  uint32_t hv = scrHash(&color, sizeof(color), 0x9E3779B9u);
+  if (scrWidget(x, y, w, h, hv)) gfx->fillRect(x, y, w, h, color);
+}
+
+// Finish the frame: erase widgets that are gone. Returns false if an erase
+// damaged a widget painted earlier in the frame; the caller then draws the
+// frame again, which is a full repaint.
+bool scrEnd() {
+  if (!scr_full) {
+    for (int k = 0; k < scr_nprev; k++)
+      if (!scr_prev[k].done) scr_erase(k, scr_n);
+  }
+  memcpy(scr_prev, scr_cur, sizeof(ScrWidget) * scr_n);
+  scr_nprev = scr_n;
+  if (scr_damaged) scrInvalidate();
+  return !scr_damaged;
+}
+
+// True if the last frame painted anything in the top rows where the NWS
+// alert banner sits, so the banner has to be drawn over it again
+bool scrPaintedTop() { return scr_painted_top; }
@@ -6,44 +6,78 @@
 #include <Arduino_GFX_Library.h>
 #include <math.h>
 
+#include "HTTPPool.h"
+#include "Screen.h"
+
 #define SW_UPDATE_INTERVAL (15UL * 60UL * 1000UL)  // 15 minutes
 
 extern Arduino_GFX *gfx;
 
 // ---------------------------------------------------------------------------
-// HTTP helper (SWPC endpoints require no auth, just setInsecure)
+// Tail fetch (SWPC endpoints require no auth)
+//
+// Each feed is an array of rows, oldest first, and only the last row is
+// used — but plasma and mag run to hundreds of rows. The requests ask for
+// just the tail with `Range: bytes=-N`; if the server answers 200 instead of
+// 206 the full body is streamed through an N-byte ring that keeps only the
+// tail. Either way nothing larger than the ring is ever held, and the ring
+// itself lives on the fetch worker's stack (SwFetch), not the heap.
+//
+// All three GETs go out back-to-back on one keep-alive session
+// (pool_pipeline), so a refresh costs one round trip instead of three.
 // ---------------------------------------------------------------------------
-static String sw_https_get(const String &url) {
-  Serial.printf("[SW] GET %s\n", url.c_str());
-  WiFiClientSecure *client = new WiFiClientSecure;
-  if (!client) return "";
-  client->setInsecure();
-  String body;
-  {
-    HTTPClient https;
-    https.begin(*client, url);
-    https.setTimeout(15000);
-    https.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
-    int code = https.GET();
-    if (code == HTTP_CODE_OK) body = https.getString();
-    else Serial.printf("[SW] HTTP error: %d\n", code);
-    https.end();
+#define SW_HOST       "services.swpc.noaa.gov"
+#define SW_TAIL_BYTES 1024   // a row is < 120 B, so this always holds the last one
+#define SW_FEEDS      3
+
+static const char *const sw_feed_paths[SW_FEEDS] = {
+  "/products/noaa-planetary-k-index.json",
+  "/products/solar-wind/plasma-5-minute.json",
+  "/products/solar-wind/mag-5-minute.json",
+};
+static const char *const sw_feed_names[SW_FEEDS] = { "Kp", "plasma", "mag" };
+
+// Body bytes each feed transferred on the last refresh (-1 = no body)
+static int32_t sw_feed_bytes[SW_FEEDS] = { -1, -1, -1 };
+
+// Rotate buf left by k bytes in place (three reversals, no scratch memory)
+static void sw_rotate(char *buf, size_t len, size_t k) {
+  auto rev = [](char *a, char *b) { while (a < --b) { char t = *a; *a++ = *b; *b = t; } };
+  rev(buf, buf + k);
+  rev(buf + k, buf + len);
+  rev(buf, buf + len);
+}
+
+// Read the last cap-1 bytes of a 200/206 body into tail (NUL-terminated).
+// Returns the tail length, or -1 if the body did not arrive whole.
+static int sw_read_tail(PoolBody *b, int code, const char *name, char *tail, size_t cap) {
+  const size_t ring = cap - 1;
+  for (;;) {
+    size_t off = b->total % ring;
+    if (pool_body_read(b, (uint8_t *)tail + off, ring - off) <= 0) break;
   }
-  delete client;
-  return body;
+  size_t len = (size_t)b->total < ring ? (size_t)b->total : ring;
+  if ((size_t)b->total > ring) sw_rotate(tail, ring, b->total % ring);  // oldest byte first
+  tail[len] = '\0';
+  Serial.printf("[SW] %s: %d B transferred (%s)\n", name, (int)b->total,
+                code == HTTP_CODE_PARTIAL_CONTENT ? "range" : "full body, ring");
+  return b->done ? (int)len : -1;
 }
 
 // ---------------------------------------------------------------------------
-// Extract last data row from a NOAA array-of-arrays JSON body.
-// Avoids parsing the full document (which can have 60+ rows and overflow
-// a small DynamicJsonDocument).  Returns e.g. `["2026-..","3.33","18","8"]`
+// Locate the last data row of a NOAA array-of-arrays JSON tail, e.g.
+// `["2026-..","3.33","18","8"]`, and parse it into doc. The tail may start
+// mid-row; only the final complete row is looked at.
 // ---------------------------------------------------------------------------
-static String sw_last_row_str(const String &body) {
-  int end = body.lastIndexOf("]]");
-  if (end < 0) return "";
-  int start = body.lastIndexOf("[", end - 1);
-  if (start < 0) return "";
-  return body.substring(start, end + 1);
+static bool sw_last_row(char *tail, JsonDocument &doc) {
+  char *end = nullptr;
+  for (char *p = strstr(tail, "]]"); p; p = strstr(p + 1, "]]")) end = p;
+  if (!end) return false;
+  char *start = end;
+  while (start > tail && *start != '[') start--;
+  if (*start != '[') return false;
+  end[1] = '\0';
+  return !deserializeJson(doc, start);
 }
 
 // ---------------------------------------------------------------------------
@@ -63,100 +97,110 @@ static float sw_aurora_lat(float kp) {
   return 77.0f - kp * 3.5f;
 }
 
+// Parsed SWPC snapshot: built by the fetch worker, drawn by loop()
+struct SwData {
+  float  kp;       // planetary Kp
+  String kpTime;   // "HH:MM" UTC of the Kp sample
+  float  speed;    // solar wind km/s, -1 if unavailable
+  float  bz, bt;   // nT, bz = 999 if unavailable
+};
+
 // ---------------------------------------------------------------------------
-// Fetch Kp index, solar wind speed, and Bz — draw on screen.
-// Returns true on success (at least Kp was fetched).
+// Fetch Kp index, solar wind speed, and Bz (no drawing).
+// Returns a new snapshot owned by the caller, or nullptr unless at least Kp
+// was fetched.
 // ---------------------------------------------------------------------------
-bool swFetchAndDisplay(const char *lat, const char *lon) {
-
-  // ── 1. Kp index (3-hour planetary) ───────────────────────────────────────
-  float  kpVal  = -1.0f;
-  String kpTime = "";
-  {
-    String body = sw_https_get(
-      "https://services.swpc.noaa.gov/products/noaa-planetary-k-index.json");
-    if (!body.isEmpty()) {
-      String rowStr = sw_last_row_str(body);
-      if (!rowStr.isEmpty()) {
-        DynamicJsonDocument doc(256);
-        if (!deserializeJson(doc, rowStr)) {
-          JsonArray row = doc.as<JsonArray>();
-          const char *ks = row[1] | "0";
-          kpVal = String(ks).toFloat();
-          String ts = String(row[0] | "");
-          if (ts.length() >= 16) kpTime = ts.substring(11, 16);  // "HH:MM"
-        }
-      }
-    }
-  }
+struct SwFetch {
+  char   tail[SW_TAIL_BYTES + 1];
+  float  kp    = -1.0f;
+  String kpTime;
+  float  speed = -1.0f;
+  float  bz    = 999.0f;   // sentinel
+  float  bt    = 0.0f;
+};
 
-  // ── 2. Solar wind plasma — speed (km/s) ──────────────────────────────────
-  float swSpeed = -1.0f;
-  {
-    String body = sw_https_get(
-      "https://services.swpc.noaa.gov/products/solar-wind/plasma-5-minute.json");
-    if (!body.isEmpty()) {
-      String rowStr = sw_last_row_str(body);
-      if (!rowStr.isEmpty()) {
-        DynamicJsonDocument doc(256);
-        if (!deserializeJson(doc, rowStr)) {
-          JsonArray row = doc.as<JsonArray>();
-          const char *vs = row[2] | "-1";
-          swSpeed = String(vs).toFloat();
-        }
-      }
-    }
+// pool_pipeline sink: pick the latest values out of each feed as it arrives
+static void sw_feed_sink(void *ctx, int feed, int code, PoolBody *body) {
+  SwFetch *f = (SwFetch *)ctx;
+  if (code != HTTP_CODE_OK && code != HTTP_CODE_PARTIAL_CONTENT) {
+    if (code == POOL_ERROR_CANCELLED) Serial.printf("[SW] %s cancelled\n", sw_feed_names[feed]);
+    else Serial.printf("[SW] %s HTTP error: %d\n", sw_feed_names[feed], code);
+    return;
   }
+  int len = sw_read_tail(body, code, sw_feed_names[feed], f->tail, sizeof(f->tail));
+  sw_feed_bytes[feed] = body->total;
+  if (len <= 0) return;
+  StaticJsonDocument<384> doc;
+  if (!sw_last_row(f->tail, doc)) return;
+  JsonArray row = doc.as<JsonArray>();
 
-  // ── 3. Solar wind magnetic field — Bz and Bt (nT) ────────────────────────
-  float bzVal = 999.0f;   // sentinel
-  float btVal = 0.0f;
-  {
-    String body = sw_https_get(
-      "https://services.swpc.noaa.gov/products/solar-wind/mag-5-minute.json");
-    if (!body.isEmpty()) {
-      String rowStr = sw_last_row_str(body);
-      if (!rowStr.isEmpty()) {
-        DynamicJsonDocument doc(384);
-        if (!deserializeJson(doc, rowStr)) {
-          JsonArray row = doc.as<JsonArray>();
-          const char *bzs = row[3] | "999";
-          const char *bts = row[6] | "0";
-          bzVal = String(bzs).toFloat();
-          btVal = String(bts).toFloat();
-        }
-      }
+  switch (feed) {
+    case 0: {  // Kp index (3-hour planetary)
+      const char *ks = row[1] | "0";
+      f->kp = String(ks).toFloat();
+      String ts = String(row[0] | "");
+      if (ts.length() >= 16) f->kpTime = ts.substring(11, 16);  // "HH:MM"
+      break;
+    }
+    case 1: {  // Solar wind plasma — speed (km/s)
+      const char *vs = row[2] | "-1";
+      f->speed = String(vs).toFloat();
+      break;
+    }
+    case 2: {  // Solar wind magnetic field — Bz and Bt (nT)
+      const char *bzs = row[3] | "999";
+      const char *bts = row[6] | "0";
+      f->bz = String(bzs).toFloat();
+      f->bt = String(bts).toFloat();
+      break;
     }
   }
+}
+
+SwData *swFetch() {
+  char range[24];
+  snprintf(range, sizeof(range), "bytes=-%u", (unsigned)SW_TAIL_BYTES);
+  const char *const hdrs[] = { "Range", range, nullptr };
+
+  SwFetch f;
+  for (int i = 0; i < SW_FEEDS; i++) sw_feed_bytes[i] = -1;
+  unsigned long t0 = millis();
+  int piped = pool_pipeline(SW_HOST, sw_feed_paths, SW_FEEDS, hdrs, sw_feed_sink, &f);
+  Serial.printf("[SW] %d feeds in %lu ms (%d pipelined)\n", SW_FEEDS, millis() - t0, piped);
 
-  if (kpVal < 0) return false;  // Kp is the essential field
+  if (f.kp < 0) return nullptr;  // Kp is the essential field
 
-  // ── Draw ──────────────────────────────────────────────────────────────────
-  gfx->fillRect(0, 20, gfx->width(), gfx->height() - 20, RGB565_BLACK);
+  SwData *d = new SwData{ f.kp, f.kpTime, f.speed, f.bz, f.bt };
+  Serial.printf("[SW] Kp=%.2f Speed=%.0f Bz=%.1f Bt=%.1f\n", d->kp, d->speed, d->bz, d->bt);
+  return d;
+}
+
+// ---------------------------------------------------------------------------
+// Draw a space weather snapshot; lat is the user's latitude for the aurora check.
+// Widgets go through the screen model, so a refresh only repaints changed values.
+// ---------------------------------------------------------------------------
+void swDraw(const SwData *d, const char *lat) {
+  const float kpVal   = d->kp;
+  const float swSpeed = d->speed;
+  const float bzVal   = d->bz;
+  const float btVal   = d->bt;
+  const String &kpTime = d->kpTime;
 
   // Sub-header bar
-  gfx->fillRect(0, 20, gfx->width(), 12, 0x0841);
-  gfx->setTextColor(0xFD20);
-  gfx->setTextSize(1);
-  gfx->setCursor(4, 22);
-  gfx->print("NOAA Space Weather");
+  scrRect(0, 20, gfx->width(), 12, 0x0841);
+  scrText(4, 22, 1, 0xFD20, "NOAA Space Weather", 0x0841);
   if (!kpTime.isEmpty()) {
     String ts = "Kp@" + kpTime + " UTC";
-    gfx->setTextColor(0x7BEF);
-    gfx->setCursor(gfx->width() - (int)ts.length() * 6 - 4, 22);
-    gfx->print(ts);
+    scrText(gfx->width() - (int)ts.length() * 6 - 4, 22, 1, 0x7BEF, ts.c_str(), 0x0841);
   }
 
   int y = 36;
 
   // ── Kp + G-storm level ───────────────────────────────────────────────────
   uint16_t kpColor = sw_kp_color(kpVal);
-  gfx->setTextColor(kpColor);
-  gfx->setTextSize(3);
   char kpStr[16];
   snprintf(kpStr, sizeof(kpStr), "Kp %.1f", kpVal);
-  gfx->setCursor(4, y);
-  gfx->print(kpStr);
+  scrText(4, y, 3, kpColor, kpStr);
 
   // G-level badge: derive from kp
   const char *gLabel = "G0";
@@ -165,59 +209,46 @@ bool swFetchAndDisplay(const char *lat, const char *lon) {
   else if (kpVal >= 7.0f) gLabel = "G3";
   else if (kpVal >= 6.0f) gLabel = "G2";
   else if (kpVal >= 5.0f) gLabel = "G1";
-  gfx->setTextSize(2);
   int gx = 4 + 10 * 18;  // after "Kp X.X" at textSize 3 (18px/char)
-  gfx->setTextColor(kpColor);
-  gfx->setCursor(gx, y + 6);
-  gfx->print(gLabel);
+  scrText(gx, y + 6, 2, kpColor, gLabel);
   y += 30;
 
   // ── Aurora visibility estimate ───────────────────────────────────────────
-  gfx->setTextSize(1);
   float auroraLat = sw_aurora_lat(kpVal);
   if (kpVal < 4.0f) {
-    gfx->setTextColor(0x07E0);
-    gfx->setCursor(4, y);
-    gfx->print("Aurora: quiet  (Kp >= 4 needed)");
+    scrText(4, y, 1, 0x07E0, "Aurora: quiet  (Kp >= 4 needed)");
     y += 11;
   } else {
-    gfx->setTextColor(0x07FF);
     char msg[48];
     snprintf(msg, sizeof(msg), "Aurora possible above %.0f%cN", auroraLat, 176);
-    gfx->setCursor(4, y); gfx->print(msg);
+    scrText(4, y, 1, 0x07FF, msg);
     y += 11;
     // Check against user's saved latitude
     float userLat = atof(lat);
     if (userLat >= auroraLat) {
-      gfx->setTextColor(0x07E0);
-      gfx->setCursor(4, y);
-      gfx->print(">>> Possibly visible at your lat!");
+      scrText(4, y, 1, 0x07E0, ">>> Possibly visible at your lat!");
     } else {
-      gfx->setTextColor(0x7BEF);
       char dist[44];
       snprintf(dist, sizeof(dist), "Your lat %.1f%cN (need >= %.0f%cN)",
                userLat, 176, auroraLat, 176);
-      gfx->setCursor(4, y); gfx->print(dist);
+      scrText(4, y, 1, 0x7BEF, dist);
     }
     y += 11;
   }
 
   // Divider
-  gfx->drawFastHLine(0, y, gfx->width(), 0x2104);
+  scrRect(0, y, gfx->width(), 1, 0x2104);
   y += 5;
 
   // ── Solar wind speed ─────────────────────────────────────────────────────
-  gfx->setTextColor(0xFD20);
-  gfx->setTextSize(1);
-  gfx->setCursor(4, y); gfx->print("Solar Wind:");
+  scrText(4, y, 1, 0xFD20, "Solar Wind:");
   y += 11;
 
   if (swSpeed > 0) {
     uint16_t sc = (swSpeed > 600) ? 0xF800 : (swSpeed > 450) ? 0xFFE0 : 0x07E0;
-    gfx->setTextColor(sc);
     char buf[40];
     snprintf(buf, sizeof(buf), "Speed: %.0f km/s", swSpeed);
-    gfx->setCursor(4, y); gfx->print(buf);
+    scrText(4, y, 1, sc, buf);
     y += 11;
   }
 
@@ -226,30 +257,23 @@ bool swFetchAndDisplay(const char *lat, const char *lon) {
     // Bz: negative (southward) = aurora-enhancing
     uint16_t bc = (bzVal < -10) ? 0xF800 : (bzVal < -5) ? 0xFFE0 :
                   (bzVal < 0)   ? 0x07FF : 0x07E0;
-    gfx->setTextColor(bc);
     char buf[48];
     snprintf(buf, sizeof(buf), "Bz: %+.1f nT    Bt: %.1f nT", bzVal, btVal);
-    gfx->setCursor(4, y); gfx->print(buf);
+    scrText(4, y, 1, bc, buf);
     y += 11;
 
-    gfx->setTextColor(0x7BEF);
-    gfx->setCursor(4, y);
-    if      (bzVal < -10) gfx->print("Bz strongly south - aurora enhanced");
-    else if (bzVal < -5)  gfx->print("Bz southward - favorable for aurora");
-    else if (bzVal < 0)   gfx->print("Bz slightly south - mild enhancement");
-    else if (bzVal < 5)   gfx->print("Bz near zero - mixed conditions");
-    else                  gfx->print("Bz northward - reduced aurora");
+    const char *note;
+    if      (bzVal < -10) note = "Bz strongly south - aurora enhanced";
+    else if (bzVal < -5)  note = "Bz southward - favorable for aurora";
+    else if (bzVal < 0)   note = "Bz slightly south - mild enhancement";
+    else if (bzVal < 5)   note = "Bz near zero - mixed conditions";
+    else                  note = "Bz northward - reduced aurora";
+    scrText(4, y, 1, 0x7BEF, note);
     y += 11;
   }
 
   // Divider + scale reference
-  gfx->drawFastHLine(0, y, gfx->width(), 0x2104);
+  scrRect(0, y, gfx->width(), 1, 0x2104);
   y += 5;
-  gfx->setTextColor(0x7BEF);
-  gfx->setTextSize(1);
-  gfx->setCursor(4, y);
-  gfx->print("G1=Kp5  G2=Kp6  G3=Kp7  G4=Kp8  G5=Kp9");
-
-  Serial.printf("[SW] Kp=%.2f Speed=%.0f Bz=%.1f Bt=%.1f\n", kpVal, swSpeed, bzVal, btVal);
-  return true;
+  scrText(4, y, 1, 0x7BEF, "G1=Kp5  G2=Kp6  G3=Kp7  G4=Kp8  G5=Kp9");
 }
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+#include "HTTPPool.h"
+
+// ---------------------------------------------------------------------------
+// Background fetch worker
+//
+// All network I/O and parsing runs in a FreeRTOS task pinned to core 0, next
+// to the WiFi stack. loop() on core 1 only queues jobs, keeps handling touch,
+// the BOOT button, identityHandle() and the countdown bar, and draws the
+// parsed snapshots the worker hands back through the result queue.
+//
+// The pool (HTTPPool.h) is owned by the worker: nothing on core 1 touches it.
+// Each job runs with a pool cancel token tied to fetch_gen, so when loop()
+// moves to another mode the transfer in progress stops at its next socket
+// poll and its session and buffers are released. Prefetch jobs use
+// prefetch_gen instead: a tap onto the camera being prefetched (or its
+// neighbour) should let the download finish, so loop() only bumps it when
+// the neighbour cache drops that camera or the location changes.
+// ---------------------------------------------------------------------------
+#define FETCH_CORE      0
+#define FETCH_STACK     12288   // TLS handshake + JSON parse headroom
+#define FETCH_PRIORITY  1
+#define FETCH_QUEUE_LEN 4
+
+enum FetchStatus : int8_t {
+  FETCH_FAILED,        // nothing usable — retry later
+  FETCH_OK,            // data holds a fresh snapshot to draw
+  FETCH_DRAWN,         // the job drew straight to the screen (GOES decode)
+  FETCH_NOT_MODIFIED,  // 304 — what is on screen is still current
+};
+
+struct FetchJob {
+  int      mode;
+  uint32_t gen;        // fetch_gen (prefetch_gen) when queued; stale once bumped
+  char     lat[16];    // copies, so the portal can rewrite wc_lat/wc_lon safely
+  char     lon[16];
+  unsigned long queued_ms;  // millis() when posted, for the start-latency log
+  bool     prefetch;   // fill the neighbour cache rather than the screen
+  uint32_t budget;     // prefetch: max bytes the payload may use
+  void    *payload;    // input data for the job, handed back in FetchResult.data
+};
+
+struct FetchResult {
+  int         mode;
+  uint32_t    gen;
+  FetchStatus status;
+  void       *data;    // mode-specific snapshot, owned by whoever receives it
+  bool        prefetch;
+};
+
+// Runs on the worker: fetch + parse one job and fill in res.status / res.data
+typedef void (*FetchHandler)(const FetchJob &job, FetchResult &res);
+
+static QueueHandle_t     fetch_jobs    = nullptr;
+static QueueHandle_t     fetch_results = nullptr;
+static FetchHandler      fetch_handler = nullptr;
+static volatile uint32_t fetch_gen     = 0;   // bumped by loop() on every mode change
+static volatile uint32_t prefetch_gen  = 0;   // bumped when an in-flight prefetch is unwanted
+
+// The generation a job is cancelled by
+static const volatile uint32_t *fetchGenOf(const FetchJob &job) {
+  return job.prefetch ? &prefetch_gen : &fetch_gen;
+}
+
+// True once loop() has moved on since the job was queued
+static bool fetchIsStale(const FetchJob &job) {
+  return job.gen != *fetchGenOf(job);
+}
+
+static void fetch_task(void *) {
+  FetchJob job;
+  for (;;) {
+    if (xQueueReceive(fetch_jobs, &job, pdMS_TO_TICKS(1000)) == pdTRUE) {
+      FetchResult res = { job.mode, job.gen, FETCH_FAILED, job.payload, job.prefetch };
+      if (fetchIsStale(job)) {
+        // User already moved past it: hand any payload straight back
+        xQueueSend(fetch_results, &res, portMAX_DELAY);
+        continue;
+      }
+      unsigned long t0 = millis();
+      Serial.printf("[Fetch] mode %d started %lu ms after it was queued\n",
+                    job.mode, t0 - job.queued_ms);
+
+      PoolCancel cancel = { fetchGenOf(job), job.gen };
+      pool_cancel = &cancel;
+      fetch_handler(job, res);
+      pool_cancel = nullptr;
+
+      if (fetchIsStale(job)) {
+        Serial.printf("[Fetch] mode %d cancelled after %lu ms\n", job.mode, millis() - t0);
+      }
+      xQueueSend(fetch_results, &res, portMAX_DELAY);
+    }
+    // Housekeeping between jobs: sessions die with the link, idle ones time out
+    if (WiFi.status() != WL_CONNECTED) pool_close_all();
+    pool_tick();
+  }
+}
+
+// Start the worker. handler runs every job on core 0.
+static void fetchBegin(FetchHandler handler) {
+  fetch_handler = handler;
+  fetch_jobs    = xQueueCreate(FETCH_QUEUE_LEN, sizeof(FetchJob));
+  fetch_results = xQueueCreate(FETCH_QUEUE_LEN, sizeof(FetchResult));
+  xTaskCreatePinnedToCore(fetch_task, "fetch", FETCH_STACK, nullptr,
+                          FETCH_PRIORITY, nullptr, FETCH_CORE);
+}
+
+// Queue a job for mode (never blocks). Returns false if the queue is full,
+// in which case the caller still owns payload.
+static bool fetchPost(int mode, const char *lat, const char *lon,
+                      bool prefetch = false, uint32_t budget = 0, void *payload = nullptr) {
+  FetchJob job;
+  job.mode     = mode;
+  job.prefetch = prefetch;
+  job.budget   = budget;
+  job.payload  = payload;
+  job.gen      = *fetchGenOf(job);
+  strncpy(job.lat, lat, sizeof(job.lat) - 1);
+  job.lat[sizeof(job.lat) - 1] = '\0';
+  strncpy(job.lon, lon, sizeof(job.lon) - 1);
+  job.lon[sizeof(job.lon) - 1] = '\0';
+  job.queued_ms = millis();
+  return xQueueSend(fetch_jobs, &job, 0) == pdTRUE;
+}
+
+// Non-blocking: take the next finished job, if any
+static bool fetchPoll(FetchResult *res) {
+  return xQueueReceive(fetch_results, res, 0) == pdTRUE;
+}
+
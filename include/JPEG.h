@@ -1,4 +1,118 @@
 #pragma once
 
 #include <JPEGDEC.h>
+#include "HTTPPool.h"
 JPEGDEC jpeg;
+
+// ---------------------------------------------------------------------------
+// Streaming source: JPEGDEC pulls compressed bytes through its read/seek
+// callbacks straight off the pooled TLS socket instead of from a 100 KB
+// malloc'd copy of the whole file. A small ring keeps the most recent bytes
+// so the short backward seeks JPEGDEC makes while refilling its file buffer
+// are served locally. Peak heap for a GOES refresh is the ring, not the image.
+// ---------------------------------------------------------------------------
+#define JPEG_STREAM_RING  8192          // must be a power of two
+#define JPEG_STREAM_DRAIN 4096          // read at most this much trailing junk
+
+struct JpegStream {
+  PoolBody      body;        // framing-aware reader over the pooled socket
+  int32_t       pulled;      // bytes taken off the socket so far
+  unsigned long t_start;
+  uint32_t      heap_start;
+  uint32_t      heap_min;    // free-heap low-water mark while streaming
+  uint8_t       ring[JPEG_STREAM_RING];
+};
+
+// Pull up to n more body bytes from the socket into the ring.
+static int32_t jpeg_stream_pull(JpegStream *s, int32_t n) {
+  int32_t got = 0;
+  while (got < n) {
+    int32_t off   = s->pulled & (JPEG_STREAM_RING - 1);
+    int32_t chunk = min(n - got, JPEG_STREAM_RING - off);
+    int32_t r = pool_body_read(&s->body, s->ring + off, chunk);
+    if (r <= 0) break;  // end of body, timeout or connection closed
+    s->pulled += r;
+    got       += r;
+  }
+  uint32_t heap = ESP.getFreeHeap();
+  if (heap < s->heap_min) s->heap_min = heap;
+  return got;
+}
+
+static int32_t jpeg_stream_read(JPEGFILE *f, uint8_t *buf, int32_t len) {
+  JpegStream *s = (JpegStream *)f->fHandle;
+  int32_t done = 0;
+  while (done < len) {
+    int32_t pos = f->iPos;
+    if (pos < s->pulled - JPEG_STREAM_RING) {
+      Serial.printf("[JPEG] seek to %d fell out of the %d B window\n", (int)pos, JPEG_STREAM_RING);
+      break;
+    }
+    if (pos >= s->pulled) {
+      // Forward seek or plain refill: pull at most half a ring so the bytes
+      // between pos and the write head can never be overwritten.
+      int32_t want = min(pos - s->pulled + (len - done), (int32_t)(JPEG_STREAM_RING / 2));
+      if (jpeg_stream_pull(s, want) <= 0) break;  // end of body
+      continue;
+    }
+    int32_t n     = min(len - done, s->pulled - pos);
+    int32_t off   = pos & (JPEG_STREAM_RING - 1);
+    int32_t first = min(n, JPEG_STREAM_RING - off);
+    memcpy(buf + done, s->ring + off, first);
+    memcpy(buf + done + first, s->ring, n - first);
+    done    += n;
+    f->iPos += n;
+  }
+  return done;
+}
+
+// Seeks are resolved lazily by the next read
+static int32_t jpeg_stream_seek(JPEGFILE *f, int32_t pos) {
+  f->iPos = pos;
+  return pos;
+}
+
+// Called by jpeg.close(): finish the HTTP request and free the ring
+static void jpeg_stream_close(void *handle) {
+  JpegStream *s = (JpegStream *)handle;
+  if (!s) return;
+  // JPEGDEC stops at EOI; drain a short tail so the session stays reusable
+  int32_t drained = 0;
+  while (!s->body.done && !s->body.error && drained < JPEG_STREAM_DRAIN) {
+    int32_t r = jpeg_stream_pull(s, JPEG_STREAM_RING / 2);
+    if (r <= 0) break;
+    drained += r;
+  }
+  pool_end(s->body.conn, pool_body_reusable(&s->body));
+  Serial.printf("[JPEG] %d B streamed in %lu ms, heap low-water %u (peak use %u B)\n",
+                (int)s->pulled, millis() - s->t_start,
+                (unsigned)s->heap_min, (unsigned)(s->heap_start - s->heap_min));
+  free(s);
+}
+
+// Hand the body of a pool_get() response to JPEGDEC. On success the caller
+// decodes and jpeg.close() ends the request; on failure it is already ended.
+static bool jpeg_open_stream(PoolConn *conn, JPEG_DRAW_CALLBACK *draw) {
+  uint32_t heap = ESP.getFreeHeap();
+  JpegStream *s = (JpegStream *)malloc(sizeof(JpegStream));
+  if (!s) {
+    Serial.printf("[JPEG] ring malloc(%d) failed\n", (int)sizeof(JpegStream));
+    pool_end(conn, false);
+    return false;
+  }
+  pool_body_begin(&s->body, conn);
+  s->pulled     = 0;
+  s->t_start    = millis();
+  s->heap_start = heap;
+  s->heap_min   = ESP.getFreeHeap();
+
+  // JPEGDEC only uses the size as an upper bound on reads
+  int32_t len = s->body.chunked ? -1 : s->body.left;
+  if (!jpeg.open(s, len > 0 ? len : 0x7FFFFFFF,
+                 jpeg_stream_close, jpeg_stream_read, jpeg_stream_seek, draw)) {
+    Serial.printf("[JPEG] open failed, error %d\n", jpeg.getLastError());
+    jpeg_stream_close(s);
+    return false;
+  }
+  return true;
+}
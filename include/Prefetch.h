@@ -0,0 +1,112 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ---------------------------------------------------------------------------
+// Neighbour prefetch cache
+//
+// While the worker is idle, loop() fetches the GOES cameras either side of
+// the one on screen and keeps the compressed JPEG, so a left/right tap
+// decodes from RAM (openRAM) instead of starting a cold download. Text modes
+// need no help here: the scheduler keeps all of their snapshots current.
+//
+// The cache only stores opaque pointers and their size; the owner supplies
+// the free function. Everything here runs on loop()'s core.
+// ---------------------------------------------------------------------------
+#define PREFETCH_MAX_MODES 16
+#define PREFETCH_BUDGET    (96 * 1024)   // total bytes held across all slots
+#define PREFETCH_IDLE_MS   2000          // wait this long after a tap before prefetching
+#define PREFETCH_HEAP_KEEP (64 * 1024)   // never let the cache eat into TLS headroom
+#define PREFETCH_RETRY_MS  (5 * 60 * 1000)  // back off after a failed prefetch
+
+typedef void (*PrefetchFree)(int mode, void *data);
+
+struct PrefetchSlot {
+  void         *data;        // nullptr = empty
+  uint32_t      bytes;
+  unsigned long fetched_ms;  // millis() when the payload was downloaded
+  unsigned long failed_ms;   // last failed prefetch, 0 = none
+};
+
+static PrefetchSlot prefetch_slots[PREFETCH_MAX_MODES];
+static PrefetchFree prefetch_free = nullptr;
+
+// Stats (printed by loop() with the heap line)
+static uint32_t prefetch_used   = 0;   // bytes currently cached
+static uint32_t prefetch_hits   = 0;   // mode switches served from RAM
+static uint32_t prefetch_misses = 0;   // mode switches that had to fetch first
+
+static void prefetchDrop(int mode) {
+  PrefetchSlot &s = prefetch_slots[mode];
+  if (!s.data) return;
+  if (prefetch_free) prefetch_free(mode, s.data);
+  prefetch_used -= s.bytes;
+  s.data  = nullptr;
+  s.bytes = 0;
+}
+
+// True if mode is one of the three around `center` that a trim keeps
+static bool prefetchKeeps(int center, int mode, int numModes) {
+  int d = center < 0 ? numModes : abs(mode - center);
+  return d <= 1 || d == numModes - 1;  // wraps at both ends
+}
+
+// Drop everything except the three modes around `center` (-1 keeps nothing)
+static void prefetchTrim(int center, int numModes) {
+  for (int m = 0; m < numModes; m++)
+    if (!prefetchKeeps(center, m, numModes)) prefetchDrop(m);
+}
+
+// True if mode has nothing cached younger than maxAge (and did not just fail)
+static bool prefetchWants(int mode, unsigned long maxAge) {
+  const PrefetchSlot &s = prefetch_slots[mode];
+  if (s.failed_ms && millis() - s.failed_ms < PREFETCH_RETRY_MS) return false;
+  return !s.data || millis() - s.fetched_ms >= maxAge;
+}
+
+static void prefetchFailed(int mode) {
+  prefetch_slots[mode].failed_ms = millis() | 1;
+}
+
+// Bytes a new payload may use right now
+static uint32_t prefetchRoom() {
+  uint32_t room = PREFETCH_BUDGET - prefetch_used;
+  uint32_t heap = ESP.getMaxAllocHeap();
+  uint32_t spare = heap > PREFETCH_HEAP_KEEP ? heap - PREFETCH_HEAP_KEEP : 0;
+  return room < spare ? room : spare;
+}
+
+// Store a payload for mode (replacing any older one). Takes ownership: if it
+// does not fit in the budget it is freed and false is returned.
+static bool prefetchPut(int mode, void *data, uint32_t bytes, unsigned long fetched_ms) {
+  prefetchDrop(mode);
+  if (bytes > PREFETCH_BUDGET - prefetch_used) {
+    if (prefetch_free) prefetch_free(mode, data);
+    return false;
+  }
+  PrefetchSlot &s = prefetch_slots[mode];
+  s.data        = data;
+  s.bytes       = bytes;
+  s.fetched_ms  = fetched_ms;
+  s.failed_ms   = 0;
+  prefetch_used += bytes;
+  return true;
+}
+
+// Take mode's payload out of the cache if it is younger than maxAge.
+// Counts a hit or a miss; the caller owns the returned payload.
+static void *prefetchTake(int mode, unsigned long maxAge, unsigned long *fetched_ms) {
+  PrefetchSlot &s = prefetch_slots[mode];
+  if (s.data && millis() - s.fetched_ms >= maxAge) prefetchDrop(mode);
+  if (!s.data) {
+    prefetch_misses++;
+    return nullptr;
+  }
+  void *d = s.data;
+  *fetched_ms    = s.fetched_ms;
+  prefetch_used -= s.bytes;
+  s.data  = nullptr;
+  s.bytes = 0;
+  prefetch_hits++;
+  return d;
+}
@@ -1,59 +1,51 @@
 #pragma once
 
-#include <HTTPClient.h>
-#include <WiFiClientSecure.h>
-#include <ArduinoJson.h>
 #include <Arduino_GFX_Library.h>
 #include <math.h>
+#include <cmath>
 #include <time.h>
 
-// Refresh hourly — sunrise/sunset API + moon position are stable over hours
-#define SUN_MOON_INTERVAL (60UL * 60UL * 1000UL)
+#include "Screen.h"
 
-extern Arduino_GFX *gfx;
+// Everything on this screen is computed on the board (no network), so it is
+// simply recomputed every minute
+#define SUN_MOON_INTERVAL (60UL * 1000UL)
 
-// ── HTTP helper ───────────────────────────────────────────────────────────────
-static String sm_https_get(const String &url) {
-  Serial.printf("[SunMoon] GET %s\n", url.c_str());
-  WiFiClientSecure *client = new WiFiClientSecure;
-  if (!client) return "";
-  client->setInsecure();
-  String body;
-  {
-    HTTPClient https;
-    https.begin(*client, url);
-    https.addHeader("User-Agent", "esp32-cyd-nexrad (github.com/Coreymillia)");
-    https.setTimeout(15000);
-    https.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
-    int code = https.GET();
-    if (code == HTTP_CODE_OK) body = https.getString();
-    else Serial.printf("[SunMoon] HTTP %d\n", code);
-    https.end();
-  }
-  delete client;
-  return body;
-}
+extern Arduino_GFX *gfx;
 
 // ── Helpers ───────────────────────────────────────────────────────────────────
 
-// Parse "2026-03-14T06:14:22+00:00" → h, m (UTC)
-static void sm_parse_iso(const String &s, int &h, int &m) {
-  h = m = 0;
-  int t = s.indexOf('T');
-  if (t < 0) return;
-  h = s.substring(t + 1, t + 3).toInt();
-  m = s.substring(t + 4, t + 6).toInt();
-}
-
 static void sm_fmt(char *buf, int h, int m) {
   if (h < 0) snprintf(buf, 8, "--:--");
   else        snprintf(buf, 8, "%02d:%02d", h, m);
 }
 
+// Minutes after UTC midnight → "HH:MM" (negative = no such event today)
+static void sm_fmt_min(char *buf, double minutes) {
+  if (minutes < 0) { sm_fmt(buf, -1, 0); return; }
+  int t = (int)floor(minutes + 0.5) % 1440;
+  sm_fmt(buf, t / 60, t % 60);
+}
+
 // ── Astronomy ─────────────────────────────────────────────────────────────────
+// The ESP32 FPU is single precision only, so double trig is done in software.
+// The kernels below are templated on their working type and run in sm_real:
+// float by default, double with -DSM_DOUBLE (e.g. to compare on the host).
+// Anything that counts days stays double — a Julian Day has no fractional
+// bits left in a float — and so does each fast-moving mean angle until it
+// has been reduced to 0–360°. After that reduction float keeps ~0.1",
+// well inside the arcminute the series themselves are good to.
+#ifdef SM_DOUBLE
+typedef double sm_real;
+#else
+typedef float sm_real;
+#endif
 
 static double sm_rev(double x) { return x - 360.0 * floor(x / 360.0); }
 
+// Reduce an angle (degrees) in double, then hand it on in the kernel's type
+template <typename T> static T sm_revt(double x) { return (T)sm_rev(x); }
+
 // Julian Day Number
 static double sm_jd(int yr, int mo, int dy, double h = 0.0) {
   if (mo <= 2) { yr--; mo += 12; }
@@ -67,6 +59,62 @@ static double sm_d2k(int yr, int mo, int dy, double h = 0.0) {
   return sm_jd(yr, mo, dy, h) - 2451545.0;
 }
 
+// ── Sun (NOAA solar calculator / Meeus, good to ~1 min) ───────────────────────
+
+// Solar declination (degrees) and equation of time (minutes) at a Julian Day
+template <typename T>
+static void sm_sun_params(double jd, T &decl, T &eqtime) {
+  const T toR = (T)(M_PI / 180.0);
+  double Td = (jd - 2451545.0) / 36525.0;
+  T L0 = sm_revt<T>(280.46646 + Td * (36000.76983 + Td * 0.0003032));  // mean longitude
+  T M  = sm_revt<T>(357.52911 + Td * (35999.05029 - 0.0001537 * Td)); // mean anomaly
+  T t  = (T)Td;
+  T e  = T(0.016708634) - t * (T(0.000042037) + T(0.0000001267) * t); // orbit eccentricity
+  T C  = std::sin(M * toR) * (T(1.914602) - t * (T(0.004817) + T(0.000014) * t))
+       + std::sin(2 * M * toR) * (T(0.019993) - T(0.000101) * t)
+       + std::sin(3 * M * toR) * T(0.000289);                          // equation of centre
+  T omega  = sm_revt<T>(125.04 - 1934.136 * Td);
+  T lambda = L0 + C - T(0.00569) - T(0.00478) * std::sin(omega * toR); // apparent longitude
+  T eps0   = T(23) + (T(26) + (T(21.448) - t * (T(46.815) + t * (T(0.00059) - t * T(0.001813)))) / 60) / 60;
+  T eps    = (eps0 + T(0.00256) * std::cos(omega * toR)) * toR;        // true obliquity
+
+  decl = std::asin(std::sin(eps) * std::sin(lambda * toR)) / toR;
+
+  T y = std::tan(eps / 2) * std::tan(eps / 2);
+  T l = L0 * toR, m = M * toR;
+  eqtime = 4 / toR * (y * std::sin(2 * l) - 2 * e * std::sin(m) + 4 * e * y * std::sin(m) * std::cos(2 * l)
+                      - T(0.5) * y * y * std::sin(4 * l) - T(1.25) * e * e * std::sin(2 * m));
+}
+
+// Minutes after UTC midnight at which the sun's centre reaches `zenith`
+// degrees on the given UTC day: dir = -1 morning, +1 evening, 0 = solar noon.
+// Returns -1 if it never gets there (polar day / night). lon is E+.
+template <typename T = sm_real>
+static double sm_sun_event(int yr, int mo, int dy, double lat, double lon, double zenith, int dir) {
+  const T toR = (T)(M_PI / 180.0);
+  double jd0 = sm_jd(yr, mo, dy);
+  T la = (T)lat * toR, t = T(720) - 4 * (T)lon;   // first guess: mean solar noon
+  for (int i = 0; i < 3; i++) {                   // re-evaluate the sun at the event itself
+    T decl, eqtime;
+    sm_sun_params<T>(jd0 + (double)t / 1440.0, decl, eqtime);
+    T ha = 0;
+    if (dir) {
+      T c = std::cos((T)zenith * toR) / (std::cos(la) * std::cos(decl * toR))
+          - std::tan(la) * std::tan(decl * toR);
+      if (c < -1 || c > 1) return -1.0;
+      ha = std::acos(c) / toR;
+    }
+    t = T(720) - 4 * (T)lon - eqtime + dir * 4 * ha;
+  }
+  return fmod((double)t + 2880.0, 1440.0);
+}
+
+// Sun zenith angles for the events shown (refraction + semi-diameter for rise/set)
+#define SM_ZENITH_RISESET  90.833
+#define SM_ZENITH_CIVIL    96.0
+#define SM_ZENITH_NAUTICAL 102.0
+#define SM_ZENITH_ASTRO    108.0
+
 // Moon age in days since last new moon (0 = new, ~14.77 = full, ~29.53 = next new)
 static double sm_moon_age(double jd) {
   const double T   = 29.53058853;
@@ -88,116 +136,235 @@ static const char *sm_phase_name(double age) {
 }
 
 // Moon ecliptic longitude & latitude using Paul Schlyter's algorithm
-// d = days since J2000.0; results in degrees
-static void sm_moon_ecl(double d, double &lon, double &lat) {
-  const double toR = M_PI / 180.0;
+// d = days since J2000.0; results in degrees. dist (optional) = Earth radii
+template <typename T>
+static void sm_moon_ecl(double d, T &lon, T &lat, T *dist = nullptr) {
+  const T toR = (T)(M_PI / 180.0), toD = (T)(180.0 / M_PI);
+  d += 1.5;   // Schlyter's day count starts at 2000 Jan 0.0 UT, 1.5 days before J2000
 
-  double N = sm_rev(125.1228 - 0.0529538083  * d);
-  double w = sm_rev(318.0634 + 0.1643573223  * d);
-  double M = sm_rev(115.3654 + 13.0649929509 * d);
-  const double e = 0.054900;
+  T N = sm_revt<T>(125.1228 - 0.0529538083  * d);
+  T w = sm_revt<T>(318.0634 + 0.1643573223  * d);
+  T M = sm_revt<T>(115.3654 + 13.0649929509 * d);
+  const T e = T(0.054900);
 
   // Eccentric anomaly via Newton-Raphson on Kepler's equation
-  double E = M + (180.0 / M_PI) * e * sin(M * toR) * (1.0 + e * cos(M * toR));
+  T E = M + toD * e * std::sin(M * toR) * (1 + e * std::cos(M * toR));
   for (int k = 0; k < 5; k++) {
-    double Er = E * toR;
-    E = E - (E - (180.0 / M_PI) * e * sin(Er) - M) / (1.0 - e * cos(Er));
+    T Er = E * toR;
+    E = E - (E - toD * e * std::sin(Er) - M) / (1 - e * std::cos(Er));
   }
 
-  double xv = cos(E * toR) - e;
-  double yv = sqrt(1.0 - e * e) * sin(E * toR);
-  double v   = sm_rev(atan2(yv, xv) * (180.0 / M_PI));
-  double r   = sqrt(xv * xv + yv * yv);
+  T xv = std::cos(E * toR) - e;
+  T yv = std::sqrt(1 - e * e) * std::sin(E * toR);
+  T v  = std::atan2(yv, xv) * toD;
+  T r  = std::sqrt(xv * xv + yv * yv);
 
-  const double i_r = 5.1454 * toR;
-  double N_r  = N * toR;
-  double vw_r = (v + w) * toR;
+  const T i_r = T(5.1454) * toR;
+  T N_r  = N * toR;
+  T vw_r = (v + w) * toR;
 
-  double xh = r * (cos(N_r) * cos(vw_r) - sin(N_r) * sin(vw_r) * cos(i_r));
-  double yh = r * (sin(N_r) * cos(vw_r) + cos(N_r) * sin(vw_r) * cos(i_r));
-  double zh = r * sin(vw_r) * sin(i_r);
+  T xh = r * (std::cos(N_r) * std::cos(vw_r) - std::sin(N_r) * std::sin(vw_r) * std::cos(i_r));
+  T yh = r * (std::sin(N_r) * std::cos(vw_r) + std::cos(N_r) * std::sin(vw_r) * std::cos(i_r));
+  T zh = r * std::sin(vw_r) * std::sin(i_r);
 
-  lon = sm_rev(atan2(yh, xh) * (180.0 / M_PI));
-  lat = atan2(zh, sqrt(xh * xh + yh * yh)) * (180.0 / M_PI);
+  lon = std::atan2(yh, xh) * toD;
+  lat = std::atan2(zh, std::sqrt(xh * xh + yh * yh)) * toD;
 
   // Perturbations (Paul Schlyter)
-  double Ls = sm_rev(639.387  + 0.9856473678 * d);  // Sun mean longitude
-  double Lm = sm_rev(N + w + M);                     // Moon mean longitude
-  double Ms = sm_rev(356.0470 + 0.9856002585 * d);  // Sun mean anomaly
-  double D  = sm_rev(Lm - Ls);
-  double F  = sm_rev(Lm - N);
-
-  lon += -1.274 * sin((M  - 2*D) * toR)
-         +0.658 * sin((2*D)      * toR)
-         -0.186 * sin( Ms        * toR)
-         -0.059 * sin((2*M - 2*D)* toR)
-         -0.057 * sin((M - 2*D + Ms) * toR)
-         +0.053 * sin((M + 2*D)  * toR)
-         +0.046 * sin((2*D - Ms) * toR)
-         +0.041 * sin((M - Ms)   * toR)
-         -0.035 * sin( D         * toR)
-         -0.031 * sin((M + Ms)   * toR)
-         -0.015 * sin((2*F - 2*D)* toR)
-         +0.011 * sin((M - 4*D)  * toR);
-
-  lat += -0.173 * sin((F - 2*D)      * toR)
-         -0.055 * sin((M - F - 2*D)  * toR)
-         -0.046 * sin((M + F - 2*D)  * toR)
-         +0.033 * sin((F + 2*D)      * toR)
-         +0.017 * sin((2*M + F)      * toR);
-}
-
-// Moon altitude above horizon (degrees)
+  T Ls = sm_revt<T>(639.387  + 0.9856473678 * d);  // Sun mean longitude
+  T Ms = sm_revt<T>(356.0470 + 0.9856002585 * d);  // Sun mean anomaly
+  T Lm = N + w + M;                                 // Moon mean longitude
+  T D  = Lm - Ls;
+  T F  = Lm - N;
+
+  lon += T(-1.274) * std::sin((M  - 2*D) * toR)
+         +T(0.658) * std::sin((2*D)      * toR)
+         -T(0.186) * std::sin( Ms        * toR)
+         -T(0.059) * std::sin((2*M - 2*D)* toR)
+         -T(0.057) * std::sin((M - 2*D + Ms) * toR)
+         +T(0.053) * std::sin((M + 2*D)  * toR)
+         +T(0.046) * std::sin((2*D - Ms) * toR)
+         +T(0.041) * std::sin((M - Ms)   * toR)
+         -T(0.035) * std::sin( D         * toR)
+         -T(0.031) * std::sin((M + Ms)   * toR)
+         -T(0.015) * std::sin((2*F - 2*D)* toR)
+         +T(0.011) * std::sin((M - 4*D)  * toR);
+  lon = lon - 360 * std::floor(lon / 360);
+
+  lat += T(-0.173) * std::sin((F - 2*D)      * toR)
+         -T(0.055) * std::sin((M - F - 2*D)  * toR)
+         -T(0.046) * std::sin((M + F - 2*D)  * toR)
+         +T(0.033) * std::sin((F + 2*D)      * toR)
+         +T(0.017) * std::sin((2*M + F)      * toR);
+
+  if (dist) *dist = T(60.2666) * r - T(0.58) * std::cos((M - 2*D) * toR) - T(0.46) * std::cos(2*D * toR);
+}
+
+// Moon geocentric right ascension & declination (degrees) at d days since
+// J2000. parallax (optional) = horizontal parallax in degrees
+template <typename T>
+static void sm_moon_radec(double d, T &ra, T &dec, T *parallax = nullptr) {
+  const T toR = (T)(M_PI / 180.0), toD = (T)(180.0 / M_PI);
+  T elon, elat, dist;
+  sm_moon_ecl<T>(d, elon, elat, &dist);
+  if (parallax) *parallax = std::asin(1 / dist) * toD;
+
+  T obl    = T(23.4393 - 3.563e-7 * d) * toR;
+  T elon_r = elon * toR, elat_r = elat * toR;
+
+  T xe = std::cos(elat_r) * std::cos(elon_r);
+  T ye = std::cos(obl) * std::cos(elat_r) * std::sin(elon_r) - std::sin(obl) * std::sin(elat_r);
+  T ze = std::sin(obl) * std::cos(elat_r) * std::sin(elon_r) + std::cos(obl) * std::sin(elat_r);
+
+  ra  = std::atan2(ye, xe) * toD;
+  dec = std::atan2(ze, std::sqrt(xe * xe + ye * ye)) * toD;
+}
+
+// Local sidereal time (degrees). GMST gains 361° a day: reduce in double,
+// including the observer's longitude
+template <typename T>
+static T sm_lst(double d, double lon_deg) {
+  return sm_revt<T>(280.46061837 + 360.98564736629 * d + lon_deg);
+}
+
+// Moon altitude above horizon (degrees, geocentric)
 // d = days since J2000, lat_deg = observer lat (N+), lon_deg = observer lon (E+, so W is negative)
-static double sm_moon_alt(double d, double lat_deg, double lon_deg) {
-  double elon, elat;
-  sm_moon_ecl(d, elon, elat);
+// parallax (optional) = horizontal parallax in degrees
+template <typename T>
+static T sm_moon_alt(double d, double lat_deg, double lon_deg, T *parallax = nullptr) {
+  const T toR = (T)(M_PI / 180.0), toD = (T)(180.0 / M_PI);
+  T ra, dec;
+  sm_moon_radec<T>(d, ra, dec, parallax);
+
+  T HA   = (sm_lst<T>(d, lon_deg) - ra) * toR;
+  T la_r = (T)lat_deg * toR, de_r = dec * toR;
+  return std::asin(std::sin(la_r) * std::sin(de_r) + std::cos(la_r) * std::cos(de_r) * std::cos(HA)) * toD;
+}
 
-  const double toR = M_PI / 180.0;
-  double obl   = (23.4393 - 3.563e-7 * d) * toR;
-  double elon_r = elon * toR, elat_r = elat * toR;
+// Sun right ascension & declination (degrees) at d days since J2000, from the
+// NOAA declination and equation of time: the sun's Greenwich hour angle is
+// true solar time − 180°, and RA = GMST − GHA
+template <typename T>
+static void sm_sun_radec(double d, T &ra, T &dec) {
+  T eqtime;
+  sm_sun_params<T>(d + 2451545.0, dec, eqtime);
+  double utc_min = (d + 0.5 - floor(d + 0.5)) * 1440.0;
+  ra = sm_revt<T>(280.46061837 + 360.98564736629 * d - ((utc_min + (double)eqtime) / 4.0 - 180.0));
+}
 
-  double xe = cos(elat_r) * cos(elon_r);
-  double ye = cos(obl) * cos(elat_r) * sin(elon_r) - sin(obl) * sin(elat_r);
-  double ze = sin(obl) * cos(elat_r) * sin(elon_r) + cos(obl) * sin(elat_r);
+// Apparent altitude and azimuth (degrees, azimuth from north through east)
+// of a body at ra/dec for an observer at lat with local sidereal time lst.
+// Parallax par (degrees, moon only) is taken off, then refraction (Bennett)
+// added, both only near and above the horizon where they matter.
+template <typename T>
+static void sm_altaz(T ra, T dec, T lst, T lat, T par, T &alt, T &az) {
+  const T toR = (T)(M_PI / 180.0), toD = (T)(180.0 / M_PI);
+  T H = (lst - ra) * toR, de = dec * toR, la = lat * toR;
+  T sd = std::sin(de), cd = std::cos(de), sl = std::sin(la), cl = std::cos(la), ch = std::cos(H);
+  alt = std::asin(sl * sd + cl * cd * ch) * toD;
+  az  = std::atan2(std::sin(H) * cd, ch * cd * sl - sd * cl) * toD + 180;
+  alt -= par * std::cos(alt * toR);
+  if (alt > -2) alt += 1 / (60 * std::tan((alt + T(7.31) / (alt + T(4.4))) * toR));
+}
 
-  double ra  = sm_rev(atan2(ye, xe) * (180.0 / M_PI));
-  double dec = atan2(ze, sqrt(xe * xe + ye * ye)) * (180.0 / M_PI);
+// Height of the moon's upper limb above the apparent horizon (degrees). The
+// geocentric altitude at rise/set is h0 = 0.7275·π − 0.5667° (Meeus ch. 15):
+// parallax π lowers the moon, the semi-diameter (0.2725·π) and 34' of
+// refraction lift it.
+static uint32_t sm_moon_evals = 0;   // sm_moon_alt calls made by the last rise/set search
+
+static double sm_moon_horizon(double d, double lat, double lon) {
+  sm_real par;
+  sm_real alt = sm_moon_alt<sm_real>(d, lat, lon, &par);
+  sm_moon_evals++;
+  return alt - (sm_real(0.7275) * par - sm_real(0.5667));
+}
 
-  double GMST = sm_rev(280.46061837 + 360.98564736629 * d);
-  double LST  = sm_rev(GMST + lon_deg);
-  double HA   = sm_rev(LST - ra) * toR;
+// Brent's method: root of sm_moon_horizon in [a, b] (days), whose ends have
+// opposite signs fa / fb, to within tol days
+static double sm_moon_brent(double a, double b, double fa, double fb, double lat, double lon,
+                            double tol) {
+  double c = a, fc = fa, e = b - a, dd = e;
+  for (int iter = 0; iter < 40; iter++) {
+    if ((fb > 0) == (fc > 0)) { c = a; fc = fa; e = dd = b - a; }
+    if (fabs(fc) < fabs(fb)) { a = b; b = c; c = a; fa = fb; fb = fc; fc = fa; }
+    double tol1 = 2.0 * 1e-12 * fabs(b) + 0.5 * tol;
+    double xm   = 0.5 * (c - b);
+    if (fabs(xm) <= tol1 || fb == 0.0) return b;
+    if (fabs(e) >= tol1 && fabs(fa) > fabs(fb)) {
+      // Secant (two points) or inverse quadratic interpolation (three)
+      double s = fb / fa, p, q;
+      if (a == c) {
+        p = 2.0 * xm * s;
+        q = 1.0 - s;
+      } else {
+        double qq = fa / fc, r = fb / fc;
+        p = s * (2.0 * xm * qq * (qq - r) - (b - a) * (r - 1.0));
+        q = (qq - 1.0) * (r - 1.0) * (s - 1.0);
+      }
+      if (p > 0) q = -q;
+      p = fabs(p);
+      if (2.0 * p < fmin(3.0 * xm * q - fabs(tol1 * q), fabs(e * q))) {
+        e  = dd;
+        dd = p / q;
+      } else {
+        dd = xm; e = dd;   // interpolation would leave the bracket: bisect
+      }
+    } else {
+      dd = xm; e = dd;
+    }
+    a  = b;
+    fa = fb;
+    b += fabs(dd) > tol1 ? dd : (xm > 0 ? tol1 : -tol1);
+    fb = sm_moon_horizon(b, lat, lon);
+  }
+  return b;
+}
 
-  double la_r = lat_deg * toR, de_r = dec * toR;
-  return asin(sin(la_r) * sin(de_r) + cos(la_r) * cos(de_r) * cos(HA)) * (180.0 / M_PI);
+// Record a horizon crossing in [a, b] (days) as rise or set, in minutes after d0
+static void sm_moon_cross(double a, double b, double fa, double fb, double d0,
+                          double lat, double lon, double &rise, double &set) {
+  double t = (sm_moon_brent(a, b, fa, fb, lat, lon, 0.1 / 1440.0) - d0) * 1440.0;
+  if (fa < 0.0) { if (rise < 0) rise = t; }
+  else          { if (set  < 0) set  = t; }
 }
 
-// Scan the given UTC day in 30-min steps to find moonrise and moonset.
-// Returns -1,-1 when the moon does not rise or set that day (rare at mid-latitudes).
+// Moonrise and moonset on the given UTC day, in minutes after midnight, or
+// -1 when the moon does not rise / set that day. Nine samples 3 h apart
+// bracket the horizon crossings and Brent's method refines each to a few
+// seconds. A parabola through neighbouring samples catches the short dips and
+// peaks of a grazing moon at high latitude, which can rise and set again
+// between two samples.
 static void sm_moon_riseset(int yr, int mo, int dy, double lat, double lon,
-                            int &rise_h, int &rise_m, int &set_h, int &set_m) {
-  rise_h = rise_m = set_h = set_m = -1;
-  const double step = 0.5 / 24.0;
-  double d0   = sm_d2k(yr, mo, dy, 0.0);
-  double prev = sm_moon_alt(d0, lat, lon);
-
-  for (int s = 1; s <= 48; s++) {
-    double cur = sm_moon_alt(d0 + s * step, lat, lon);
-
-    if (prev < 0.0 && cur >= 0.0 && rise_h < 0) {
-      double t = (s - 1.0 + (-prev / (cur - prev))) * step * 24.0;
-      rise_h = (int)t;
-      rise_m = (int)round((t - rise_h) * 60.0);
-      if (rise_m >= 60) { rise_h++; rise_m = 0; }
-    }
-    if (prev >= 0.0 && cur < 0.0 && set_h < 0) {
-      double t = (s - 1.0 + (prev / (prev - cur))) * step * 24.0;
-      set_h = (int)t;
-      set_m = (int)round((t - set_h) * 60.0);
-      if (set_m >= 60) { set_h++; set_m = 0; }
+                            double &rise, double &set) {
+  rise = set = -1.0;
+  const int    N    = 8;
+  const double step = 3.0 / 24.0;
+  double d0 = sm_d2k(yr, mo, dy, 0.0);
+  double f[N + 1];
+  for (int i = 0; i <= N; i++) f[i] = sm_moon_horizon(d0 + i * step, lat, lon);
+
+  for (int i = 0; i < N; i++) {
+    double a = d0 + i * step, b = a + step;
+    if ((f[i] < 0.0) != (f[i + 1] < 0.0)) {
+      sm_moon_cross(a, b, f[i], f[i + 1], d0, lat, lon, rise, set);
+      continue;
     }
-    prev = cur;
-    if (rise_h >= 0 && set_h >= 0) break;
+    // No sign change: look for an extremum inside this interval that reaches
+    // the other side of the horizon
+    int    j  = (i == 0) ? 0 : i - 1;                 // parabola through j, j+1, j+2
+    double y0 = f[j], y1 = f[j + 1], y2 = f[j + 2];
+    double A  = 0.5 * (y0 + y2) - y1;
+    if (A == 0.0) continue;
+    double xv = j + 1 + 0.25 * (y0 - y2) / A;         // vertex, in sample units
+    if (xv <= i || xv >= i + 1) continue;
+    double yv = y1 - (y2 - y0) * (y2 - y0) / (16.0 * A);
+    if ((yv < 0.0) == (f[i] < 0.0) && fabs(yv) > 0.5) continue;
+    double m  = d0 + xv * step;
+    double fm = sm_moon_horizon(m, lat, lon);
+    if ((fm < 0.0) == (f[i] < 0.0)) continue;
+    sm_moon_cross(a, m, f[i], fm, d0, lat, lon, rise, set);
+    sm_moon_cross(m, b, fm, f[i + 1], d0, lat, lon, rise, set);
   }
 }
 
@@ -210,47 +377,237 @@ static void sm_moon_riseset(int yr, int mo, int dy, double lat, double lon,
 //   Waxing (p<0.5): right side is lit → pixel lit if dx > terminator
 //   Waning (p≥0.5): left side is lit  → pixel lit if dx < −terminator
 //
-static void sm_draw_moon(int cx, int cy, int R, double age) {
-  double p    = age / 29.53058853;
-  double c2p  = cos(2.0 * M_PI * p);
-  bool waxing = (p < 0.5);
+// The half-chords come from a table built once per radius, so a row costs one
+// float multiply instead of a sqrt. The whole (2R+1)² square, outline
+// included, is rasterised into RAM and sent in one address-window burst
+// instead of ~150 short drawFastHLine transactions plus the pixel-by-pixel
+// drawCircle.
+#define SM_MOON_MAX_R 63
+#define SM_MOON_DARK  0x1082
+
+static sm_real sm_chord[SM_MOON_MAX_R + 1];   // sqrt(R² − dy²)
+static int     sm_chord_r = -1;
+
+static void sm_moon_chords(int R) {
+  if (R == sm_chord_r) return;
+  for (int dy = 0; dy <= R; dy++)
+    sm_chord[dy] = std::sqrt((sm_real)(R * R - dy * dy));
+  sm_chord_r = R;
+}
+
+// Half-chord rx of row dy and its lit span [from, to] (empty if from > to).
+// c2p = cos(2πp). Needs sm_moon_chords(R) first.
+static int sm_moon_lit(int dy, sm_real c2p, bool waxing, int &from, int &to) {
+  sm_real rxf  = sm_chord[dy < 0 ? -dy : dy];
+  int     rx   = (int)rxf;
+  sm_real term = c2p * rxf;              // terminator
+  if (waxing) {                          // lit if dx > term
+    from = (int)std::floor(term) + 1;
+    to   = rx;
+  } else {                               // lit if dx < −term → up to ceil(−term) − 1
+    from = -rx;
+    to   = (int)std::floor(-term - sm_real(1e-6));
+  }
+  return rx;
+}
 
+// One row of the disc: background, dark chord, lit part
+static void sm_moon_row(uint16_t *row, int R, int dy, sm_real c2p, bool waxing) {
+  const int W = 2 * R + 1;
+  for (int i = 0; i < W; i++) row[i] = RGB565_BLACK;
+  int from, to;
+  int rx = sm_moon_lit(dy, c2p, waxing, from, to);
+  if (rx == 0) return;
+
+  uint16_t *c = row + R;                 // c[dx], dx = −rx…rx
+  for (int dx = -rx; dx <= rx; dx++) c[dx] = SM_MOON_DARK;
+  for (int dx = from; dx <= to; dx++) c[dx] = RGB565_WHITE;
+}
+
+// Hash of the lit spans, for the screen model: the picture only changes when
+// some row's terminator moves by a pixel
+static uint32_t sm_moon_hash(int R, double age) {
+  if (R > SM_MOON_MAX_R) R = SM_MOON_MAX_R;
+  sm_moon_chords(R);
+  sm_real p   = (sm_real)(age / 29.53058853);
+  sm_real c2p = std::cos(sm_real(2.0 * M_PI) * p);
+  bool waxing = (p < sm_real(0.5));
+  uint32_t h = scrHash(&R, sizeof(R));
   for (int dy = -R; dy <= R; dy++) {
-    int   rx2 = R * R - dy * dy;
-    if (rx2 < 0) continue;
-    double rxf = sqrt((double)rx2);
-    int    rx  = (int)rxf;
-    if (rx == 0) continue;
-
-    // Paint the full chord dark first
-    gfx->drawFastHLine(cx - rx, cy + dy, 2 * rx + 1, 0x1082);
-
-    // Terminator x-position for this row
-    double term = c2p * rxf;
-
-    // Calculate lit pixel range using floor() for correct rounding toward −∞
-    int lit_x0, lit_w;
-    if (waxing) {
-      // lit if dx > term → first lit dx = floor(term) + 1
-      int x0 = (int)floor(term) + 1;
-      if (x0 > rx) continue;
-      lit_x0 = cx + x0;
-      lit_w  = rx - x0 + 1;
+    int span[2];
+    sm_moon_lit(dy, c2p, waxing, span[0], span[1]);
+    h = scrHash(span, sizeof(span), h);
+  }
+  return h;
+}
+
+// Outline, same midpoint walk as gfx->drawCircle, into a (2R+1)² buffer
+static void sm_moon_outline(uint16_t *buf, int R) {
+  const int W = 2 * R + 1;
+  auto px = [&](int x, int y) { buf[(R + y) * W + R + x] = RGB565_WHITE; };
+  int f = 1 - R, ddx = 1, ddy = -2 * R, x = 0, y = R;
+  px(0, R); px(0, -R); px(R, 0); px(-R, 0);
+  while (x < y) {
+    if (f >= 0) { y--; ddy += 2; f += ddy; }
+    x++; ddx += 2; f += ddx;
+    px( x,  y); px(-x,  y); px( x, -y); px(-x, -y);
+    px( y,  x); px(-y,  x); px( y, -x); px(-y, -x);
+  }
+}
+
+static void sm_draw_moon(int cx, int cy, int R, double age) {
+  if (R > SM_MOON_MAX_R) R = SM_MOON_MAX_R;
+  sm_moon_chords(R);
+  sm_real p   = (sm_real)(age / 29.53058853);
+  sm_real c2p = std::cos(sm_real(2.0 * M_PI) * p);
+  bool waxing = (p < sm_real(0.5));
+  const int W = 2 * R + 1;
+
+  uint16_t *buf = (uint16_t *)malloc(W * W * sizeof(uint16_t));
+  if (!buf) {
+    // Low on heap: one row burst at a time, then the library outline
+    uint16_t row[2 * SM_MOON_MAX_R + 1];
+    for (int dy = -R; dy <= R; dy++) {
+      sm_moon_row(row, R, dy, c2p, waxing);
+      gfx->draw16bitRGBBitmap(cx - R, cy + dy, row, W, 1);
+    }
+    gfx->drawCircle(cx, cy, R, RGB565_WHITE);
+    return;
+  }
+  for (int dy = -R; dy <= R; dy++)
+    sm_moon_row(buf + (dy + R) * W, R, dy, c2p, waxing);
+  sm_moon_outline(buf, R);
+  gfx->draw16bitRGBBitmap(cx - R, cy - R, buf, W, W);
+  free(buf);
+}
+
+// ── Live sky position (Chebyshev fits) ────────────────────────────────────────
+// The panel shows sun and moon altitude/azimuth every second. Right ascension
+// and declination change slowly, so the snapshot carries a Chebyshev fit of
+// each over a two-hour window starting at the top of the current hour; a tick
+// is then a few multiply-adds plus one alt/az conversion instead of the full
+// Schlyter series. The snapshot is rebuilt every minute, so the window always
+// covers the next hour; outside it (clock jump) the tick falls back to the
+// full kernels.
+#define SM_CHEB_N     6                 // coefficients per series
+#define SM_CHEB_SPAN  7200              // seconds covered by one fit
+#define SM_TRACK_N    96                // sky-track samples per UTC day (15 min)
+#define SM_TRACK_NONE (-128)            // track sample below the horizon
+#define SM_TICK_MS    1000UL            // live readout refresh
+
+// Sky plot: horizon circle, zenith at the centre, north up
+#define SM_SKY_CX 268
+#define SM_SKY_CY 178
+#define SM_SKY_R  44
+
+enum { SM_SUN, SM_MOON };
+
+static unsigned long sm_tick_us = 0;   // last live tick's alt/az computation
+
+struct SmSky {
+  time_t  t0;                           // window start (UTC)
+  sm_real ra[2][SM_CHEB_N];             // RA, unwrapped from the first node
+  sm_real dec[2][SM_CHEB_N];
+  sm_real moon_par;                     // moon horizontal parallax, window mean
+};
+
+static double sm_unix_d2k(double utc) { return utc / 86400.0 - 10957.5; }
+
+// Clenshaw sum of c[0]/2 + Σ c[j]·T_j(x), x in [−1, 1]
+static sm_real sm_cheb_eval(const sm_real *c, sm_real x) {
+  sm_real b1 = 0, b2 = 0;
+  for (int j = SM_CHEB_N - 1; j >= 1; j--) {
+    sm_real b0 = 2 * x * b1 - b2 + c[j];
+    b2 = b1;
+    b1 = b0;
+  }
+  return x * b1 - b2 + c[0] / 2;
+}
+
+// RA/Dec (and moon parallax) of one body at unix time utc, straight from the kernels
+static void sm_body_radec(int body, double utc, sm_real &ra, sm_real &dec, sm_real *par) {
+  double d = sm_unix_d2k(utc);
+  if (body == SM_SUN) { sm_sun_radec<sm_real>(d, ra, dec); if (par) *par = 0; }
+  else                sm_moon_radec<sm_real>(d, ra, dec, par);
+}
+
+// Fit both bodies over [t0, t0 + SM_CHEB_SPAN]
+static void sm_sky_fit(SmSky *s, time_t t0) {
+  const int N = SM_CHEB_N;
+  s->t0 = t0;
+  s->moon_par = 0;
+  for (int b = SM_SUN; b <= SM_MOON; b++) {
+    sm_real fra[N], fdec[N];
+    for (int k = 0; k < N; k++) {
+      double x = cos(M_PI * (k + 0.5) / N);
+      sm_real par;
+      sm_body_radec(b, t0 + (x + 1.0) * 0.5 * SM_CHEB_SPAN, fra[k], fdec[k], &par);
+      if (k && fra[k] - fra[0] >  180) fra[k] -= 360;   // keep RA continuous
+      if (k && fra[k] - fra[0] < -180) fra[k] += 360;
+      if (b == SM_MOON) s->moon_par += par / N;
+    }
+    for (int j = 0; j < N; j++) {
+      sm_real a = 0, c = 0;
+      for (int k = 0; k < N; k++) {
+        sm_real w = (sm_real)cos(M_PI * j * (k + 0.5) / N);
+        a += fra[k] * w;
+        c += fdec[k] * w;
+      }
+      s->ra[b][j]  = a * 2 / N;
+      s->dec[b][j] = c * 2 / N;
+    }
+  }
+}
+
+// Apparent alt/az of both bodies at unix time utc. Returns true if the fit
+// was used, false if it fell back to the kernels.
+static bool sm_sky_altaz(const SmSky *s, double lat, double lon, double utc,
+                         sm_real alt[2], sm_real az[2]) {
+  sm_real lst = sm_lst<sm_real>(sm_unix_d2k(utc), lon);
+  double  u   = (utc - s->t0) / SM_CHEB_SPAN;
+  bool    fit = u >= 0.0 && u <= 1.0;
+  for (int b = SM_SUN; b <= SM_MOON; b++) {
+    sm_real ra, dec, par = 0;
+    if (fit) {
+      sm_real x = (sm_real)(2.0 * u - 1.0);
+      ra  = sm_cheb_eval(s->ra[b], x);
+      dec = sm_cheb_eval(s->dec[b], x);
+      if (b == SM_MOON) par = s->moon_par;
     } else {
-      // lit if dx < -term → last lit dx = ceil(-term) - 1 = floor(-term - ε)
-      int x1 = (int)floor(-term - 1e-9);
-      if (x1 < -rx) continue;
-      lit_x0 = cx - rx;
-      lit_w  = x1 + rx + 1;
+      sm_body_radec(b, utc, ra, dec, &par);
     }
-    if (lit_w > 0) gfx->drawFastHLine(lit_x0, cy + dy, lit_w, RGB565_WHITE);
+    sm_altaz<sm_real>(ra, dec, lst, (sm_real)lat, par, alt[b], az[b]);
   }
+  return fit;
+}
 
-  gfx->drawCircle(cx, cy, R, RGB565_WHITE);
+// Plot offset from the sky-plot centre of a body at alt/az
+static void sm_sky_xy(sm_real alt, sm_real az, int &x, int &y) {
+  const sm_real toR = (sm_real)(M_PI / 180.0);
+  sm_real r = SM_SKY_R * (90 - alt) / 90;
+  x = (int)std::lround(r * std::sin(az * toR));
+  y = (int)std::lround(-r * std::cos(az * toR));
 }
 
-// ── Main entry point ──────────────────────────────────────────────────────────
-bool sunMoonFetchAndDisplay(const char *lat_str, const char *lon_str) {
+// ── Snapshot ──────────────────────────────────────────────────────────────────
+// Formatted rise/set times plus phase, built by the fetch worker, drawn by loop()
+struct SunMoonData {
+  char   sr[8], ss[8], noon[8];   // sunrise / sunset / solar noon "HH:MM" UTC
+  char   cdawn[8], cdusk[8];      // civil twilight (sun 6° down)
+  char   ndawn[8], ndusk[8];      // nautical twilight (12°)
+  char   adawn[8], adusk[8];      // astronomical twilight (18°)
+  char   mr[8], ms[8];            // moonrise / moonset
+  double age;                     // days since new moon
+  double illum;                   // 0–100 %
+  double lat, lon;                // observer the sky positions are for
+  SmSky  sky;                     // RA/Dec fits for the live alt/az readouts
+  int8_t track[2][SM_TRACK_N][2]; // today's sky track per body, plot offsets
+};
+
+// ── Fetch ─────────────────────────────────────────────────────────────────────
+// All local: NOAA solar algorithm for the sun, Schlyter series for the moon.
+// Returns a new snapshot owned by the caller, or nullptr if time is not synced.
+SunMoonData *sunMoonFetch(const char *lat_str, const char *lon_str) {
   float lat = atof(lat_str);
   float lon = atof(lon_str);  // negative = West
 
@@ -258,125 +615,195 @@ bool sunMoonFetchAndDisplay(const char *lat_str, const char *lon_str) {
   struct tm ti;
   if (!getLocalTime(&ti)) {
     Serial.println("[SunMoon] NTP time not available");
-    return false;
+    return nullptr;
   }
   int year  = ti.tm_year + 1900;
   int month = ti.tm_mon  + 1;
   int mday  = ti.tm_mday;
 
-  // ── Sunrise/Sunset from sunrise-sunset.org ────────────────────────────────
-  char sunUrl[128];
-  snprintf(sunUrl, sizeof(sunUrl),
-    "https://api.sunrise-sunset.org/json?lat=%.4f&lng=%.4f&date=today&formatted=0",
-    lat, lon);
-  String sunBody = sm_https_get(sunUrl);
-
-  int sr_h = -1, sr_m = -1, ss_h = -1, ss_m = -1, noon_h = -1, noon_m = -1;
-  if (!sunBody.isEmpty()) {
-    StaticJsonDocument<128> filter;
-    filter["results"]["sunrise"]    = true;
-    filter["results"]["sunset"]     = true;
-    filter["results"]["solar_noon"] = true;
-    StaticJsonDocument<512> doc;
-    if (!deserializeJson(doc, sunBody, DeserializationOption::Filter(filter))) {
-      sm_parse_iso(doc["results"]["sunrise"]    | "", sr_h,   sr_m);
-      sm_parse_iso(doc["results"]["sunset"]     | "", ss_h,   ss_m);
-      sm_parse_iso(doc["results"]["solar_noon"] | "", noon_h, noon_m);
-    }
+  // ── Sun: rise / set / noon and the three twilights ───────────────────────
+  SunMoonData *d = new SunMoonData;
+  unsigned long t0 = micros();
+  const struct { char *dawn, *dusk; double zenith; } sunEvents[] = {
+    { d->sr,    d->ss,    SM_ZENITH_RISESET  },
+    { d->cdawn, d->cdusk, SM_ZENITH_CIVIL    },
+    { d->ndawn, d->ndusk, SM_ZENITH_NAUTICAL },
+    { d->adawn, d->adusk, SM_ZENITH_ASTRO    },
+  };
+  for (const auto &ev : sunEvents) {
+    sm_fmt_min(ev.dawn, sm_sun_event(year, month, mday, lat, lon, ev.zenith, -1));
+    sm_fmt_min(ev.dusk, sm_sun_event(year, month, mday, lat, lon, ev.zenith, +1));
   }
+  sm_fmt_min(d->noon, sm_sun_event(year, month, mday, lat, lon, 0.0, 0));
+  unsigned long sun_us = micros() - t0;
 
   // ── Moon phase ────────────────────────────────────────────────────────────
   double jd    = sm_jd(year, month, mday, (double)ti.tm_hour + ti.tm_min / 60.0);
   double age   = sm_moon_age(jd);
   double illum = 50.0 * (1.0 - cos(age / 29.53058853 * 2.0 * M_PI));  // 0–100%
 
-  // ── Moonrise/Moonset (local calculation, ~30 trig calls × 48 steps) ───────
-  int mr_h = -1, mr_m = -1, ms_h = -1, ms_m = -1;
-  sm_moon_riseset(year, month, mday, (double)lat, (double)lon,
-                  mr_h, mr_m, ms_h, ms_m);
-
-  // ── Format all time strings ───────────────────────────────────────────────
-  char sr_s[8], ss_s[8], noon_s[8], mr_s[8], ms_s[8];
-  sm_fmt(sr_s,   sr_h,   sr_m);
-  sm_fmt(ss_s,   ss_h,   ss_m);
-  sm_fmt(noon_s, noon_h, noon_m);
-  sm_fmt(mr_s,   mr_h,   mr_m);
-  sm_fmt(ms_s,   ms_h,   ms_m);
-
-  // ── Draw ──────────────────────────────────────────────────────────────────
-  gfx->fillRect(0, 20, gfx->width(), gfx->height() - 20, RGB565_BLACK);
+  // ── Moonrise/Moonset (coarse samples + Brent refinement) ──────────────────
+  double mrise, mset;
+  t0 = micros();
+  uint32_t c0 = ESP.getCycleCount();
+  sm_moon_evals = 0;
+  sm_moon_riseset(year, month, mday, (double)lat, (double)lon, mrise, mset);
+  uint32_t moon_cyc = (ESP.getCycleCount() - c0) / (sm_moon_evals ? sm_moon_evals : 1);
+  unsigned long moon_us = micros() - t0;
+  sm_fmt_min(d->mr, mrise);
+  sm_fmt_min(d->ms, mset);
+  d->age   = age;
+  d->illum = illum;
+
+  // ── Live panel: RA/Dec fits for this hour, today's sky tracks ────────────
+  time_t now = time(nullptr);
+  d->lat = lat;
+  d->lon = lon;
+  t0 = micros();
+  sm_sky_fit(&d->sky, now - now % 3600);
+  time_t day0 = now - now % 86400;
+  for (int i = 0; i < SM_TRACK_N; i++) {
+    double  utc = day0 + i * (86400.0 / SM_TRACK_N);
+    sm_real lst = sm_lst<sm_real>(sm_unix_d2k(utc), lon);
+    for (int b = SM_SUN; b <= SM_MOON; b++) {
+      sm_real ra, dec, par, alt, az;
+      int x = SM_TRACK_NONE, y = SM_TRACK_NONE;
+      sm_body_radec(b, utc, ra, dec, &par);
+      sm_altaz<sm_real>(ra, dec, lst, (sm_real)lat, par, alt, az);
+      if (alt >= 0) sm_sky_xy(alt, az, x, y);
+      d->track[b][i][0] = x;
+      d->track[b][i][1] = y;
+    }
+  }
+  unsigned long sky_us = micros() - t0;
+
+  Serial.printf("[SunMoon] SR=%s SS=%s Noon=%s Civil=%s-%s MR=%s MS=%s Phase=%s %.0f%% (sun %lu us, moon %u evals %lu us, %lu cyc/eval %s; fit+track %lu us, tick %lu us)\n",
+    d->sr, d->ss, d->noon, d->cdawn, d->cdusk, d->mr, d->ms, sm_phase_name(age), illum, sun_us, (unsigned)sm_moon_evals, moon_us,
+    (unsigned long)moon_cyc, sizeof(sm_real) == 4 ? "float" : "double", sky_us, sm_tick_us);
+  return d;
+}
+
+// ── Draw ──────────────────────────────────────────────────────────────────────
+// Every label, value and block below is a screen-model widget (Screen.h). The
+// 1 Hz tick redraws the whole screen through the model, so only readouts
+// whose text changed, the sky plot when a body moves to another pixel, and
+// the moon when its terminator moves are actually pushed to the display.
+
+static void sm_draw_sky(const SunMoonData *d, const int dot[2][2]) {
+  const int cx = SM_SKY_CX, cy = SM_SKY_CY, R = SM_SKY_R;
+  gfx->fillRect(cx - R - 4, cy - R - 4, 2 * R + 9, 2 * R + 9, RGB565_BLACK);
+  gfx->drawCircle(cx, cy, R * 2 / 3, 0x2104);   // 30° altitude
+  gfx->drawCircle(cx, cy, R / 3,     0x2104);   // 60°
+  gfx->drawCircle(cx, cy, R,         0x4208);   // horizon
+  gfx->setTextColor(0x4208);
   gfx->setTextSize(1);
+  gfx->setCursor(cx - 2, cy - R + 2);
+  gfx->print("N");
 
-  // ─── SUN section (y 22–57) ────────────────────────────────────────────────
-  gfx->setTextColor(0xFFE0);        // yellow header
-  gfx->setCursor(4, 22);
-  gfx->print("\x0F  SUN");          // note: most CYD fonts lack emoji; use ASCII
+  const uint16_t track_col[2] = { 0x8400, 0x6B4D };   // dim yellow, dim gray
+  for (int b = SM_SUN; b <= SM_MOON; b++)
+    for (int i = 0; i < SM_TRACK_N; i++)
+      if (d->track[b][i][0] != SM_TRACK_NONE)
+        gfx->drawPixel(cx + d->track[b][i][0], cy + d->track[b][i][1], track_col[b]);
 
-  gfx->setTextColor(0x07FF);        // cyan values
-  gfx->setCursor(4, 34);
-  gfx->print("Sunrise  "); gfx->print(sr_s); gfx->print(" UTC");
+  if (dot[SM_MOON][0] != SM_TRACK_NONE) gfx->fillCircle(cx + dot[SM_MOON][0], cy + dot[SM_MOON][1], 2, RGB565_WHITE);
+  if (dot[SM_SUN][0]  != SM_TRACK_NONE) gfx->fillCircle(cx + dot[SM_SUN][0],  cy + dot[SM_SUN][1],  3, 0xFFE0);
+}
 
-  gfx->setCursor(168, 34);
-  gfx->print("Sunset   "); gfx->print(ss_s); gfx->print(" UTC");
+// Live panel: sun and moon alt/az readouts (left) and the sky plot (right)
+// below the twilight rows, brought up to `now`
+static void sm_draw_live(const SunMoonData *d, time_t now) {
+  unsigned long t0 = micros();
+  sm_real alt[2], az[2];
+  sm_sky_altaz(&d->sky, d->lat, d->lon, (double)now, alt, az);
+  sm_tick_us = micros() - t0;
+
+  scrText(34, 140, 1, 0x8410, "  Alt     Az");
+  scrText(4, 152, 1, 0xFFE0, "Sun");
+  scrText(4, 164, 1, 0xFC60, "Moon");
+  for (int b = SM_SUN; b <= SM_MOON; b++) {
+    char val[8];
+    uint16_t col = alt[b] >= 0 ? 0x07FF : 0x8410;
+    snprintf(val, sizeof(val), "%+5.1f", (double)alt[b]);
+    scrText(34, 152 + b * 12, 1, col, val);
+    snprintf(val, sizeof(val), "%5.1f", (double)az[b]);
+    scrText(76, 152 + b * 12, 1, col, val);
+  }
 
-  gfx->setTextColor(0x8410);        // dim gray for secondary row
-  gfx->setCursor(4, 46);
-  gfx->print("Solar Noon  ");
-  gfx->setTextColor(0x07FF);
-  gfx->print(noon_s); gfx->print(" UTC");
+  int dot[2][2];
+  for (int b = SM_SUN; b <= SM_MOON; b++) {
+    dot[b][0] = dot[b][1] = SM_TRACK_NONE;
+    if (alt[b] >= 0) sm_sky_xy(alt[b], az[b], dot[b][0], dot[b][1]);
+  }
+  const int R = SM_SKY_R;
+  if (scrWidget(SM_SKY_CX - R - 4, SM_SKY_CY - R - 4, 2 * R + 9, 2 * R + 9,
+                scrHash(dot, sizeof(dot), scrHash(d->track, sizeof(d->track)))))
+    sm_draw_sky(d, dot);
+}
 
-  gfx->drawFastHLine(0, 57, gfx->width(), 0x2104);
+// Draw the Sun & Moon screen as of `now` (also the 1 Hz tick)
+void sunMoonDraw(const SunMoonData *d, time_t now) {
+  const double age = d->age, illum = d->illum;
+  char buf[40];
 
-  // ─── MOON section (y 60–97) ───────────────────────────────────────────────
-  gfx->setTextColor(0xFC60);        // amber header
-  gfx->setCursor(4, 60);
-  gfx->print("\x0E  MOON");
+  // ─── SUN section (y 22–57) ────────────────────────────────────────────────
+  scrText(4, 22, 1, 0xFFE0, "\x0F  SUN");   // yellow header; most CYD fonts lack emoji
 
-  gfx->setTextColor(0x07FF);
-  gfx->setCursor(4, 72);
-  gfx->print("Moonrise "); gfx->print(mr_s); gfx->print(" UTC");
+  snprintf(buf, sizeof(buf), "Sunrise  %s UTC", d->sr);
+  scrText(4, 34, 1, 0x07FF, buf);           // cyan values
+  snprintf(buf, sizeof(buf), "Sunset   %s UTC", d->ss);
+  scrText(168, 34, 1, 0x07FF, buf);
 
-  gfx->setCursor(165, 72);
-  gfx->print("Moonset  "); gfx->print(ms_s); gfx->print(" UTC");
+  int x = scrText(4, 46, 1, 0x8410, "Solar Noon  ");   // dim gray for secondary row
+  snprintf(buf, sizeof(buf), "%s UTC", d->noon);
+  scrText(x, 46, 1, 0x07FF, buf);
 
-  // Phase name + illumination + age
-  gfx->setTextColor(0xFFE0);
-  gfx->setCursor(4, 84);
-  gfx->print(sm_phase_name(age));
+  scrRect(0, 57, gfx->width(), 1, 0x2104);
 
-  char illum_buf[12];
-  snprintf(illum_buf, sizeof(illum_buf), "  %.0f%%", illum);
-  gfx->setTextColor(0xC618);        // light gray
-  gfx->print(illum_buf);
-  gfx->print(" lit");
+  // ─── MOON section (y 60–97) ───────────────────────────────────────────────
+  scrText(4, 60, 1, 0xFC60, "\x0E  MOON");  // amber header
 
-  char age_buf[16];
-  snprintf(age_buf, sizeof(age_buf), "  %.1fd", age);
-  gfx->setTextColor(0x8410);
-  gfx->print(age_buf);
+  snprintf(buf, sizeof(buf), "Moonrise %s UTC", d->mr);
+  scrText(4, 72, 1, 0x07FF, buf);
+  snprintf(buf, sizeof(buf), "Moonset  %s UTC", d->ms);
+  scrText(165, 72, 1, 0x07FF, buf);
 
-  gfx->drawFastHLine(0, 96, gfx->width(), 0x2104);
+  // Phase name + illumination + age
+  x = scrText(4, 84, 1, 0xFFE0, sm_phase_name(age));
+  snprintf(buf, sizeof(buf), "  %.0f%% lit", illum);
+  x = scrText(x, 84, 1, 0xC618, buf);       // light gray
+  snprintf(buf, sizeof(buf), "  %.1fd", age);
+  scrText(x, 84, 1, 0x8410, buf);
+
+  scrRect(0, 96, gfx->width(), 1, 0x2104);
+
+  // ─── Twilight (dawn - dusk) ───────────────────────────────────────────────
+  const struct { const char *name, *dawn, *dusk; } twilight[] = {
+    { "Civil",    d->cdawn, d->cdusk },
+    { "Nautical", d->ndawn, d->ndusk },
+    { "Astro",    d->adawn, d->adusk },
+  };
+  for (int i = 0; i < 3; i++) {
+    int y = 100 + i * 11;
+    scrText(4, y, 1, 0x8410, twilight[i].name);
+    snprintf(buf, sizeof(buf), "%s - %s UTC", twilight[i].dawn, twilight[i].dusk);
+    scrText(64, y, 1, 0x07FF, buf);
+  }
 
   // ─── Moon phase circle ────────────────────────────────────────────────────
   const int moon_cx = 160, moon_cy = 172, moon_r = 38;
-  sm_draw_moon(moon_cx, moon_cy, moon_r, age);
+  if (scrWidget(moon_cx - moon_r, moon_cy - moon_r, 2 * moon_r + 1, 2 * moon_r + 1,
+                sm_moon_hash(moon_r, age)))
+    sm_draw_moon(moon_cx, moon_cy, moon_r, age);
 
   // W / E orientation labels so the user knows which side is lit
-  gfx->setTextColor(0x4208);        // very dim — just a hint
-  gfx->setCursor(moon_cx - moon_r - 12, moon_cy - 3);
-  gfx->print("W");
-  gfx->setCursor(moon_cx + moon_r + 4, moon_cy - 3);
-  gfx->print("E");
+  scrText(moon_cx - moon_r - 12, moon_cy - 3, 1, 0x4208, "W");   // very dim — just a hint
+  scrText(moon_cx + moon_r + 4,  moon_cy - 3, 1, 0x4208, "E");
 
   // Phase label centered below circle
   const char *pname = sm_phase_name(age);
-  int label_x = moon_cx - (strlen(pname) * 6) / 2;
-  gfx->setTextColor(0x4208);
-  gfx->setCursor(label_x, moon_cy + moon_r + 5);
-  gfx->print(pname);
-
-  Serial.printf("[SunMoon] SR=%s SS=%s Noon=%s MR=%s MS=%s Phase=%s %.0f%%\n",
-    sr_s, ss_s, noon_s, mr_s, ms_s, sm_phase_name(age), illum);
+  scrText(moon_cx - (strlen(pname) * 6) / 2, moon_cy + moon_r + 5, 1, 0x4208, pname);
 
-  return true;
+  // ─── Live alt/az readouts and sky plot ────────────────────────────────────
+  sm_draw_live(d, now);
 }
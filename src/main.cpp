@@ -17,6 +17,7 @@
 #include "SpaceWeather.h"
 #include "ISSTracker.h"
 #include "SunMoon.h"
+#include "FetchWorker.h"
 #include <SPI.h>
 #include <XPT2046_Touchscreen.h>
 
@@ -30,6 +31,11 @@
 #define FIRMWARE_VERSION "1.0.0"
 #include "CYDIdentity.h"
 #include "Portal.h"
+#include "Prefetch.h"
+#include "Scheduler.h"
+#include "Screen.h"
+#include "PixelPipe.h"
+#include "Resample.h"
 
 #define GFX_BL 21  // CYD backlight pin
 
@@ -45,6 +51,14 @@ Arduino_GFX *gfx = new Arduino_ILI9341(bus, GFX_NOT_DEFINED /* RST */, 1 /* rota
  * End of display setup
  ******************************************************************************/
 
+// The fetch worker (core 0) draws GOES strips while loop() (core 1) draws the
+// UI, so every gfx access holds this recursive mutex. Hold it only briefly.
+static SemaphoreHandle_t gfx_mutex = nullptr;
+struct GfxLock {
+  GfxLock()  { xSemaphoreTakeRecursive(gfx_mutex, portMAX_DELAY); }
+  ~GfxLock() { xSemaphoreGiveRecursive(gfx_mutex); }
+};
+
 // Touch controller (XPT2046 on VSPI, CYD standard wiring)
 #define TOUCH_CS   33
 #define TOUCH_IRQ  36
@@ -53,6 +67,7 @@ XPT2046_Touchscreen ts(TOUCH_CS, TOUCH_IRQ);
 
 // Print a status line on screen (top bar, overwrites previous)
 void showStatus(const char *msg) {
+  GfxLock lock;
   gfx->fillRect(0, 0, gfx->width(), 20, RGB565_BLACK);
   gfx->setTextColor(RGB565_WHITE);
   gfx->setTextSize(1);
@@ -64,7 +79,8 @@ void showStatus(const char *msg) {
 // Draw UTC time in the bottom-right corner (redrawn after decode and every minute)
 void drawTimestamp() {
   struct tm timeinfo;
-  if (!getLocalTime(&timeinfo)) return; // skip if NTP not yet synced
+  if (!getLocalTime(&timeinfo, 10)) return; // skip if NTP not yet synced (never block the UI)
+  GfxLock lock;
   char buf[12];
   strftime(buf, sizeof(buf), "%H:%M UTC", &timeinfo);
   // textSize(1) = 6px wide x 8px tall per character
@@ -78,16 +94,111 @@ void drawTimestamp() {
   gfx->print(buf);
 }
 
-// JPEGDEC pixel draw callback - writes decoded MCU blocks to the ILI9341
+// Job whose image JPEGDraw is currently decoding (set by the fetch worker)
+static const FetchJob *goes_job = nullptr;
+static volatile unsigned long first_pixel_ms = 0;  // first strip drawn since the last mode switch
+
+// Pixel pipeline handler - writes one decoded MCU strip to the ILI9341.
+// Runs on the push task (core 1); returning false aborts the decode once the
+// user has switched away, so a stale image never paints over the new mode.
+static bool goesPushStrip(const PipeStrip &s)
+{
+  GfxLock lock;
+  if (goes_job && fetchIsStale(*goes_job)) return false;
+  if (!first_pixel_ms) first_pixel_ms = millis();
+  gfx->draw16bitBeRGBBitmap(s.x, s.y, s.pixels, s.w, s.h);
+  return true;
+}
+
+// Where the top-left of the decoded area belongs on screen, and the shift
+// from JPEGDEC's strip coordinates to it (fixed on the first strip)
+static int  goes_org_x = 0, goes_org_y = 0;
+static int  goes_dx = 0, goes_dy = 0;
+static bool goes_anchored = false;
+
+// JPEGDEC pixel draw callback. Runs on the fetch worker: hands the strip to
+// the push task and goes back to decoding the next one into the other half
+// of JPEGDEC's buffer (decode is started with JPEG_USES_DMA).
 int JPEGDraw(JPEGDRAW *pDraw)
 {
-  gfx->draw16bitBeRGBBitmap(pDraw->x, pDraw->y, pDraw->pPixels, pDraw->iWidth, pDraw->iHeight);
-  return 1;
+  if (goes_job && fetchIsStale(*goes_job)) return 0;
+  if (rs) return rsStrip(pDraw->x, pDraw->y, pDraw->iWidth, pDraw->iHeight,
+                         pDraw->iWidth, pDraw->pPixels);
+  if (!goes_anchored) {
+    // The first strip is the top-left MCU of the decoded area
+    goes_dx = goes_org_x - pDraw->x;
+    goes_dy = goes_org_y - pDraw->y;
+    goes_anchored = true;
+  }
+  return pipePost(pDraw->x + goes_dx, pDraw->y + goes_dy,
+                  pDraw->iWidth, pDraw->iHeight, pDraw->pPixels);
+}
+
+// Fit-to-screen layout of the opened frame: the cheapest JPEGDEC scale whose
+// output still covers the panel, centred, so the overhang is cropped evenly
+// (or bars are left when even full size is smaller). Sets the decode position
+// and output size and returns the JPEGDEC scale option.
+static int goesLayout(int &x, int &y, int &w, int &h) {
+  static const int scale_opt[] = { 0, JPEG_SCALE_HALF, JPEG_SCALE_QUARTER, JPEG_SCALE_EIGHTH };
+  const int iw = jpeg.getWidth(), ih = jpeg.getHeight();
+  const int sw = gfx->width(), sh = gfx->height();
+  int shift = 0;
+  while (shift < 3 && (iw >> (shift + 1)) >= sw && (ih >> (shift + 1)) >= sh) shift++;
+  w = iw >> shift;
+  h = ih >> shift;
+  x = (sw - w) / 2;
+  y = (sh - h) / 2;
+  if (shift) Serial.printf("[GOES] %dx%d decoded at 1/%d to %dx%d\n",
+                           iw, ih, 1 << shift, iw >> shift, ih >> shift);
+  return scale_opt[shift];
 }
 
+// "Show whole frame" setting: a w x h decode that still overhangs the panel is
+// area-averaged down to fit it, aspect kept and centred (CONUS 416x250 ->
+// 320x192) instead of cropped. False to crop as usual, also when the
+// resampler's ~25 KB of buffers is not available.
+static bool goesShrinkToFit(int w, int h) {
+  const int pw = gfx->width(), ph = gfx->height();
+  if (w <= pw && h <= ph) return false;
+  int dw = pw, dh = h * pw / w;
+  if (dh > ph) {
+    dh = ph;
+    dw = w * ph / h;
+  }
+  return rsBegin(w, h, dw, dh, (pw - dw) / 2, (ph - dh) / 2);
+}
+
+// Oversized frames (CONUS, Full Disk) hang off the screen. Limit JPEGDEC to
+// the MCUs that land on it: the rest is still entropy-decoded (the bitstream
+// has to be walked) but skips IDCT, colour conversion and the push. JPEGDEC
+// rounds the area out to whole MCUs; JPEGDraw places its first MCU where it
+// sits in the uncropped layout, so every pixel on screen stays the same.
+// A scaled decode is already within 2x of the panel and is not cropped.
+static void goesCropToScreen(int x_off, int y_off, int scale) {
+  const int iw = jpeg.getWidth(), ih = jpeg.getHeight();
+  const int x0 = max(0, -x_off), y0 = max(0, -y_off);
+  const int x1 = min(iw, gfx->width() - x_off), y1 = min(ih, gfx->height() - y_off);
+  int cx = 0, cy = 0, cw = iw, ch = ih;
+  if (!scale && x1 > x0 && y1 > y0 && (x0 > 0 || y0 > 0 || x1 < iw || y1 < ih)) {
+    jpeg.setCropArea(x0, y0, x1 - x0, y1 - y0);
+    jpeg.getCropArea(&cx, &cy, &cw, &ch);
+    Serial.printf("[GOES] decoding %dx%d of %dx%d at (%d,%d)\n", cw, ch, iw, ih, cx, cy);
+  }
+  goes_org_x    = x_off + cx;
+  goes_org_y    = y_off + cy;
+  goes_anchored = false;
+}
+
+static void runFetchJob(const FetchJob &job, FetchResult &res);
+static void freeSnapshot(int mode, void *data);
+static void scheduleAll();
+static void drawAlertBanner();
+
 void setup() {
   Serial.begin(115200);
   Serial.println("WeatherCore - NOAA GOES Satellite (CYD)");
+  gfx_mutex = xSemaphoreCreateRecursiveMutex();
+  prefetch_free = freeSnapshot;
 
   // Init display
   if (!gfx->begin()) {
@@ -155,13 +266,47 @@ void setup() {
   // Sync UTC time via NTP — no user config needed
   configTime(0, 0, "pool.ntp.org", "time.nist.gov");
   delay(600);
+  fetchBegin(runFetchJob);
+  pipeBegin(goesPushStrip);
+  scheduleAll();
 }
 
 #define UPDATE_INTERVAL    (5 * 60 * 1000)  // NOAA updates every ~5 min
 #define CLOCK_INTERVAL     (60 * 1000)       // redraw timestamp every minute
-unsigned long last_update    = 0;
+#define WIFI_RETRY_MS      15000             // between WiFi.reconnect() attempts
 unsigned long last_clock     = 0;
 static unsigned long lastTouchMs = 0;
+static int           fetch_running     = -1;   // mode of the scheduled job in flight, -1 = none
+static uint32_t      fetch_running_gen = 0;
+static int           prefetch_running  = -1;   // mode of the prefetch job in flight, -1 = none
+static uint32_t      settings_gen    = 0;      // fetch_gen when location/settings last changed
+static unsigned long wifi_retry_ms   = 0;      // last reconnect attempt, 0 = link up
+static unsigned long loop_worst_us   = 0;      // slowest loop() pass since the last fetch
+static unsigned long iss_tick_ms = 0;          // last 1 Hz ISS readout refresh
+static unsigned long sm_tick_ms  = 0;          // last 1 Hz sun/moon alt/az refresh
+static unsigned long switch_ms  = 0;           // millis() of the last mode switch
+static bool          nav_pending = false;      // time-to-first-pixel not logged yet
+static bool          nav_cached  = false;      // ...and the switch was served from RAM
+static char          alert_banner[40] = "";    // unseen new/upgraded NWS alert, "" = none
+
+// Latest data per mode, refreshed in the background by the scheduler.
+// Text modes keep their parsed snapshot and render straight from it; GOES
+// cameras only record when the frame on screen was fetched.
+struct ModeData {
+  void         *data;
+  unsigned long fetched_ms;   // 0 = never
+};
+static ModeData mode_data[NUM_MODES];
+
+// Per-camera conditional-GET state. NOAA only publishes a new frame every
+// 5-10 min, so most refreshes come back 304 and leave the screen as is.
+struct CameraCache {
+  PoolValidator validator;  // ETag / Last-Modified of the frame on screen
+  uint32_t      hits;       // 304 Not Modified — nothing downloaded or decoded
+  uint32_t      misses;     // 200 — new frame downloaded and decoded
+};
+static CameraCache camera_cache[NUM_CAMERAS];
+static volatile int goes_on_screen = -1;  // camera whose image is currently displayed
 
 // Display the current mode name in the status bar
 static void showModeStatus() {
@@ -177,7 +322,450 @@ static void showModeStatus() {
   }
 }
 
+// Refresh cadence while the mode is on screen
+static unsigned long modeInterval(int mode) {
+  if      (mode == NWS_ALERTS_MODE)    return NWS_ALERTS_INTERVAL;
+  else if (mode == NWS_FORECAST_MODE)  return NWS_UPDATE_INTERVAL;
+  else if (mode == SPACE_WEATHER_MODE) return SW_UPDATE_INTERVAL;
+  else if (mode == ISS_MODE)           return ISS_TLE_INTERVAL;
+  else if (mode == SUN_MOON_MODE)      return SUN_MOON_INTERVAL;
+  else                                 return UPDATE_INTERVAL;
+}
+
+// Refresh cadence while the mode is off screen (0 = not refreshed)
+static unsigned long bgInterval(int mode) {
+  if (mode < NUM_CAMERAS) return 0;    // neighbours are prefetched instead
+  return modeInterval(mode);
+}
+
+// Sources that can run with WiFi down: Sun & Moon is pure computation, and
+// the ISS propagates its NVS-cached element set when CelesTrak is unreachable
+static bool modeNeedsNetwork(int mode) {
+  return mode != SUN_MOON_MODE && mode != ISS_MODE;
+}
+
+static unsigned long nextInterval(int mode) {
+  return mode == wc_camera_idx ? modeInterval(mode) : bgInterval(mode);
+}
+
+// ── Fetch jobs (run on the fetch worker, core 0) ─────────────────────────────
+
+// Decode the image already opened in `jpeg` onto the screen, then close it
+static bool goesDecodeOpened(const FetchJob &job) {
+  const int cam = job.mode;
+  bool ok = false;
+  {
+    GfxLock lock;  // fetch_gen only changes under this lock
+    if (!fetchIsStale(job)) {
+      showStatus("Decoding...");
+      // Clear the full image area before decode to prevent artifacts from
+      // previous images and the NOAA watermark bar at the bottom.
+      gfx->fillRect(0, 20, gfx->width(), gfx->height() - 20, RGB565_BLACK);
+      goes_job = &job;
+    }
+  }
+  if (goes_job) {
+    unsigned long t0 = millis();
+    pipeStart();
+    jpeg.setPixelType(RGB565_BIG_ENDIAN);
+    int x, y, w, h;
+    const int scale = goesLayout(x, y, w, h);
+    const bool shrink = wc_fit_whole && goesShrinkToFit(w, h);
+    if (shrink) {
+      // The resampler works on native pixels and emits big-endian strips
+      jpeg.setPixelType(RGB565_LITTLE_ENDIAN);
+      ok = jpeg.decode(0, 0, scale | JPEG_USES_DMA);
+      ok = rsFinish() && ok;
+    } else {
+      goesCropToScreen(x, y, scale);
+      ok = jpeg.decode(x, y, scale | JPEG_USES_DMA);
+    }
+    ok = pipeFlush() && ok;  // the push task still reads goes_job and the buffer
+    goes_job = nullptr;
+    Serial.printf("[GOES] %s: decode+display %lu ms, %u strips pushed in %u ms, decoder waited %u ms\n",
+                  CAMERAS[cam].name, millis() - t0, (unsigned)pipe_n,
+                  (unsigned)(pipe_busy_us / 1000), (unsigned)(pipe_stall_us / 1000));
+    if (shrink) {
+      Serial.printf("[GOES] %dx%d shrunk to %dx%d, resample %u ms\n",
+                    rs->sw, rs->sh, rs->dw, rs->dh, (unsigned)(rs->us / 1000));
+      rsEnd();
+    }
+  }
+  jpeg.close(); // ends the HTTP request / frees the stream ring
+  return ok;
+}
+
+// GOES image: streamed and decoded straight to the screen by JPEGDraw
+static FetchStatus goesFetchAndDecode(const FetchJob &job) {
+  const int cam = job.mode;
+  CameraCache &cc = camera_cache[cam];
+  // A 304 is only useful if this camera's last frame is still on screen
+  if (goes_on_screen != cam) pool_validator_clear(&cc.validator);
+
+  // Stream the JPEG off the socket straight into JPEGDEC
+  if (!https_open_jpeg_stream(CAMERAS[cam].url, JPEGDraw, &cc.validator)) {
+    if (https_last_http_code != HTTP_CODE_NOT_MODIFIED) return FETCH_FAILED;
+    cc.hits++;  // same frame as on screen: no allocation, no decode, no redraw
+    return FETCH_NOT_MODIFIED;
+  }
+  cc.misses++;
+
+  bool ok = goesDecodeOpened(job);
+  if (!ok) pool_validator_clear(&cc.validator);  // never 304 onto a broken frame
+
+  Serial.printf("[GOES] %s: %u not modified / %u downloaded\n", CAMERAS[cam].name,
+                (unsigned)cc.hits, (unsigned)cc.misses);
+  return ok ? FETCH_DRAWN : FETCH_FAILED;
+}
+
+// GOES image prefetched into RAM: decode it and adopt its validator
+static FetchStatus goesDecodeCached(const FetchJob &job, const HttpsJpeg *img) {
+  if (!jpeg.openRAM(img->buf, img->len, JPEGDraw)) return FETCH_FAILED;
+  if (!goesDecodeOpened(job)) return FETCH_FAILED;
+  camera_cache[job.mode].validator = img->validator;
+  return FETCH_DRAWN;
+}
+
+// Worker entry point: fetch + parse one mode, no drawing except GOES strips
+static void runFetchJob(const FetchJob &job, FetchResult &res) {
+  if (job.mode < NUM_CAMERAS) {
+    if (job.payload) {
+      // res.data keeps the payload so loop() can cache it again
+      res.status = goesDecodeCached(job, (const HttpsJpeg *)job.payload);
+    } else if (job.prefetch) {
+      res.data   = https_get_jpeg_buf(CAMERAS[job.mode].url, job.budget);
+      res.status = res.data ? FETCH_OK : FETCH_FAILED;
+    } else {
+      res.status = goesFetchAndDecode(job);
+    }
+    return;
+  }
+
+  void *d;
+  if      (job.mode == NWS_FORECAST_MODE)  d = nwsFetchForecast(job.lat, job.lon);
+  else if (job.mode == NWS_ALERTS_MODE) {
+    bool unchanged;
+    d = nwsFetchAlerts(job.lat, job.lon, &unchanged);
+    if (unchanged) {
+      res.status = FETCH_NOT_MODIFIED;  // nothing parsed, nothing to draw
+      return;
+    }
+  }
+  else if (job.mode == SPACE_WEATHER_MODE) d = swFetch();
+  else if (job.mode == ISS_MODE)           d = issFetch(job.lat, job.lon);
+  else                                     d = sunMoonFetch(job.lat, job.lon);
+  res.data   = d;
+  res.status = d ? FETCH_OK : FETCH_FAILED;
+}
+
+// ── Snapshots (loop side, core 1) ─────────────────────────────────────────────
+
+static void freeSnapshot(int mode, void *data) {
+  if (!data) return;
+  if      (mode < NUM_CAMERAS)         https_jpeg_free((HttpsJpeg *)data);
+  else if (mode == NWS_FORECAST_MODE)  delete (NwsForecastData *)data;
+  else if (mode == NWS_ALERTS_MODE)    delete (NwsAlertsData *)data;
+  else if (mode == SPACE_WEATHER_MODE) delete (SwData *)data;
+  else if (mode == ISS_MODE)           delete (IssOrbit *)data;
+  else if (mode == SUN_MOON_MODE)      delete (SunMoonData *)data;
+}
+
+// Heap held by a cached GOES image, for the prefetch budget. Only camera
+// snapshots are cached, so it takes the image type rather than any snapshot.
+static uint32_t snapshotBytes(const HttpsJpeg *img) {
+  return img->len + sizeof(HttpsJpeg);
+}
+
+// Log time-to-first-pixel once per mode switch
+static void logFirstPixel(int mode, unsigned long px_ms) {
+  if (!nav_pending) return;
+  nav_pending = false;
+  Serial.printf("[Nav] mode %d first pixel %lu ms after switch (%s)\n",
+                mode, px_ms - switch_ms, nav_cached ? "prefetched" : "cold");
+}
+
+// Propagate the ISS to now and draw it through the screen model (so the 1 Hz
+// tick only repaints the readouts that changed)
+static void drawIss(const IssOrbit *orbit) {
+  IssData d;
+  if (!issCompute(orbit, atof(wc_lat), atof(wc_lon), time(nullptr), &d)) {
+    showStatus("ISS: TLE unusable - waiting for a new one");
+    return;
+  }
+  GfxLock lock;
+  bool full;
+  do {
+    full = scrBegin(ISS_MODE);
+    issDraw(&d, wc_use_metric);
+  } while (!scrEnd());
+  if (!full && scrPaintedTop()) drawAlertBanner();
+  if (full) {
+    Serial.printf("[ISS] Lat=%.2f Lon=%.2f Alt=%.0fkm Dist=%.0fkm Bear=%.0f Elev=%.1f Vis=%s "
+                  "(SGP4 step %u us)\n", d.lat, d.lon, d.alt, d.slant, d.bearing, d.elev, d.vis,
+                  (unsigned)sgp4_last_us);
+  }
+}
+
+// Draw a text mode through the screen model: a mode already on screen only
+// has its changed widgets repainted
+static void drawSnapshot(int mode, const void *data) {
+  if (mode == ISS_MODE) {
+    drawIss((const IssOrbit *)data);
+    return;
+  }
+  GfxLock lock;
+  do {
+    scrBegin(mode);
+    if      (mode == NWS_FORECAST_MODE)  nwsDrawForecast((const NwsForecastData *)data);
+    else if (mode == NWS_ALERTS_MODE)    nwsDrawAlerts((const NwsAlertsData *)data);
+    else if (mode == SPACE_WEATHER_MODE) swDraw((const SwData *)data, wc_lat);
+    else if (mode == SUN_MOON_MODE)      sunMoonDraw((const SunMoonData *)data, time(nullptr));
+  } while (!scrEnd());  // an old widget overlapped a new one: drawn again in full
+}
+
+// Overlay the pending alert banner, if any, on whatever mode is showing
+static void drawAlertBanner() {
+  if (!alert_banner[0] || wc_camera_idx == NWS_ALERTS_MODE) return;
+  GfxLock lock;
+  nwsDrawAlertBanner(alert_banner);
+}
+
+// A fresh alerts snapshot arrived: raise, keep or retire the banner
+static void updateAlertBanner(const NwsAlertsData *d) {
+  if (wc_camera_idx == NWS_ALERTS_MODE) {
+    alert_banner[0] = '\0';  // already on screen in full
+    return;
+  }
+  if (d->banner[0]) {
+    strcpy(alert_banner, d->banner);
+    drawAlertBanner();
+    return;
+  }
+  if (d->count > 0 || !alert_banner[0]) return;
+  // Area is all clear again: take the banner down by repainting the mode
+  alert_banner[0] = '\0';
+  scrInvalidate();
+  const ModeData &md = mode_data[wc_camera_idx];
+  if (wc_camera_idx >= NUM_CAMERAS) {
+    if (md.data) drawSnapshot(wc_camera_idx, md.data);
+  } else {
+    goes_on_screen = -1;  // forces a full download + decode
+    schedAt(wc_camera_idx, millis());
+  }
+}
+
+// Put every text source on the schedule, due now (boot / settings change)
+static void scheduleAll() {
+  schedInit();
+  unsigned long now = millis();
+  if (wc_camera_idx < NUM_CAMERAS) schedAt(wc_camera_idx, now);
+  for (int m = NUM_CAMERAS; m < NUM_MODES; m++) schedAt(m, now);
+}
+
+// Hand mode to the worker as the scheduled job
+static bool postJob(int mode, void *payload) {
+  if (!fetchPost(mode, wc_lat, wc_lon, false, 0, payload)) return false;
+  fetch_running     = mode;
+  fetch_running_gen = fetch_gen;
+  return true;
+}
+
+static void logSchedStats() {
+  char line[160];
+  int n = snprintf(line, sizeof(line), "[Sched] runs/age(s):");
+  unsigned long now = millis();
+  for (int m = 0; m < NUM_MODES && n < (int)sizeof(line); m++) {
+    if (!sched_runs[m]) continue;
+    const ModeData &md = mode_data[m];
+    n += snprintf(line + n, sizeof(line) - n, " %d:%u/%ld", m, (unsigned)sched_runs[m],
+                  md.fetched_ms ? (long)((now - md.fetched_ms) / 1000) : -1L);
+  }
+  Serial.println(line);
+}
+
+// Apply a finished job: store its snapshot, draw it if visible, reschedule
+static void applyResult(FetchResult &res) {
+  if (res.prefetch) {
+    // Neighbour cache fill. Taps that keep its camera in the cache leave it
+    // running, so the user may be looking at that camera by now.
+    prefetch_running = -1;
+    if (res.status != FETCH_OK || res.gen != prefetch_gen) {
+      if (res.status != FETCH_OK && res.gen == prefetch_gen) prefetchFailed(res.mode);  // not a cancel
+      freeSnapshot(res.mode, res.data);
+      if (res.mode == wc_camera_idx && goes_on_screen != res.mode) schedAt(res.mode, millis());
+      return;
+    }
+    if (res.mode == wc_camera_idx && goes_on_screen != res.mode) {
+      // switchMode() waited for this download rather than starting another
+      Serial.printf("[Prefetch] mode %d arrived on screen, decoding\n", res.mode);
+      if (postJob(res.mode, res.data)) return;
+      schedAt(res.mode, millis());
+    }
+    uint32_t bytes = snapshotBytes((const HttpsJpeg *)res.data);
+    Serial.printf("[Prefetch] mode %d cached (%u B)\n", res.mode, (unsigned)bytes);
+    prefetchPut(res.mode, res.data, bytes, millis());
+    return;
+  }
+  if (res.mode == fetch_running && res.gen == fetch_running_gen) fetch_running = -1;
+  const bool visible = (res.mode == wc_camera_idx);
+  const unsigned long now = millis();
+
+  if (res.mode >= NUM_CAMERAS) {
+    // Text source: any fetch made with the current settings is worth keeping
+    if (res.status == FETCH_OK && (int32_t)(res.gen - settings_gen) >= 0) {
+      ModeData &md = mode_data[res.mode];
+      freeSnapshot(res.mode, md.data);
+      md.data       = res.data;
+      md.fetched_ms = now;
+      schedAt(res.mode, now + nextInterval(res.mode));
+      if (visible) {
+        drawSnapshot(res.mode, res.data);
+        logFirstPixel(res.mode, now);
+        goes_on_screen = -1;  // text modes repaint the image area
+        drawAlertBanner();
+        drawTimestamp();
+      }
+      if (res.mode == NWS_ALERTS_MODE) updateAlertBanner((const NwsAlertsData *)res.data);
+      return;
+    }
+    if (res.status == FETCH_NOT_MODIFIED && mode_data[res.mode].data) {
+      // Same data as held: just restart the clock
+      mode_data[res.mode].fetched_ms = now;
+      schedAt(res.mode, now + nextInterval(res.mode));
+      if (visible) drawTimestamp();
+      return;
+    }
+    freeSnapshot(res.mode, res.data);
+    if (res.gen != fetch_gen) {
+      // Cancelled by a mode switch — try again shortly
+      schedNoLaterThan(res.mode, now + SCHED_BG_GAP_MS);
+      return;
+    }
+    schedAt(res.mode, now + 60000);
+    if (!visible) return;
+    if      (res.mode == ISS_MODE)           showStatus("ISS TLE fetch failed - retrying in 60s");
+    else if (res.mode == SPACE_WEATHER_MODE) showStatus("Space weather fetch failed - retrying in 60s");
+    else if (res.mode == SUN_MOON_MODE)      showStatus("Sun/Moon: clock not set - retrying in 60s");
+    else                                     showStatus("NWS fetch failed - retrying in 60s");
+    return;
+  }
+
+  // GOES camera: only meaningful while it is still the one on screen
+  if (res.gen != fetch_gen || !visible) {
+    // A cached image handed back undecoded is still good: re-cache it
+    if (res.data) {
+      const HttpsJpeg *img = (const HttpsJpeg *)res.data;
+      prefetchPut(res.mode, res.data, snapshotBytes(img), img->fetched_ms);
+    }
+    return;
+  }
+  ModeData &md = mode_data[res.mode];
+
+  switch (res.status) {
+    case FETCH_DRAWN:
+      goes_on_screen = res.mode;
+      md.fetched_ms  = now;
+      if (res.data) {
+        // Decoded from the prefetch cache: keep the bytes for the way back
+        const HttpsJpeg *img = (const HttpsJpeg *)res.data;
+        md.fetched_ms = img->fetched_ms;
+        prefetchPut(res.mode, res.data, snapshotBytes(img), img->fetched_ms);
+      }
+      schedAt(res.mode, md.fetched_ms + UPDATE_INTERVAL);
+      logFirstPixel(res.mode, first_pixel_ms);
+      drawAlertBanner();
+      drawTimestamp(); // show time the image was fetched
+      break;
+
+    case FETCH_NOT_MODIFIED: {
+      const CameraCache &cc = camera_cache[res.mode];
+      char msg[48];
+      snprintf(msg, sizeof(msg), "No new frame yet (%u/%u cached)",
+               (unsigned)cc.hits, (unsigned)(cc.hits + cc.misses));
+      showStatus(msg);
+      md.fetched_ms = now;
+      schedAt(res.mode, now + UPDATE_INTERVAL);
+      drawTimestamp();
+      break;
+    }
+
+    case FETCH_OK:  // only prefetch jobs return a GOES payload
+    case FETCH_FAILED:
+    default: {
+      freeSnapshot(res.mode, res.data);  // a cached image that failed to decode
+      char errMsg[60];
+      snprintf(errMsg, sizeof(errMsg), "Fetch failed HTTP:%d", https_last_http_code);
+      showStatus(errMsg);
+      goes_on_screen = -1;
+      schedAt(res.mode, now + 60000); // retry in 60s
+      break;
+    }
+  }
+}
+
+// Switch to mode: render whatever is held in RAM for it at once (or a
+// loading screen), and move the scheduler's foreground cadence over to it.
+static void switchMode(int mode) {
+  const int left = wc_camera_idx;
+  {
+    GfxLock lock;  // an in-flight GOES decode stops drawing from here on
+    fetch_gen++;
+    wcSaveCameraIndex(mode);
+    gfx->fillRect(0, 20, gfx->width(), gfx->height() - 20, RGB565_BLACK);
+    gfx->setTextColor(0x7BEF);
+    gfx->setTextSize(1);
+    gfx->setCursor(4, 26);
+    gfx->print("Loading...");
+    scrInvalidate();
+  }
+  const unsigned long now = millis();
+  goes_on_screen  = -1;
+  fetch_running   = -1;
+  switch_ms       = now;
+  first_pixel_ms  = 0;
+  nav_pending     = true;
+  showModeStatus();
+
+  // The mode being left drops back to its background cadence
+  if (left < NUM_CAMERAS)                schedCancel(left);
+  else if (mode_data[left].fetched_ms)   schedAt(left, mode_data[left].fetched_ms + bgInterval(left));
+  prefetchTrim(mode, NUM_MODES);
+  if (prefetch_running >= 0 && !prefetchKeeps(mode, prefetch_running, NUM_MODES)) prefetch_gen++;
+
+  if (mode == NWS_ALERTS_MODE) alert_banner[0] = '\0';  // seen now
+  drawAlertBanner();
+
+  if (mode >= NUM_CAMERAS) {
+    ModeData &md = mode_data[mode];
+    nav_cached = (md.data != nullptr);
+    if (md.data) {
+      prefetch_hits++;
+      drawSnapshot(mode, md.data);
+      logFirstPixel(mode, millis());
+      drawAlertBanner();
+      drawTimestamp();
+    } else {
+      prefetch_misses++;
+    }
+    // Refetch right away if older than the on-screen cadence
+    schedAt(mode, md.fetched_ms ? md.fetched_ms + modeInterval(mode) : now);
+    return;
+  }
+
+  unsigned long fetched;
+  void *d = prefetchTake(mode, UPDATE_INTERVAL, &fetched);
+  nav_cached = (d != nullptr);
+  if (d) {
+    // Decoding takes a few hundred ms, so it runs on the worker
+    if (postJob(mode, d)) return;
+    prefetchPut(mode, d, snapshotBytes((const HttpsJpeg *)d), fetched);
+  }
+  // Already downloading as a prefetch: applyResult() decodes it on arrival
+  if (mode != prefetch_running) schedAt(mode, now);
+}
+
 void loop() {
+  const unsigned long loopStart = micros();
   identityHandle();
   // ── BOOT button: short press = cycle mode, long press (≥1.5s) = setup portal ──
   if (digitalRead(0) == LOW) {
@@ -190,25 +778,36 @@ void loop() {
       if (held >= 1500) {
         // Long press → reopen captive portal to change WiFi/settings
         showStatus("Opening setup... hold until AP appears");
+        String oldLat = wc_lat, oldLon = wc_lon;
         WiFi.disconnect(true);
         delay(500);
         wcInitPortal();
         while (!portalDone) { wcRunPortal(); delay(5); }
         wcClosePortal();
-        gfx->fillScreen(RGB565_BLACK);
         WiFi.mode(WIFI_STA);
         WiFi.begin(wc_wifi_ssid, wc_wifi_pass);
+        bool moved = (oldLat != wc_lat || oldLon != wc_lon);
+        if (moved) {
+          // New location: nothing held in RAM is trustworthy
+          for (int m = 0; m < NUM_MODES; m++) {
+            freeSnapshot(m, m < NUM_CAMERAS ? nullptr : mode_data[m].data);
+            mode_data[m].data       = nullptr;
+            mode_data[m].fetched_ms = 0;
+          }
+          alert_banner[0] = '\0';
+          prefetchTrim(-1, NUM_MODES);
+          prefetch_gen++;
+        }
+        switchMode(wc_camera_idx);  // repaint with the new settings
+        if (moved) {
+          settings_gen = fetch_gen;
+          scheduleAll();
+        }
         showStatus("Reconnecting to WiFi...");
-        unsigned long t = millis();
-        while (WiFi.status() != WL_CONNECTED && millis() - t < 30000) delay(500);
-        if (WiFi.status() == WL_CONNECTED) showStatus("WiFi connected!");
-        last_update = 0;
+        wifi_retry_ms = millis();
       } else {
         // Short press → next mode
-        wc_camera_idx = (wc_camera_idx + 1) % NUM_MODES;
-        wcSaveCameraIndex(wc_camera_idx);
-        showModeStatus();
-        last_update = 0;
+        switchMode((wc_camera_idx + 1) % NUM_MODES);
       }
     }
   }
@@ -223,146 +822,125 @@ void loop() {
 
       if (tx < 107) {
         // Left third → previous mode
-        wc_camera_idx = (wc_camera_idx + NUM_MODES - 1) % NUM_MODES;
-        wcSaveCameraIndex(wc_camera_idx);
-        showModeStatus();
-        last_update = 0;
+        switchMode((wc_camera_idx + NUM_MODES - 1) % NUM_MODES);
       } else if (tx > 213) {
         // Right third → next mode
-        wc_camera_idx = (wc_camera_idx + 1) % NUM_MODES;
-        wcSaveCameraIndex(wc_camera_idx);
-        showModeStatus();
-        last_update = 0;
+        switchMode((wc_camera_idx + 1) % NUM_MODES);
       } else {
         // Middle third → toggle km / mph (applies to ISS Tracker)
         wc_use_metric = !wc_use_metric;
         wcSaveMetric(wc_use_metric);
+        // Units are applied at draw time, so just redraw the last snapshot
+        if (wc_camera_idx == ISS_MODE && mode_data[ISS_MODE].data) {
+          drawSnapshot(ISS_MODE, mode_data[ISS_MODE].data);
+          drawAlertBanner();
+          drawTimestamp();
+        }
         showStatus(wc_use_metric ? "Units: Metric (km/km/h)" : "Units: Imperial (mi/mph)");
-        if (wc_camera_idx == ISS_MODE) last_update = 0;
       }
     }
   }
 
-  // ── WiFi auto-reconnect ───────────────────────────────────────────────────
+  // ── WiFi auto-reconnect (non-blocking; the worker fails fast meanwhile) ────
   if (WiFi.status() != WL_CONNECTED) {
-    showStatus("WiFi lost - reconnecting...");
-    WiFi.reconnect();
-    unsigned long t = millis();
-    while (WiFi.status() != WL_CONNECTED && millis() - t < 15000) delay(500);
-    if (WiFi.status() == WL_CONNECTED) {
-      showStatus("WiFi reconnected!");
-      delay(500);
+    if (wifi_retry_ms == 0 || millis() - wifi_retry_ms > WIFI_RETRY_MS) {
+      showStatus("WiFi lost - reconnecting...");
+      WiFi.reconnect();
+      wifi_retry_ms = millis();
     }
+  } else if (wifi_retry_ms != 0) {
+    showStatus("WiFi connected!");
+    wifi_retry_ms = 0;
   }
 
-  unsigned long currentInterval;
-  if      (wc_camera_idx == NWS_ALERTS_MODE)    currentInterval = NWS_ALERTS_INTERVAL;
-  else if (wc_camera_idx == NWS_FORECAST_MODE)  currentInterval = NWS_UPDATE_INTERVAL;
-  else if (wc_camera_idx == SPACE_WEATHER_MODE) currentInterval = SW_UPDATE_INTERVAL;
-  else if (wc_camera_idx == ISS_MODE)           currentInterval = ISS_UPDATE_INTERVAL;
-  else if (wc_camera_idx == SUN_MOON_MODE)      currentInterval = SUN_MOON_INTERVAL;
-  else                                          currentInterval = UPDATE_INTERVAL;
+  // ── Finished jobs from the fetch worker ──────────────────────────────────
+  FetchResult res;
+  while (fetchPoll(&res)) applyResult(res);
+
+  // ── Scheduler: the visible mode when due, else the most overdue source ───
+  if (fetch_running < 0) {
+    // Background work waits while the user is tapping through modes
+    bool background = prefetch_running < 0 && millis() - switch_ms > PREFETCH_IDLE_MS;
+    int src = schedNext(wc_camera_idx, background);
+    if (src >= 0 && WiFi.status() != WL_CONNECTED && modeNeedsNetwork(src)) {
+      schedAt(src, millis() + WIFI_RETRY_MS);  // offline: look again after the next reconnect try
+      src = -1;
+    }
+    if (src == wc_camera_idx) {
+      Serial.printf("Heap: %d, PSRAM: %d, TLS handshakes: %u / %u requests, worst loop %lu us\n",
+                    ESP.getFreeHeap(), ESP.getFreePsram(), (unsigned)pool_handshakes,
+                    (unsigned)pool_requests, loop_worst_us);
+      Serial.printf("Prefetch: %u hits / %u misses, %u B cached\n", (unsigned)prefetch_hits,
+                    (unsigned)prefetch_misses, (unsigned)prefetch_used);
+      Serial.printf("Screen: %u frames, %u widgets repainted / %u unchanged, %u B pushed\n",
+                    (unsigned)scr_frames, (unsigned)scr_repaints, (unsigned)scr_skipped,
+                    (unsigned)scr_bytes);
+      scr_frames = scr_repaints = scr_skipped = scr_bytes = 0;
+      logSchedStats();
+      loop_worst_us = 0;
+
+      if      (src == NWS_FORECAST_MODE)  showStatus("Fetching NWS forecast...");
+      else if (src == NWS_ALERTS_MODE)    showStatus("Checking NWS alerts...");
+      else if (src == SPACE_WEATHER_MODE) showStatus("Fetching space weather...");
+      else if (src == ISS_MODE)           showStatus("Loading ISS orbit (TLE)...");
+      else if (src == SUN_MOON_MODE)      showStatus("Computing Sun & Moon...");
+      else                                showStatus("Fetching GOES satellite image...");
+    } else if (src >= 0) {
+      Serial.printf("[Sched] background refresh of mode %d\n", src);
+    }
+    if (src >= 0 && !postJob(src, nullptr)) schedAt(src, millis() + 1000);
+  }
 
-  if ((last_update == 0) || ((millis() - last_update) > currentInterval)) {
-    Serial.printf("Heap: %d, PSRAM: %d\n", ESP.getFreeHeap(), ESP.getFreePsram());
+  // ── Idle: prefetch neighbouring cameras so a left/right tap renders from RAM ──
+  if (fetch_running < 0 && prefetch_running < 0 && mode_data[wc_camera_idx].fetched_ms &&
+      WiFi.status() == WL_CONNECTED && millis() - switch_ms > PREFETCH_IDLE_MS) {
+    int next = (wc_camera_idx + 1) % NUM_MODES;
+    int prev = (wc_camera_idx + NUM_MODES - 1) % NUM_MODES;
+    int want = (next < NUM_CAMERAS && prefetchWants(next, UPDATE_INTERVAL)) ? next
+             : (prev < NUM_CAMERAS && prefetchWants(prev, UPDATE_INTERVAL)) ? prev : -1;
+    if (want >= 0) {
+      uint32_t room = prefetchRoom();
+      if (room < 1024) prefetchFailed(want);  // budget full; try again later
+      else if (fetchPost(want, wc_lat, wc_lon, true, room)) prefetch_running = want;
+    }
+  }
 
-    if (wc_camera_idx == NWS_FORECAST_MODE) {
-      // ── NWS Current Forecast ───────────────────────────────────────────────
-      showStatus("Fetching NWS forecast...");
-      if (nwsFetchAndDisplay(wc_lat, wc_lon)) {
-        last_update = millis();
-        drawTimestamp();
-      } else {
-        showStatus("NWS fetch failed - retrying in 60s");
-        last_update = millis() - NWS_UPDATE_INTERVAL + 60000;
-      }
-    } else if (wc_camera_idx == NWS_ALERTS_MODE) {
-      // ── NWS Alerts ────────────────────────────────────────────────────────
-      showStatus("Checking NWS alerts...");
-      if (nwsFetchAndDisplayAlerts(wc_lat, wc_lon)) {
-        last_update = millis();
-        drawTimestamp();
-      } else {
-        showStatus("NWS fetch failed - retrying in 60s");
-        last_update = millis() - NWS_ALERTS_INTERVAL + 60000;
-      }
-    } else if (wc_camera_idx == SPACE_WEATHER_MODE) {
-      // ── NOAA Space Weather ────────────────────────────────────────────────
-      showStatus("Fetching space weather...");
-      if (swFetchAndDisplay(wc_lat, wc_lon)) {
-        last_update = millis();
-        drawTimestamp();
-      } else {
-        showStatus("Space weather fetch failed - retrying in 60s");
-        last_update = millis() - SW_UPDATE_INTERVAL + 60000;
-      }
-    } else if (wc_camera_idx == ISS_MODE) {
-      // ── ISS Live Tracker ─────────────────────────────────────────────────
-      showStatus("Fetching ISS position...");
-      if (issFetchAndDisplay(wc_lat, wc_lon, wc_use_metric)) {
-        last_update = millis();
-        drawTimestamp();
-      } else {
-        showStatus("ISS fetch failed - retrying in 30s");
-        last_update = millis() - ISS_UPDATE_INTERVAL + 30000;
-      }
-    } else if (wc_camera_idx == SUN_MOON_MODE) {
-      // ── Sun & Moon Phase ─────────────────────────────────────────────────
-      showStatus("Fetching Sun & Moon data...");
-      if (sunMoonFetchAndDisplay(wc_lat, wc_lon)) {
-        last_update = millis();
-        drawTimestamp();
-      } else {
-        showStatus("Sun/Moon fetch failed - retrying in 60s");
-        last_update = millis() - SUN_MOON_INTERVAL + 60000UL;
-      }
-    } else {
-      // ── GOES satellite image mode ──────────────────────────────────────────
-      showStatus("Fetching GOES satellite image...");
-
-      https_get_response_buf(CAMERAS[wc_camera_idx].url);
-
-      if (https_response_buf && https_response_len > 0 &&
-          jpeg.openRAM(https_response_buf, https_response_len, JPEGDraw)) {
-        showStatus("Decoding...");
-        jpeg.setPixelType(RGB565_BIG_ENDIAN);
-        // Clear the full image area before decode to prevent artifacts from
-        // previous images and the NOAA watermark bar at the bottom.
-        gfx->fillRect(0, 20, gfx->width(), gfx->height() - 20, RGB565_BLACK);
-        jpeg.decode(CAMERAS[wc_camera_idx].x_off, CAMERAS[wc_camera_idx].y_off, 0);
-        jpeg.close();
-        last_update = millis();
-        drawTimestamp(); // show time the image was fetched
-      } else {
-        char errMsg[60];
-        snprintf(errMsg, sizeof(errMsg), "Fetch failed HTTP:%d len:%d",
-                 https_last_http_code, https_response_len);
-        showStatus(errMsg);
-        Serial.println(errMsg);
-        last_update = millis() - UPDATE_INTERVAL + 60000; // retry in 60s
-      }
+  // ── ISS: propagate locally and refresh the readouts once a second ────────
+  if (wc_camera_idx == ISS_MODE && mode_data[ISS_MODE].data && millis() - iss_tick_ms >= ISS_TICK_MS) {
+    iss_tick_ms = millis();
+    const IssOrbit *orbit = (const IssOrbit *)mode_data[ISS_MODE].data;
+    drawIss(orbit);
+    if (issPassesStale(orbit, time(nullptr))) schedNoLaterThan(ISS_MODE, millis());  // predict again
+  }
 
-      if (https_response_buf) {
-        free(https_response_buf);
-        https_response_buf = nullptr;
-      }
-    }
+  // ── Sun & Moon: live alt/az readouts once a second ───────────────────────
+  if (wc_camera_idx == SUN_MOON_MODE && mode_data[SUN_MOON_MODE].data && millis() - sm_tick_ms >= SM_TICK_MS) {
+    sm_tick_ms = millis();
+    drawSnapshot(SUN_MOON_MODE, mode_data[SUN_MOON_MODE].data);
+    if (scrPaintedTop()) drawAlertBanner();
   }
 
   // Redraw timestamp every minute so the clock stays current between image refreshes
-  if (last_update != 0 && millis() - last_clock > CLOCK_INTERVAL) {
+  if (mode_data[wc_camera_idx].fetched_ms && millis() - last_clock > CLOCK_INTERVAL) {
     drawTimestamp();
     last_clock = millis();
   }
 
-  // ── Countdown bar: 1px line at y=239 draining over currentInterval ────────
+  // ── Countdown bar: 1px line at y=239 draining until the next refresh ──────
   {
-    unsigned long elapsed = (last_update == 0) ? 0 : (millis() - last_update);
-    if (elapsed > currentInterval) elapsed = currentInterval;
-    int barW = (int)((long)(currentInterval - elapsed) * gfx->width() / currentInterval);
+    unsigned long currentInterval = modeInterval(wc_camera_idx);
+    unsigned long remaining = currentInterval;  // full until the first fetch lands
+    if (mode_data[wc_camera_idx].fetched_ms) {
+      long left = schedPending(wc_camera_idx) ? (long)(schedDue(wc_camera_idx) - millis()) : 0;
+      remaining = left <= 0 ? 0 : ((unsigned long)left > currentInterval ? currentInterval : left);
+    }
+    int barW = (int)((long)remaining * gfx->width() / currentInterval);
+    GfxLock lock;
     gfx->drawFastHLine(0,    gfx->height() - 1, barW,               0x001F);        // blue remaining
     gfx->drawFastHLine(barW, gfx->height() - 1, gfx->width() - barW, RGB565_BLACK); // black elapsed
   }
 
+  unsigned long took = micros() - loopStart;
+  if (took > loop_worst_us) loop_worst_us = took;
   delay(50);
 }
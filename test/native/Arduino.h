@@ -0,0 +1,268 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// Host stand-in for the Arduino-ESP32 core (pio test -e native)
+//
+// Just enough of the core for the firmware headers to build and run on the
+// host: String, Serial, ESP, pins and the clock.
+//
+// The clock is virtual: millis()/micros() only move when delay() is called
+// (or a test calls nativeAdvance()), so timeouts, drip-fed responses and idle
+// expiry run instantly and give the same numbers on every machine. FreeRTOS
+// tasks (NativeRTOS.h) take turns on the same clock.
+// ---------------------------------------------------------------------------
+#include <ctype.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <ctime>     // before the time() macro below: <ctime> #undefs time on first include
+#include <string>
+
+using std::max;
+using std::min;
+
+typedef bool    boolean;
+typedef uint8_t byte;
+
+#define HIGH         1
+#define LOW          0
+#define INPUT        0
+#define OUTPUT       1
+#define INPUT_PULLUP 2
+#define IRAM_ATTR
+#define PROGMEM
+
+// ── Clock ────────────────────────────────────────────────────────────────────
+inline uint64_t native_clock_us = 0;      // virtual time
+
+inline void nativeAdvance(unsigned long ms) { native_clock_us += (uint64_t)ms * 1000; }
+
+inline unsigned long micros() { return (unsigned long)native_clock_us; }
+inline unsigned long millis() { return (unsigned long)(native_clock_us / 1000); }
+
+// Sleeping lets the other tasks run (NativeRTOS.h)
+inline void native_sleep_us(uint64_t us);
+inline void delay(unsigned long ms) { native_sleep_us((uint64_t)ms * 1000); }
+inline void delayMicroseconds(unsigned int us) { native_sleep_us(us); }
+inline void yield() { native_sleep_us(0); }
+
+// ── Pins: every input reads HIGH (BOOT button released) unless pressed ─────
+inline bool native_pressed[64];
+inline void pinMode(int, int) {}
+inline void digitalWrite(int, int) {}
+inline int  digitalRead(int pin) { return native_pressed[pin & 63] ? LOW : HIGH; }
+inline void nativePress(int pin, bool down) { native_pressed[pin & 63] = down; }
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// ── String ───────────────────────────────────────────────────────────────────
+class String {
+ public:
+  String() {}
+  String(const char *c) : s(c ? c : "") {}
+  String(const std::string &x) : s(x) {}
+  explicit String(char c) : s(1, c) {}
+  String(int v)           : s(std::to_string(v)) {}
+  String(unsigned v)      : s(std::to_string(v)) {}
+  String(long v)          : s(std::to_string(v)) {}
+  String(unsigned long v) : s(std::to_string(v)) {}
+  String(float v, unsigned decimals = 2)  { fmt(v, decimals); }
+  String(double v, unsigned decimals = 2) { fmt(v, decimals); }
+
+  const char *c_str() const { return s.c_str(); }
+  unsigned length() const { return s.size(); }
+  bool isEmpty() const { return s.empty(); }
+  bool reserve(unsigned n) { s.reserve(n); return true; }
+
+  bool concat(const String &o) { s += o.s; return true; }
+  bool concat(const char *c) { if (c) s += c; return true; }
+  bool concat(const char *c, unsigned n) { if (c) s.append(c, n); return true; }
+  bool concat(char c) { s += c; return true; }
+  String &operator+=(const String &o) { s += o.s; return *this; }
+  String &operator+=(const char *o) { if (o) s += o; return *this; }
+  String &operator+=(char o) { s += o; return *this; }
+  String &operator+=(int o) { s += std::to_string(o); return *this; }
+  String &operator+=(unsigned o) { s += std::to_string(o); return *this; }
+  String &operator+=(long o) { s += std::to_string(o); return *this; }
+  String &operator+=(unsigned long o) { s += std::to_string(o); return *this; }
+
+  int indexOf(char c, unsigned from = 0) const { return pos(s.find(c, from)); }
+  int indexOf(const char *x, unsigned from = 0) const { return pos(s.find(x, from)); }
+  int indexOf(const String &x, unsigned from = 0) const { return pos(s.find(x.s, from)); }
+  int lastIndexOf(char c) const { return pos(s.rfind(c)); }
+  int lastIndexOf(const char *x) const { return pos(s.rfind(x)); }
+  String substring(unsigned a) const { return a >= s.size() ? String() : String(s.substr(a)); }
+  String substring(unsigned a, unsigned b) const {
+    if (a > b) std::swap(a, b);
+    return a >= s.size() ? String() : String(s.substr(a, b - a));
+  }
+  bool startsWith(const String &p) const { return s.compare(0, p.s.size(), p.s) == 0; }
+  bool endsWith(const String &p) const {
+    return s.size() >= p.s.size() && s.compare(s.size() - p.s.size(), p.s.size(), p.s) == 0;
+  }
+  bool equalsIgnoreCase(const String &o) const { return strcasecmp(s.c_str(), o.s.c_str()) == 0; }
+  void trim() {
+    size_t a = 0, b = s.size();
+    while (a < b && isspace((unsigned char)s[a])) a++;
+    while (b > a && isspace((unsigned char)s[b - 1])) b--;
+    s = s.substr(a, b - a);
+  }
+  void toUpperCase() { for (auto &c : s) c = toupper((unsigned char)c); }
+  void toLowerCase() { for (auto &c : s) c = tolower((unsigned char)c); }
+  void remove(unsigned i) { if (i < s.size()) s.erase(i); }
+  void remove(unsigned i, unsigned n) { if (i < s.size()) s.erase(i, n); }
+  void replace(const String &a, const String &b) {
+    if (a.s.empty()) return;
+    for (size_t p = 0; (p = s.find(a.s, p)) != std::string::npos; p += b.s.size()) s.replace(p, a.s.size(), b.s);
+  }
+  long   toInt() const { return atol(s.c_str()); }
+  float  toFloat() const { return (float)atof(s.c_str()); }
+  double toDouble() const { return atof(s.c_str()); }
+  void toCharArray(char *buf, unsigned n) const {
+    if (!n) return;
+    size_t k = std::min((size_t)n - 1, s.size());
+    memcpy(buf, s.data(), k);
+    buf[k] = '\0';
+  }
+  char charAt(unsigned i) const { return i < s.size() ? s[i] : 0; }
+  char operator[](unsigned i) const { return i < s.size() ? s[i] : 0; }
+  char &operator[](unsigned i) { return s[i]; }
+
+  bool operator==(const String &o) const { return s == o.s; }
+  bool operator==(const char *o) const { return s == (o ? o : ""); }
+  bool operator!=(const String &o) const { return s != o.s; }
+  bool operator!=(const char *o) const { return !(*this == o); }
+  bool operator<(const String &o) const { return s < o.s; }
+
+  std::string s;
+
+ private:
+  static int pos(size_t p) { return p == std::string::npos ? -1 : (int)p; }
+  void fmt(double v, unsigned d) {
+    char b[48];
+    snprintf(b, sizeof(b), "%.*f", (int)d, v);
+    s = b;
+  }
+};
+
+inline String operator+(const String &a, const String &b) { return String(a.s + b.s); }
+inline String operator+(const String &a, const char *b) { return String(a.s + (b ? b : "")); }
+inline String operator+(const char *a, const String &b) { return String((a ? a : "") + b.s); }
+inline String operator+(const String &a, char b) { return String(a.s + b); }
+inline String operator+(const String &a, int b) { return String(a.s + std::to_string(b)); }
+
+// ── Print / Stream / Serial ──────────────────────────────────────────────────
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *b, size_t n) {
+    size_t k = 0;
+    while (k < n && write(b[k])) k++;
+    return k;
+  }
+  size_t write(const char *str) { return str ? write((const uint8_t *)str, strlen(str)) : 0; }
+  size_t print(const char *v) { return write(v); }
+  size_t print(const String &v) { return write(v.c_str()); }
+  size_t print(char v) { return write((uint8_t)v); }
+  size_t print(int v) { return printf("%d", v); }
+  size_t print(unsigned v) { return printf("%u", v); }
+  size_t print(long v) { return printf("%ld", v); }
+  size_t print(unsigned long v) { return printf("%lu", v); }
+  size_t print(double v, int d = 2) { return printf("%.*f", d, v); }
+  size_t println() { return write("\r\n"); }
+  template <class T> size_t println(const T &v) { return print(v) + println(); }
+  size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3))) {
+    char buf[512];
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(buf, sizeof(buf), fmt, ap);
+    va_end(ap);
+    if (n < 0) return 0;
+    return write((const uint8_t *)buf, std::min((size_t)n, sizeof(buf) - 1));
+  }
+};
+
+class Stream : public Print {
+ public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() { return -1; }
+  virtual void flush() {}
+};
+
+// Firmware logging goes to stdout when NATIVE_SERIAL is set in the environment
+class HardwareSerial : public Stream {
+ public:
+  void begin(unsigned long) {}
+  int available() override { return 0; }
+  int read() override { return -1; }
+  size_t write(uint8_t c) override {
+    static const bool echo = getenv("NATIVE_SERIAL") != nullptr;
+    if (echo) fputc(c, stdout);
+    return 1;
+  }
+  using Print::write;
+};
+inline HardwareSerial Serial;
+
+// ── ESP ──────────────────────────────────────────────────────────────────────
+// Free heap is a fixed 200 KB unless the test tracks allocations (NativeHeap.h)
+#define NATIVE_HEAP_SIZE (200 * 1024)
+inline std::atomic<int64_t> native_heap_used{0};
+inline std::atomic<int64_t> native_heap_peak{0};
+inline thread_local int     native_heap_exempt = 0;   // >0: not the firmware's allocations
+
+// Scope in which allocations belong to the test scaffolding, not the firmware
+struct NativeHeapExempt {
+  NativeHeapExempt()  { native_heap_exempt++; }
+  ~NativeHeapExempt() { native_heap_exempt--; }
+};
+
+struct EspClass {
+  uint32_t getFreeHeap() { return (uint32_t)(NATIVE_HEAP_SIZE - native_heap_used); }
+  uint32_t getMaxAllocHeap() { return getFreeHeap(); }
+  uint32_t getMinFreeHeap() { return getFreeHeap(); }
+  uint32_t getFreePsram() { return 0; }
+  uint32_t getCycleCount() { return (uint32_t)(micros() * 240); }
+  void restart() { exit(0); }
+};
+inline EspClass ESP;
+
+// ── Time: UTC that runs with the virtual clock (configTime() is a no-op) ─────
+// time() is the wall clock the test sets with nativeSetTime(), moving on with
+// millis(); until then it reads 0, as on a board before NTP answers.
+inline int64_t native_epoch_offset = 0;   // unix time minus clock seconds, 0 = not synced
+
+inline void nativeSetTime(time_t utc) {
+  native_epoch_offset = (int64_t)utc - (int64_t)(native_clock_us / 1000000);
+}
+inline time_t native_time(time_t *out) {
+  time_t t = native_epoch_offset ? (time_t)(native_epoch_offset + (int64_t)(native_clock_us / 1000000)) : 0;
+  if (out) *out = t;
+  return t;
+}
+#define time(out) native_time(out)
+
+inline void configTime(long, int, const char *, const char * = nullptr, const char * = nullptr) {}
+inline bool getLocalTime(struct tm *info, uint32_t = 5000) {
+  time_t now = time(nullptr);
+  if (!now) return false;
+  gmtime_r(&now, info);
+  return true;
+}
+
+#include "NativeRTOS.h"
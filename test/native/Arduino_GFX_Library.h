@@ -0,0 +1,274 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// Host stand-in for moononournation/GFX Library for Arduino (1.4.7)
+//
+// A 320x240 RGB565 framebuffer with the library's drawing semantics — same
+// circle and filled-circle walks, clipping, cursor and wrapping, opaque or
+// transparent text — so tests can compare what ends up on the panel pixel
+// for pixel. The built-in 6x8 font is replaced by a fixed pattern per
+// character: different text gives different pixels, which is all the tests
+// need.
+//
+// Traffic is counted the way the ILI9341 sees it: every address window
+// (a pixel, a rectangle, a bitmap, an opaque glyph) and every pixel
+// written. Each draw call also costs bus time on the virtual clock, by
+// default 40 MHz SPI: 400 ns per pixel plus 3 us per address window.
+// ---------------------------------------------------------------------------
+#include <Arduino.h>
+
+#define GFX_NOT_DEFINED -1
+#define GFX_SKIP_OUTPUT_BEGIN -2
+
+#define RGB565_BLACK     0x0000
+#define RGB565_NAVY      0x000F
+#define RGB565_DARKGREEN 0x03E0
+#define RGB565_MAROON    0x7800
+#define RGB565_DARKGREY  0x7BEF
+#define RGB565_LIGHTGREY 0xC618
+#define RGB565_BLUE      0x001F
+#define RGB565_GREEN     0x07E0
+#define RGB565_CYAN      0x07FF
+#define RGB565_RED       0xF800
+#define RGB565_MAGENTA   0xF81F
+#define RGB565_YELLOW    0xFFE0
+#define RGB565_ORANGE    0xFD20
+#define RGB565_WHITE     0xFFFF
+
+struct GfxNativeStats {
+  uint32_t windows;      // address windows set
+  uint64_t px;           // pixels written
+  uint32_t fill_rects;   // fillRect/fillScreen/fast line calls
+  uint64_t fill_px;
+  uint32_t bitmaps;      // draw16bit*Bitmap calls
+  uint64_t bitmap_px;
+  uint32_t pixels;       // drawPixel calls (and circle outline points)
+  uint32_t chars;        // glyphs drawn
+};
+inline GfxNativeStats gfx_native_stats;
+
+// Bus cost charged to the clock per draw call
+inline uint32_t gfx_native_ns_per_px     = 400;
+inline uint32_t gfx_native_ns_per_window = 3000;
+
+class Arduino_DataBus {
+ public:
+  virtual ~Arduino_DataBus() {}
+};
+
+class Arduino_HWSPI : public Arduino_DataBus {
+ public:
+  Arduino_HWSPI(int8_t dc, int8_t cs = GFX_NOT_DEFINED, int8_t sck = GFX_NOT_DEFINED,
+                int8_t mosi = GFX_NOT_DEFINED, int8_t miso = GFX_NOT_DEFINED, bool shared = true) {}
+};
+
+class Arduino_GFX : public Print {
+ public:
+  Arduino_GFX(int16_t w, int16_t h) : _w(w), _h(h), fb(new uint16_t[w * h]()) {}
+
+  virtual bool begin(int32_t speed = GFX_NOT_DEFINED) { return true; }
+  int16_t width() const { return _w; }
+  int16_t height() const { return _h; }
+  void invertDisplay(bool i) { inverted = i; }
+
+  // ── Pixels ─────────────────────────────────────────────────────────────────
+  void drawPixel(int16_t x, int16_t y, uint16_t c) {
+    point(x, y, c);
+    charge();
+  }
+  void fillScreen(uint16_t c) { fillRect(0, 0, _w, _h, c); }
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t c) {
+    rect(x, y, w, h, c);
+    charge();
+  }
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t c) { fillRect(x, y, w, 1, c); }
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t c) { fillRect(x, y, 1, h, c); }
+  void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t c) {
+    rect(x, y, w, 1, c);
+    rect(x, y + h - 1, w, 1, c);
+    rect(x, y, 1, h, c);
+    rect(x + w - 1, y, 1, h, c);
+    charge();
+  }
+
+  void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t c) {
+    int16_t f = 1 - r, ddF_x = 1, ddF_y = -2 * r, x = 0, y = r;
+    point(x0, y0 + r, c);
+    point(x0, y0 - r, c);
+    point(x0 + r, y0, c);
+    point(x0 - r, y0, c);
+    while (x < y) {
+      if (f >= 0) { y--; ddF_y += 2; f += ddF_y; }
+      x++; ddF_x += 2; f += ddF_x;
+      point(x0 + x, y0 + y, c); point(x0 - x, y0 + y, c);
+      point(x0 + x, y0 - y, c); point(x0 - x, y0 - y, c);
+      point(x0 + y, y0 + x, c); point(x0 - y, y0 + x, c);
+      point(x0 + y, y0 - x, c); point(x0 - y, y0 - x, c);
+    }
+    charge();
+  }
+
+  void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t c) {
+    rect(x0, y0 - r, 1, 2 * r + 1, c);
+    int16_t f = 1 - r, ddF_x = 1, ddF_y = -2 * r, x = 0, y = r, px = x, py = y;
+    while (x < y) {
+      if (f >= 0) { y--; ddF_y += 2; f += ddF_y; }
+      x++; ddF_x += 2; f += ddF_x;
+      if (x < y + 1) {
+        rect(x0 + x, y0 - y, 1, 2 * y + 1, c);
+        rect(x0 - x, y0 - y, 1, 2 * y + 1, c);
+      }
+      if (y != py) {
+        rect(x0 + py, y0 - px, 1, 2 * px + 1, c);
+        rect(x0 - py, y0 - px, 1, 2 * px + 1, c);
+        py = y;
+      }
+      px = x;
+    }
+    charge();
+  }
+
+  // One address window for the whole bitmap, as the library does
+  void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) {
+    bitmap16(x, y, bitmap, w, h, false);
+  }
+  void draw16bitBeRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) {
+    bitmap16(x, y, bitmap, w, h, true);
+  }
+
+  // ── Text ───────────────────────────────────────────────────────────────────
+  void setCursor(int16_t x, int16_t y) { cx = x; cy = y; }
+  int16_t getCursorX() const { return cx; }
+  int16_t getCursorY() const { return cy; }
+  void setTextColor(uint16_t c) { fg = bg = c; }
+  void setTextColor(uint16_t c, uint16_t b) { fg = c; bg = b; }
+  void setTextSize(uint8_t s) { ts = s ? s : 1; }
+  void setTextWrap(bool w) { wrap = w; }
+  void getTextBounds(const char *str, int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h) {
+    *x1 = x;
+    *y1 = y;
+    *w  = strlen(str) * 6 * ts;
+    *h  = 8 * ts;
+  }
+
+  size_t write(uint8_t ch) override {
+    if (ch == '\n') {
+      cx = 0;
+      cy += 8 * ts;
+    } else if (ch != '\r') {
+      if (wrap && cx + 6 * ts > _w) {
+        cx = 0;
+        cy += 8 * ts;
+      }
+      drawChar(cx, cy, ch);
+      cx += 6 * ts;
+      charge();
+    }
+    return 1;
+  }
+  using Print::write;
+
+  // ── Test access ────────────────────────────────────────────────────────────
+  uint16_t pixel(int x, int y) const { return (x >= 0 && y >= 0 && x < _w && y < _h) ? fb[y * _w + x] : 0; }
+  const uint16_t *frame() const { return fb; }
+  uint32_t checksum(int x, int y, int w, int h) const {
+    uint32_t s = 2166136261u;
+    for (int j = y; j < y + h; j++)
+      for (int i = x; i < x + w; i++) { s ^= pixel(i, j); s *= 16777619u; }
+    return s;
+  }
+
+  bool inverted = false;
+
+ private:
+  // The stand-in font: 5 columns of 7 rows per character, from its code
+  static uint8_t glyphColumn(uint8_t ch, int col) {
+    if (ch == ' ') return 0;
+    uint32_t h = (ch * 2654435761u) ^ (col * 40503u);
+    h ^= h >> 13;
+    return (uint8_t)((h & 0x7F) | (col == 2 ? 0x08 : 0));   // never blank
+  }
+
+  // Opaque text at size 1 goes out as one 6x8 window per glyph; otherwise
+  // every set pixel is its own pixel (size 1) or rectangle (larger sizes)
+  void drawChar(int16_t x, int16_t y, uint8_t ch) {
+    gfx_native_stats.chars++;
+    const bool opaque = bg != fg;
+    const bool block  = opaque && ts == 1 && x >= 0 && y >= 0 && x + 6 <= _w && y + 8 <= _h;
+    for (int col = 0; col < 6; col++) {
+      uint8_t bits = col < 5 ? glyphColumn(ch, col) : 0;
+      for (int row = 0; row < 8; row++, bits >>= 1) {
+        if (!(bits & 1) && !opaque) continue;
+        uint16_t c = (bits & 1) ? fg : bg;
+        if (block)        fb[(y + row) * _w + x + col] = c;
+        else if (ts == 1) point(x + col, y + row, c);
+        else              rect(x + col * ts, y + row * ts, ts, ts, c);
+      }
+    }
+    if (block) {
+      gfx_native_stats.windows++;
+      gfx_native_stats.px += 48;
+      pending_ns += gfx_native_ns_per_window + 48 * gfx_native_ns_per_px;
+    }
+  }
+
+  void point(int x, int y, uint16_t c) {
+    if (x < 0 || y < 0 || x >= _w || y >= _h) return;
+    fb[y * _w + x] = c;
+    gfx_native_stats.pixels++;
+    gfx_native_stats.windows++;
+    gfx_native_stats.px++;
+    pending_ns += gfx_native_ns_per_window + gfx_native_ns_per_px;
+  }
+  void rect(int x, int y, int w, int h, uint16_t c) {
+    if (w < 0) { x += w + 1; w = -w; }
+    if (h < 0) { y += h + 1; h = -h; }
+    int x0 = std::max(x, 0), y0 = std::max(y, 0);
+    int x1 = std::min(x + w, (int)_w), y1 = std::min(y + h, (int)_h);
+    if (x1 <= x0 || y1 <= y0) return;
+    for (int j = y0; j < y1; j++) std::fill(fb + j * _w + x0, fb + j * _w + x1, c);
+    const uint64_t n = (uint64_t)(x1 - x0) * (y1 - y0);
+    gfx_native_stats.fill_rects++;
+    gfx_native_stats.fill_px += n;
+    gfx_native_stats.windows++;
+    gfx_native_stats.px += n;
+    pending_ns += gfx_native_ns_per_window + n * gfx_native_ns_per_px;
+  }
+  void bitmap16(int x, int y, const uint16_t *bm, int w, int h, bool be) {
+    uint64_t n = 0;
+    for (int j = 0; j < h; j++) {
+      for (int i = 0; i < w; i++) {
+        int px = x + i, py = y + j;
+        if (px < 0 || py < 0 || px >= _w || py >= _h) continue;
+        uint16_t c = bm[j * w + i];
+        fb[py * _w + px] = be ? (uint16_t)((c << 8) | (c >> 8)) : c;
+        n++;
+      }
+    }
+    gfx_native_stats.bitmaps++;
+    gfx_native_stats.bitmap_px += n;
+    gfx_native_stats.windows++;
+    gfx_native_stats.px += n;
+    pending_ns += gfx_native_ns_per_window + n * gfx_native_ns_per_px;
+    charge();
+  }
+  // The bus time of everything drawn since the last charge
+  void charge() {
+    if (pending_ns >= 1000) delayMicroseconds((unsigned)(pending_ns / 1000));
+    pending_ns %= 1000;
+  }
+
+  int16_t   _w, _h;
+  uint16_t *fb;
+  int16_t   cx = 0, cy = 0;
+  uint16_t  fg = 0xFFFF, bg = 0xFFFF;
+  uint8_t   ts = 1;
+  bool      wrap = true;
+  uint64_t  pending_ns = 0;
+};
+
+class Arduino_ILI9341 : public Arduino_GFX {
+ public:
+  Arduino_ILI9341(Arduino_DataBus *bus, int8_t rst = GFX_NOT_DEFINED, uint8_t r = 0, bool ips = false)
+    : Arduino_GFX((r & 1) ? 320 : 240, (r & 1) ? 240 : 320) {}
+};
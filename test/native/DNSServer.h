@@ -0,0 +1,11 @@
+#pragma once
+
+// Host stand-in for the Arduino-ESP32 DNSServer (captive portal only)
+#include <WiFi.h>
+
+class DNSServer {
+ public:
+  bool start(uint16_t port, const String &domain, const IPAddress &ip) { return true; }
+  void processNextRequest() {}
+  void stop() {}
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// Host stand-in for the Arduino-ESP32 FS API: files are kept in memory
+// ---------------------------------------------------------------------------
+#include <Arduino.h>
+
+#include <map>
+
+#define FILE_READ  "r"
+#define FILE_WRITE "w"
+
+namespace fs {
+
+class File {
+ public:
+  File(std::string *data = nullptr) : _data(data) {}
+  explicit operator bool() const { return _data != nullptr; }
+  size_t write(const uint8_t *buf, size_t n) {
+    if (!_data) return 0;
+    _data->append((const char *)buf, n);
+    return n;
+  }
+  size_t size() const { return _data ? _data->size() : 0; }
+  void flush() {}
+  void close() { _data = nullptr; }
+
+ private:
+  std::string *_data;
+};
+
+class FS {
+ public:
+  File open(const String &path, const char *mode) {
+    if (!strcmp(mode, FILE_WRITE)) files[path.s].clear();
+    else if (!files.count(path.s)) return File();
+    return File(&files[path.s]);
+  }
+  bool exists(const String &path) { return files.count(path.s) > 0; }
+
+  std::map<std::string, std::string> files;
+};
+
+}  // namespace fs
+
+using fs::File;
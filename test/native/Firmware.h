@@ -0,0 +1,66 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// The whole firmware (src/main.cpp) on the host
+//
+// For tests that drive setup()/loop() end to end: settings are seeded in NVS
+// so the board boots straight past the portal, the fetch worker and the
+// pixel push task run as NativeRTOS tasks, the panel is the framebuffer in
+// Arduino_GFX_Library.h and every host is whatever the test registered with
+// StandIn.h (anything else refuses to connect). setup() starts tasks, so it
+// runs once per test binary; tests carry on from the state the last one
+// left behind.
+// ---------------------------------------------------------------------------
+#include "../../src/main.cpp"
+
+struct NativeSettings {
+  const char *lat       = "39.7392";   // Denver
+  const char *lon       = "-104.9903";
+  int         camera    = 0;
+  bool        metric    = true;
+  bool        fit_whole = false;
+};
+
+// Seed NVS as the portal would have and boot. Returns false if already booted.
+inline bool nativeBoot(const NativeSettings &s = NativeSettings()) {
+  static bool booted = false;
+  if (booted) return false;
+  booted = true;
+  Preferences p;
+  p.begin("weathercore", false);
+  p.putString("ssid", "TestNet");
+  p.putString("pass", "password");
+  p.putString("lat", s.lat);
+  p.putString("lon", s.lon);
+  p.putInt("camera", s.camera);
+  p.putBool("metric", s.metric);
+  p.putBool("fitwhole", s.fit_whole);
+  p.end();
+  setup();
+  return true;
+}
+
+// Run loop() for ms of clock
+inline void nativeRunFor(unsigned long ms) {
+  const unsigned long end = millis() + ms;
+  while ((long)(millis() - end) < 0) loop();
+}
+
+// Run loop() until done() holds or ms of clock pass; returns done()
+template <class Pred> bool nativeRunUntil(Pred done, unsigned long ms) {
+  const unsigned long end = millis() + ms;
+  while (!done() && (long)(millis() - end) < 0) loop();
+  return done();
+}
+
+// A tap on the left (prev), middle (units) or right (next) third of the
+// screen, held for one loop() pass
+inline void nativeTap(int third) {
+  static const int16_t raw_x[] = { 600, 2050, 3500 };
+  nativeTouch(raw_x[third], 2000);
+  loop();
+  nativeRelease();
+}
+#define NATIVE_TAP_PREV  0
+#define NATIVE_TAP_UNITS 1
+#define NATIVE_TAP_NEXT  2
@@ -0,0 +1,208 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// Host stand-in for the Arduino-ESP32 HTTPClient
+//
+// The subset the pool uses, with the same observable behaviour: GET reuses a
+// connected client when setReuse(true), returns negative HTTPC_ERROR_* codes
+// on refusal, send failure, timeout or a closed connection (stopping the
+// client), exposes only the collectHeaders() keys through header(), and
+// end() keeps the session only if the server allowed keep-alive.
+// ---------------------------------------------------------------------------
+#include <Arduino.h>
+#include <WiFiClientSecure.h>
+
+#include <vector>
+
+#define HTTP_CODE_OK                200
+#define HTTP_CODE_NO_CONTENT        204
+#define HTTP_CODE_PARTIAL_CONTENT   206
+#define HTTP_CODE_MOVED_PERMANENTLY 301
+#define HTTP_CODE_FOUND             302
+#define HTTP_CODE_NOT_MODIFIED      304
+#define HTTP_CODE_NOT_FOUND         404
+
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED (-2)
+#define HTTPC_ERROR_SEND_PAYLOAD_FAILED (-3)
+#define HTTPC_ERROR_NOT_CONNECTED      (-4)
+#define HTTPC_ERROR_CONNECTION_LOST    (-5)
+#define HTTPC_ERROR_NO_STREAM          (-6)
+#define HTTPC_ERROR_NO_HTTP_SERVER     (-7)
+#define HTTPC_ERROR_TOO_LESS_RAM       (-8)
+#define HTTPC_ERROR_ENCODING           (-9)
+#define HTTPC_ERROR_STREAM_WRITE       (-10)
+#define HTTPC_ERROR_READ_TIMEOUT       (-11)
+
+typedef enum {
+  HTTPC_DISABLE_FOLLOW_REDIRECTS,
+  HTTPC_STRICT_FOLLOW_REDIRECTS,
+  HTTPC_FORCE_FOLLOW_REDIRECTS
+} followRedirects_t;
+
+class HTTPClient {
+ public:
+  bool begin(WiFiClient &client, const String &url) {
+    _client = &client;
+    _headers = String();
+    _size = -1;
+    _chunked = false;
+    int s = url.indexOf("://");
+    if (s < 0) return false;
+    String rest = url.substring(s + 3);
+    int slash = rest.indexOf('/');
+    _host = slash < 0 ? rest : rest.substring(0, slash);
+    _path = slash < 0 ? String("/") : rest.substring(slash);
+    int colon = _host.indexOf(':');
+    _port = 443;
+    if (colon >= 0) {
+      _port = (uint16_t)_host.substring(colon + 1).toInt();
+      _host = _host.substring(0, colon);
+    }
+    return _host.length() > 0;
+  }
+  void setReuse(bool reuse) { _reuse = reuse; }
+  void setTimeout(uint16_t ms) { _timeout = ms; }
+  void setConnectTimeout(int32_t) {}
+  void setFollowRedirects(followRedirects_t) {}
+  void setUserAgent(const String &ua) { _ua = ua; }
+  void useHTTP10(bool) {}
+
+  void addHeader(const String &name, const String &value, bool = false, bool = true) {
+    _headers += name + ": " + value + "\r\n";
+  }
+  void collectHeaders(const char *keys[], const size_t n) {
+    _keys.clear();
+    for (size_t i = 0; i < n; i++) _keys.push_back({ keys[i], String() });
+  }
+  String header(const char *name) {
+    for (auto &k : _keys) if (k.first.equalsIgnoreCase(name)) return k.second;
+    return String();
+  }
+  bool hasHeader(const char *name) { return header(name).length() > 0; }
+
+  int GET() {
+    if (!_client) return HTTPC_ERROR_CONNECTION_REFUSED;
+    if (!_client->connected() && !_client->connect(_host.c_str(), _port)) {
+      return HTTPC_ERROR_CONNECTION_REFUSED;
+    }
+    String req = String("GET ") + _path + " HTTP/1.1\r\nHost: " + _host +
+                 "\r\nUser-Agent: " + _ua + "\r\nConnection: keep-alive\r\n" + _headers + "\r\n";
+    if (_client->write((const uint8_t *)req.c_str(), req.length()) != req.length()) {
+      return fail(HTTPC_ERROR_SEND_HEADER_FAILED);
+    }
+    return readHead();
+  }
+
+  int getSize() { return _size; }
+
+  // Whole body as a String, de-chunked
+  String getString() {
+    String out;
+    uint8_t buf[256];
+    if (_chunked) {
+      for (;;) {
+        String line;
+        if (!readLine(line)) break;
+        long n = strtol(line.c_str(), nullptr, 16);
+        if (n <= 0) {
+          while (readLine(line) && line.length()) {}
+          break;
+        }
+        while (n > 0) {
+          int r = readSome(buf, std::min((long)sizeof(buf), n));
+          if (r <= 0) return out;
+          out.concat((const char *)buf, r);
+          n -= r;
+        }
+        readLine(line);
+      }
+      return out;
+    }
+    long left = _size;
+    while (left != 0) {
+      int r = readSome(buf, left < 0 ? (long)sizeof(buf) : std::min((long)sizeof(buf), left));
+      if (r <= 0) break;
+      out.concat((const char *)buf, r);
+      if (left > 0) left -= r;
+    }
+    return out;
+  }
+
+  void end() {
+    if (!_client) return;
+    if (_client->connected()) {
+      if (_client->available() > 0) _client->flush();
+      if (!(_reuse && _canReuse)) _client->stop();
+    }
+  }
+
+  static String errorToString(int error) { return String("HTTPC error ") + error; }
+
+ private:
+  int fail(int code) {
+    _client->stop();
+    return code;
+  }
+
+  // Next byte, waiting up to the timeout. -1 on timeout, -2 on close.
+  int readByte() {
+    unsigned long t0 = millis();
+    while (_client->available() <= 0) {
+      if (!_client->connected()) return -2;
+      if (millis() - t0 > _timeout) return -1;
+      delay(10);
+    }
+    return _client->read();
+  }
+  int readSome(uint8_t *buf, long len) {
+    int c = readByte();
+    if (c < 0) return -1;
+    buf[0] = (uint8_t)c;
+    int avail = _client->available();
+    int more = avail > 0 ? _client->read(buf + 1, std::min((long)avail, len - 1)) : 0;
+    return 1 + (more > 0 ? more : 0);
+  }
+  bool readLine(String &line) {
+    line = String();
+    for (;;) {
+      int c = readByte();
+      if (c < 0) { _lastErr = c; return false; }
+      if (c == '\n') return true;
+      if (c != '\r') line += (char)c;
+    }
+  }
+
+  int readHead() {
+    String line;
+    for (auto &k : _keys) k.second = String();
+    _size = -1;
+    _chunked = false;
+    _canReuse = true;
+    if (!readLine(line)) return fail(_lastErr == -1 ? HTTPC_ERROR_READ_TIMEOUT : HTTPC_ERROR_CONNECTION_LOST);
+    if (!line.startsWith("HTTP/1.")) return fail(HTTPC_ERROR_NO_HTTP_SERVER);
+    if (line[7] == '0') _canReuse = false;
+    int code = line.substring(9).toInt();
+    for (;;) {
+      if (!readLine(line)) return fail(_lastErr == -1 ? HTTPC_ERROR_READ_TIMEOUT : HTTPC_ERROR_CONNECTION_LOST);
+      if (!line.length()) break;
+      int colon = line.indexOf(':');
+      if (colon < 0) continue;
+      String name = line.substring(0, colon), value = line.substring(colon + 1);
+      value.trim();
+      if (name.equalsIgnoreCase("Content-Length")) _size = value.toInt();
+      if (name.equalsIgnoreCase("Transfer-Encoding") && value.indexOf("chunked") >= 0) _chunked = true;
+      if (name.equalsIgnoreCase("Connection") && value.indexOf("close") >= 0) _canReuse = false;
+      for (auto &k : _keys) if (k.first.equalsIgnoreCase(name.c_str())) k.second = value;
+    }
+    return code;
+  }
+
+  WiFiClient   *_client = nullptr;
+  String        _host, _path, _headers, _ua = "ESP32HTTPClient";
+  uint16_t      _port = 443;
+  uint16_t      _timeout = 5000;
+  bool          _reuse = true, _canReuse = true, _chunked = false;
+  int           _size = -1, _lastErr = 0;
+  std::vector<std::pair<String, String>> _keys;
+};
@@ -0,0 +1,415 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// Host stand-in for bitbank2/JPEGDEC
+//
+// Same API, callbacks and I/O pattern as the real decoder, but for "stand-in
+// JPEGs" built by jpegStandInFile(): a real marker layout (SOI, APP0, DQT,
+// SOF0, DHT, SOS ... EOI) whose entropy data is a fixed number of bytes per
+// MCU. Each MCU carries its flat colour followed by a checkable filler
+// pattern, so a decode fails on any byte lost, repeated or reordered by the
+// stream underneath it — which is what these tests need to prove. A
+// "detailed" stand-in adds per-pixel texture on top of each MCU's colour
+// (jpegStandInPixel), and a scaled decode of it runs a real reduced IDCT on
+// every 8x8 block, so its output differs from a plain area average the way
+// JPEGDEC's 4x4 / 2x2 / DC-only IDCTs do.
+//
+// Like JPEGDEC it reads through a 2 KB file buffer: the header is parsed out
+// of the first read, then it seeks back to the start of the scan and refills
+// the buffer as the MCUs consume it. Draw callbacks get batches of MCUs in
+// one or (with JPEG_USES_DMA) alternating halves of a 4096-pixel buffer,
+// honouring setCropArea(), the scale options and the pixel type.
+//
+// Decoding is not free on the board, so each MCU costs clock time:
+// jpeg_native_us_idct when it is drawn, jpeg_native_us_walk when it is only
+// entropy-decoded (outside the crop area). Both are adjustable per test. A
+// scaled decode still walks every MCU but runs a smaller IDCT (4x4, 2x2, DC
+// only) on fewer pixels, so the part above the walk shrinks with the output.
+// ---------------------------------------------------------------------------
+#include <Arduino.h>
+
+#define JPEG_AUTO_ROTATE    1
+#define JPEG_SCALE_HALF     2
+#define JPEG_SCALE_QUARTER  4
+#define JPEG_SCALE_EIGHTH   8
+#define JPEG_LE_PIXELS      16
+#define JPEG_EXIF_THUMBNAIL 32
+#define JPEG_LUMA_ONLY      64
+#define JPEG_USES_DMA       128
+
+#define RGB565_LITTLE_ENDIAN 0
+#define RGB565_BIG_ENDIAN    1
+
+#define JPEG_SUCCESS             0
+#define JPEG_INVALID_PARAMETER   1
+#define JPEG_DECODE_ERROR        2
+#define JPEG_UNSUPPORTED_FEATURE 3
+#define JPEG_INVALID_FILE        4
+
+#define JPEG_FILE_BUF_SIZE   2048
+#define MAX_BUFFERED_PIXELS  4096
+
+typedef struct jpeg_file_tag {
+  int32_t  iPos;
+  int32_t  iSize;
+  uint8_t *pData;
+  void    *fHandle;
+} JPEGFILE;
+
+typedef struct jpeg_draw_tag {
+  int       x, y;
+  int       iWidth, iHeight;
+  int       iWidthUsed;
+  int       iBpp;
+  uint16_t *pPixels;
+  void     *pUser;
+} JPEGDRAW;
+
+typedef int     (JPEG_DRAW_CALLBACK)(JPEGDRAW *pDraw);
+typedef int32_t (JPEG_READ_CALLBACK)(JPEGFILE *pFile, uint8_t *pBuf, int32_t iLen);
+typedef int32_t (JPEG_SEEK_CALLBACK)(JPEGFILE *pFile, int32_t iPosition);
+typedef void    (JPEG_CLOSE_CALLBACK)(void *pHandle);
+
+// Clock cost per MCU (see above)
+inline unsigned jpeg_native_us_idct = 150;
+inline unsigned jpeg_native_us_walk = 40;
+
+// Per-decode statistics
+struct JpegNativeStats {
+  uint32_t mcus_drawn, mcus_walked, draws, bytes_read, seeks_back;
+};
+inline JpegNativeStats jpeg_native_stats;
+
+// Pixel (x, y) of a detailed stand-in whose MCU there has colour base: a
+// ramp across each MCU plus a hash, a few LSB per channel
+inline uint16_t jpegStandInPixel(uint16_t base, int x, int y) {
+  const uint32_t n = (uint32_t)(x * 73856093u) ^ (uint32_t)(y * 19349663u);
+  const int r = (base >> 11) + ((x & 15) >> 2) - 2 + (int)(n & 3) - 1;
+  const int g = ((base >> 5) & 63) + ((y & 15) >> 1) - 4 + (int)((n >> 2) & 7) - 3;
+  const int b = (base & 31) + (((x + y) & 15) >> 2) - 2 + (int)((n >> 5) & 3) - 1;
+  return (uint16_t)((std::clamp(r, 0, 31) << 11) | (std::clamp(g, 0, 63) << 5) | std::clamp(b, 0, 31));
+}
+
+// A stand-in JPEG: w x h, MCUs of mcu x mcu pixels (8 or 16), `per_mcu`
+// entropy bytes each, MCU (mx, my) filled with color(mx, my), flat or
+// (detailed) textured by jpegStandInPixel
+template <class ColorFn>
+std::string jpegStandInFile(int w, int h, int mcu, int per_mcu, ColorFn color, bool detailed = false) {
+  std::string f = "\xFF\xD8";
+  auto seg = [&](uint8_t marker, const std::string &body) {
+    f += (char)0xFF;
+    f += (char)marker;
+    f += (char)((body.size() + 2) >> 8);
+    f += (char)((body.size() + 2) & 0xFF);
+    f += body;
+  };
+  seg(0xE0, std::string("JFIF\0\x01\x01\0\0\x01\0\x01\0\0", 14));
+  seg(0xE9, std::string("STANDIN\0", 8) + (char)(per_mcu >> 8) + (char)(per_mcu & 0xFF) +
+              (detailed ? std::string(1, '\x01') : std::string()));
+  seg(0xDB, std::string(65, '\x10'));
+  std::string sof = "\x08";
+  sof += (char)(h >> 8); sof += (char)(h & 0xFF);
+  sof += (char)(w >> 8); sof += (char)(w & 0xFF);
+  sof += std::string("\x03\x01", 2) + (char)(mcu == 16 ? 0x22 : 0x11) + std::string("\x00\x02\x11\x01\x03\x11\x01", 7);
+  seg(0xC0, sof);
+  seg(0xC4, std::string(28, '\x01'));
+  seg(0xDA, std::string("\x03\x01\x00\x02\x11\x03\x11\x00\x3F\x00", 10));
+  const int mw = (w + mcu - 1) / mcu, mh = (h + mcu - 1) / mcu;
+  for (int my = 0; my < mh; my++) {
+    for (int mx = 0; mx < mw; mx++) {
+      uint16_t c = color(mx, my);
+      f += (char)(c >> 11);
+      f += (char)((c >> 5) & 0x3F);
+      f += (char)(c & 0x1F);
+      int n = my * mw + mx;
+      for (int i = 3; i < per_mcu; i++) f += (char)((n * 31 + i) & 0x7F);
+    }
+  }
+  f += "\xFF\xD9";
+  return f;
+}
+
+class JPEGDEC {
+ public:
+  int openRAM(uint8_t *pData, int iDataSize, JPEG_DRAW_CALLBACK *pfnDraw) {
+    reset();
+    _file.pData = pData;
+    _file.iSize = iDataSize;
+    _read  = ram_read;
+    _seek  = ram_seek;
+    _close = nullptr;
+    _draw  = pfnDraw;
+    return parse();
+  }
+  int open(void *fHandle, int iDataSize, JPEG_CLOSE_CALLBACK *pfnClose, JPEG_READ_CALLBACK *pfnRead,
+           JPEG_SEEK_CALLBACK *pfnSeek, JPEG_DRAW_CALLBACK *pfnDraw) {
+    reset();
+    _file.fHandle = fHandle;
+    _file.iSize   = iDataSize;
+    _read  = pfnRead;
+    _seek  = pfnSeek;
+    _close = pfnClose;
+    _draw  = pfnDraw;
+    return parse();
+  }
+  void close() {
+    if (_close) _close(_file.fHandle);
+    _close = nullptr;
+  }
+
+  int getWidth() { return _w; }
+  int getHeight() { return _h; }
+  int getLastError() { return _err; }
+  int getBpp() { return 24; }
+  int getSubSample() { return _mcu == 16 ? 0x22 : 0x11; }
+  int getOrientation() { return 0; }
+  void setPixelType(int t) { _pixelType = t; }
+  void setUserPointer(void *p) { _user = p; }
+  void setMaxOutputSize(int) {}
+
+  // Rounded out to whole MCUs and clipped to the image, like JPEGDEC
+  void setCropArea(int x, int y, int w, int h) {
+    int x1 = std::min(_w, x + w), y1 = std::min(_h, y + h);
+    _cx = (x / _mcu) * _mcu;
+    _cy = (y / _mcu) * _mcu;
+    _cw = std::min(_w, ((x1 + _mcu - 1) / _mcu) * _mcu) - _cx;
+    _ch = std::min(_h, ((y1 + _mcu - 1) / _mcu) * _mcu) - _cy;
+  }
+  void getCropArea(int *x, int *y, int *w, int *h) {
+    *x = _cx; *y = _cy; *w = _cw; *h = _ch;
+  }
+
+  int decode(int x, int y, int options) {
+    const int shift = (options & JPEG_SCALE_EIGHTH) ? 3 : (options & JPEG_SCALE_QUARTER) ? 2
+                    : (options & JPEG_SCALE_HALF) ? 1 : 0;
+    const bool dma = options & JPEG_USES_DMA;
+    const int ow = _mcu >> shift;                      // output pixels per MCU side
+    const int mw = (_w + _mcu - 1) / _mcu, mh = (_h + _mcu - 1) / _mcu;
+    const int mx0 = _cx / _mcu, my0 = _cy / _mcu;
+    const int mx1 = (_cx + _cw + _mcu - 1) / _mcu, my1 = (_cy + _ch + _mcu - 1) / _mcu;
+    const unsigned idct = jpeg_native_us_walk + ((jpeg_native_us_idct - jpeg_native_us_walk) >> (2 * shift));
+    int batch = MAX_BUFFERED_PIXELS / (ow * ow);
+    if (dma) batch /= 2;
+    batch = std::max(1, batch);
+
+    if (_seek(&_file, _scan) != _scan) { _err = JPEG_INVALID_FILE; return 0; }
+    _file.iPos = _scan;
+    _have = _used = 0;
+    int half = 0;
+    for (int my = 0; my < mh; my++) {
+      bool rowDrawn = my >= my0 && my < my1;
+      int  n = 0, bx = 0;
+      uint32_t cost = 0;
+      uint16_t *px = _pixels + (dma ? half * (MAX_BUFFERED_PIXELS / 2) : 0);
+      for (int mx = 0; mx < mw; mx++) {
+        uint16_t c;
+        if (!mcu(my * mw + mx, &c)) return 0;
+        bool drawn = rowDrawn && mx >= mx0 && mx < mx1;
+        cost += drawn ? idct : jpeg_native_us_walk;
+        if (!drawn) { jpeg_native_stats.mcus_walked++; continue; }
+        jpeg_native_stats.mcus_drawn++;
+        if (!n) bx = mx;
+        const int stride = batch * ow;
+        if (_detail) {
+          detailed(mx, my, c, shift, px + n * ow, stride);
+        } else {
+          if (_pixelType == RGB565_BIG_ENDIAN) c = (uint16_t)((c << 8) | (c >> 8));
+          for (int r = 0; r < ow; r++)
+            for (int i = 0; i < ow; i++) px[r * stride + n * ow + i] = c;
+        }
+        if (++n == batch || mx + 1 == mx1) {
+          // Flush a batch: repack rows to the batch's real width
+          const int wpx = n * ow;
+          if (n < batch)
+            for (int r = 1; r < ow; r++) memmove(px + r * wpx, px + r * stride, wpx * sizeof(uint16_t));
+          delayMicroseconds(cost);
+          cost = 0;
+          JPEGDRAW d;
+          d.x = x + ((bx - mx0) * _mcu >> shift);
+          d.y = y + ((my - my0) * _mcu >> shift);
+          d.iWidth = wpx;
+          d.iHeight = ow;
+          d.iWidthUsed = std::min(wpx, ((_cx + _cw) >> shift) - (bx * _mcu >> shift));
+          d.iBpp = 16;
+          d.pPixels = px;
+          d.pUser = _user;
+          jpeg_native_stats.draws++;
+          if (!_draw(&d)) return 0;
+          n = 0;
+          if (dma) half ^= 1;
+          px = _pixels + (dma ? half * (MAX_BUFFERED_PIXELS / 2) : 0);
+        }
+      }
+      delayMicroseconds(cost);
+    }
+    return 1;
+  }
+
+ private:
+  static int32_t ram_read(JPEGFILE *f, uint8_t *buf, int32_t len) {
+    int32_t n = std::max(0, std::min(len, f->iSize - f->iPos));
+    memcpy(buf, f->pData + f->iPos, n);
+    f->iPos += n;
+    return n;
+  }
+  static int32_t ram_seek(JPEGFILE *f, int32_t pos) {
+    f->iPos = std::max(0, std::min(pos, f->iSize));
+    return f->iPos;
+  }
+
+  void reset() {
+    _file = JPEGFILE();
+    _w = _h = 0;
+    _err = JPEG_SUCCESS;
+    _detail = false;
+    _cx = _cy = 0;
+    _cw = _ch = 0x7FFF;
+    _user = nullptr;
+    jpeg_native_stats = JpegNativeStats();
+  }
+
+  int32_t fill(uint8_t *buf, int32_t len) {
+    int32_t n = _read(&_file, buf, len);
+    if (n > 0) jpeg_native_stats.bytes_read += n;
+    return n;
+  }
+
+  // Header: one buffer read, markers parsed in place (seeking past any
+  // segment that runs beyond it), then back to the start of the scan
+  int parse() {
+    int32_t base = 0;
+    int32_t have = fill(_buf, JPEG_FILE_BUF_SIZE);
+    if (have < 4 || _buf[0] != 0xFF || _buf[1] != 0xD8) { _err = JPEG_INVALID_FILE; return 0; }
+    int32_t off = 2;
+    int per_mcu = 0;
+    for (;;) {
+      if (off + 4 > have) {
+        base += off;
+        if (_seek(&_file, base) != base) { _err = JPEG_INVALID_FILE; return 0; }
+        _file.iPos = base;
+        have = fill(_buf, JPEG_FILE_BUF_SIZE);
+        off = 0;
+        if (have < 4) { _err = JPEG_INVALID_FILE; return 0; }
+      }
+      if (_buf[off] != 0xFF) { _err = JPEG_INVALID_FILE; return 0; }
+      uint8_t m = _buf[off + 1];
+      int len = (_buf[off + 2] << 8) | _buf[off + 3];
+      if (off + 2 + len > have) {
+        // Segment body runs past the buffer: reread from its start
+        base += off;
+        if (_seek(&_file, base) != base) { _err = JPEG_INVALID_FILE; return 0; }
+        _file.iPos = base;
+        have = fill(_buf, JPEG_FILE_BUF_SIZE);
+        off = 0;
+        if (2 + len > have) { _err = JPEG_INVALID_FILE; return 0; }
+      }
+      const uint8_t *p = _buf + off + 4;
+      if (m == 0xC2) { _err = JPEG_UNSUPPORTED_FEATURE; return 0; }
+      if (m == 0xC0) {
+        _h = (p[1] << 8) | p[2];
+        _w = (p[3] << 8) | p[4];
+        _mcu = p[7] == 0x22 ? 16 : 8;
+      }
+      if (m == 0xE9 && !memcmp(p, "STANDIN", 8)) {
+        per_mcu = (p[8] << 8) | p[9];
+        _detail = len - 2 > 10 && (p[10] & 1);
+      }
+      off += 2 + len;
+      if (m == 0xDA) break;
+    }
+    if (!_w || !_h || per_mcu < 3) { _err = JPEG_INVALID_FILE; return 0; }
+    _per_mcu = per_mcu;
+    _scan = base + off;
+    if (base + have > _scan) jpeg_native_stats.seeks_back++;   // decode() rewinds to here
+    _cw = std::min(_cw, _w);
+    _ch = std::min(_ch, _h);
+    return 1;
+  }
+
+  // Next entropy byte through the file buffer, -1 at end of data
+  int next() {
+    if (_used == _have) {
+      _have = fill(_buf, JPEG_FILE_BUF_SIZE);
+      _used = 0;
+      if (_have <= 0) { _have = 0; return -1; }
+    }
+    return _buf[_used++];
+  }
+
+  // Output pixels of MCU (mx, my) of a detailed stand-in, at 1/2^shift: the
+  // pixels themselves at full size, else per 8x8 block and channel the
+  // (8 >> shift)^2 lowest DCT coefficients through an IDCT of that size
+  void detailed(int mx, int my, uint16_t base, int shift, uint16_t *out, int stride) {
+    static const int full[3] = { 31, 63, 31 };
+    const int n = 8 >> shift;
+    for (int by = 0; by < _mcu; by += 8)
+      for (int bx = 0; bx < _mcu; bx += 8) {
+        double f[3][8][8], v[3][8][8];
+        for (int j = 0; j < 8; j++)
+          for (int i = 0; i < 8; i++) {
+            const uint16_t c = jpegStandInPixel(base, mx * _mcu + bx + i, my * _mcu + by + j);
+            f[0][j][i] = v[0][j][i] = c >> 11;
+            f[1][j][i] = v[1][j][i] = (c >> 5) & 63;
+            f[2][j][i] = v[2][j][i] = c & 31;
+          }
+        if (shift) {
+          for (int k = 0; k < 3; k++) {
+            double F[8][8];
+            for (int q = 0; q < n; q++)
+              for (int u = 0; u < n; u++) {
+                F[q][u] = 0;
+                for (int j = 0; j < 8; j++)
+                  for (int i = 0; i < 8; i++) F[q][u] += f[k][j][i] * dct_cos(8, u, i) * dct_cos(8, q, j);
+              }
+            for (int b = 0; b < n; b++)
+              for (int a = 0; a < n; a++) {
+                double s = 0;
+                for (int q = 0; q < n; q++)
+                  for (int u = 0; u < n; u++) s += F[q][u] * dct_cos(n, u, a) * dct_cos(n, q, b);
+                v[k][b][a] = s * n / 8;
+              }
+          }
+        }
+        uint16_t *o = out + (by >> shift) * stride + (bx >> shift);
+        for (int b = 0; b < n; b++)
+          for (int a = 0; a < n; a++) {
+            int ch[3];
+            for (int k = 0; k < 3; k++) ch[k] = std::clamp((int)lround(v[k][b][a]), 0, full[k]);
+            uint16_t c = (uint16_t)((ch[0] << 11) | (ch[1] << 5) | ch[2]);
+            if (_pixelType == RGB565_BIG_ENDIAN) c = (uint16_t)((c << 8) | (c >> 8));
+            o[b * stride + a] = c;
+          }
+      }
+  }
+
+  // Orthonormal DCT-II basis of size n: c(u) sqrt(2/n) cos(pi (2i+1) u / 2n)
+  static double dct_cos(int n, int u, int i) {
+    return (u ? 1.0 : M_SQRT1_2) * sqrt(2.0 / n) * cos(M_PI * (2 * i + 1) * u / (2.0 * n));
+  }
+
+  // Entropy-decode MCU n: its colour, and a check of every filler byte
+  bool mcu(int n, uint16_t *color) {
+    int b[3];
+    for (int i = 0; i < 3; i++) b[i] = next();
+    if (b[0] < 0 || b[1] < 0 || b[2] < 0) { _err = JPEG_DECODE_ERROR; return false; }
+    *color = (uint16_t)((b[0] << 11) | (b[1] << 5) | b[2]);
+    for (int i = 3; i < _per_mcu; i++) {
+      if (next() != ((n * 31 + i) & 0x7F)) { _err = JPEG_DECODE_ERROR; return false; }
+    }
+    return true;
+  }
+
+  JPEGFILE             _file;
+  JPEG_READ_CALLBACK  *_read  = nullptr;
+  JPEG_SEEK_CALLBACK  *_seek  = nullptr;
+  JPEG_CLOSE_CALLBACK *_close = nullptr;
+  JPEG_DRAW_CALLBACK  *_draw  = nullptr;
+  void    *_user = nullptr;
+  int      _w = 0, _h = 0, _mcu = 16, _per_mcu = 0, _err = 0;
+  bool     _detail = false;
+  int      _cx = 0, _cy = 0, _cw = 0, _ch = 0;
+  int      _pixelType = RGB565_LITTLE_ENDIAN;
+  int32_t  _scan = 0, _have = 0, _used = 0;
+  uint8_t  _buf[JPEG_FILE_BUF_SIZE];
+  uint16_t _pixels[MAX_BUFFERED_PIXELS];
+};
@@ -0,0 +1,107 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// Heap accounting for the native tests (glibc hosts)
+//
+// Include once in a test to route malloc/free through a counter, so
+// ESP.getFreeHeap() falls as the firmware allocates and native_heap_peak
+// records the high-water mark. Allocations made inside a NativeHeapExempt
+// scope (the stand-in server) are not counted.
+// ---------------------------------------------------------------------------
+#include <Arduino.h>
+
+#if defined(__GLIBC__)
+#define NATIVE_HEAP_TRACKED 1
+
+extern "C" {
+void *__libc_malloc(size_t);
+void *__libc_calloc(size_t, size_t);
+void *__libc_realloc(void *, size_t);
+void  __libc_free(void *);
+void *__libc_memalign(size_t, size_t);
+}
+
+// Sits in front of every block
+struct alignas(16) NativeBlock {
+  void    *base;
+  size_t   size;
+  bool     counted;
+  uint32_t magic;
+};
+#define NATIVE_BLOCK_MAGIC 0x4E484541u
+
+static inline void *native_block_init(void *base, void *user, size_t n) {
+  NativeBlock *b = (NativeBlock *)user - 1;
+  b->base    = base;
+  b->size    = n;
+  b->magic   = NATIVE_BLOCK_MAGIC;
+  b->counted = native_heap_exempt == 0;
+  if (b->counted) {
+    int64_t used = native_heap_used += (int64_t)n;
+    int64_t peak = native_heap_peak.load();
+    while (used > peak && !native_heap_peak.compare_exchange_weak(peak, used)) {}
+  }
+  return user;
+}
+
+static inline NativeBlock *native_block_of(void *p) {
+  return (NativeBlock *)p - 1;
+}
+
+extern "C" {
+void *malloc(size_t n) {
+  void *base = __libc_malloc(n + sizeof(NativeBlock));
+  return base ? native_block_init(base, (NativeBlock *)base + 1, n) : nullptr;
+}
+
+void free(void *p) {
+  if (!p) return;
+  NativeBlock *b = native_block_of(p);
+  if (b->counted) native_heap_used -= (int64_t)b->size;
+  b->magic = 0;
+  __libc_free(b->base);
+}
+
+void *calloc(size_t n, size_t k) {
+  void *p = malloc(n * k);
+  if (p) memset(p, 0, n * k);
+  return p;
+}
+
+void *realloc(void *p, size_t n) {
+  if (!p) return malloc(n);
+  if (!n) { free(p); return nullptr; }
+  void *q = malloc(n);
+  if (!q) return nullptr;
+  memcpy(q, p, std::min(n, native_block_of(p)->size));
+  free(p);
+  return q;
+}
+
+void *memalign(size_t align, size_t n) {
+  if (align < alignof(NativeBlock)) align = alignof(NativeBlock);
+  void *base = __libc_memalign(align, n + align + sizeof(NativeBlock));
+  if (!base) return nullptr;
+  uintptr_t user = ((uintptr_t)base + sizeof(NativeBlock) + align - 1) & ~(uintptr_t)(align - 1);
+  return native_block_init(base, (void *)user, n);
+}
+
+void *aligned_alloc(size_t align, size_t n) { return memalign(align, n); }
+
+int posix_memalign(void **out, size_t align, size_t n) {
+  *out = memalign(align, n);
+  return *out ? 0 : 12;  // ENOMEM
+}
+
+size_t malloc_usable_size(void *p) { return p ? native_block_of(p)->size : 0; }
+}
+
+#else
+#define NATIVE_HEAP_TRACKED 0
+#endif
+
+// Start a new high-water mark from the current use
+inline void nativeHeapPeakReset() { native_heap_peak = native_heap_used.load(); }
+
+// Bytes in use above `base` at the high-water mark
+inline int64_t nativeHeapPeakAbove(int64_t base) { return native_heap_peak.load() - base; }
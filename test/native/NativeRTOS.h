@@ -0,0 +1,270 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// FreeRTOS stand-in: tasks, queues and semaphores on the virtual clock
+//
+// Every task is a host thread, but only one runs at a time. A task runs until
+// it blocks — delay(), or a queue/semaphore wait — and the next runnable task
+// takes over; when none is runnable the clock jumps to the earliest wake-up.
+// Two cores doing work in parallel therefore look the same as on the board
+// (a 40 ms push on one does not hold up the other), runs are deterministic,
+// and a test that drives loop() sees exactly how long loop() was held up.
+//
+// Code that only computes takes no virtual time: whatever should cost time
+// on the board (SPI traffic, decoding) says so with delayMicroseconds().
+// The test's main thread is task 0. Tasks are never deleted; they stay
+// blocked in their loops when the test ends.
+// ---------------------------------------------------------------------------
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef void    *TaskHandle_t;
+typedef int      BaseType_t;
+typedef unsigned UBaseType_t;
+typedef uint32_t TickType_t;
+typedef void   (*TaskFunction_t)(void *);
+
+#define pdTRUE             1
+#define pdFALSE            0
+#define pdPASS             1
+#define portMAX_DELAY      0xFFFFFFFFu
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms)  ((TickType_t)(ms))
+#define tskNO_AFFINITY     0x7FFFFFFF
+
+#define NATIVE_FOREVER UINT64_MAX
+
+struct NativeTask {
+  const char  *name;
+  bool         blocked    = false;
+  const void  *waiting_on = nullptr;   // object whose change wakes it
+  uint64_t     wake_us    = NATIVE_FOREVER;
+  uint64_t     busy_us    = 0;         // time spent in delay()/delayMicroseconds()
+};
+
+struct NativeSim {
+  std::mutex                m;
+  std::condition_variable   cv;
+  std::vector<NativeTask *> tasks{ new NativeTask{ "main" } };
+  size_t                    running = 0;
+};
+
+inline NativeSim &nativeSim() {
+  static NativeSim *s = new NativeSim;   // never destroyed: tasks outlive main()
+  return *s;
+}
+inline thread_local size_t native_self = 0;
+
+// Pick the next task to run (lock held): round robin from the caller, the
+// clock moving forward only when every task is blocked
+inline void native_switch(std::unique_lock<std::mutex> &lk) {
+  NativeSim &s = nativeSim();
+  const size_t n = s.tasks.size();
+  for (;;) {
+    for (size_t i = 1; i <= n; i++) {
+      size_t k = (native_self + i) % n;
+      if (!s.tasks[k]->blocked) {
+        s.running = k;
+        s.cv.notify_all();
+        s.cv.wait(lk, [&] { return s.running == native_self; });
+        return;
+      }
+    }
+    uint64_t next = NATIVE_FOREVER;
+    for (NativeTask *t : s.tasks) next = std::min(next, t->wake_us);
+    if (next == NATIVE_FOREVER) {
+      fprintf(stderr, "[NativeRTOS] every task is blocked forever (in %s)\n", s.tasks[native_self]->name);
+      abort();
+    }
+    if (next > native_clock_us) native_clock_us = next;
+    for (NativeTask *t : s.tasks) {
+      if (t->blocked && t->wake_us <= native_clock_us) {
+        t->blocked = false;
+        t->wake_us = NATIVE_FOREVER;
+      }
+    }
+  }
+}
+
+// Block the calling task until `obj` is signalled or the clock reaches
+// wake_us (lock held)
+inline void native_block(std::unique_lock<std::mutex> &lk, const void *obj, uint64_t wake_us) {
+  NativeTask *t = nativeSim().tasks[native_self];
+  t->blocked    = true;
+  t->waiting_on = obj;
+  t->wake_us    = wake_us;
+  native_switch(lk);
+  t->waiting_on = nullptr;
+}
+
+// Wake every task waiting on obj (lock held); the caller keeps running
+inline void native_signal(const void *obj) {
+  for (NativeTask *t : nativeSim().tasks) {
+    if (t->blocked && t->waiting_on == obj) {
+      t->blocked = false;
+      t->wake_us = NATIVE_FOREVER;
+    }
+  }
+}
+
+inline void native_sleep_us(uint64_t us) {
+  std::unique_lock<std::mutex> lk(nativeSim().m);
+  nativeSim().tasks[native_self]->busy_us += us;
+  native_block(lk, nullptr, native_clock_us + us);
+}
+
+inline uint64_t native_deadline(TickType_t ticks) {
+  return ticks == portMAX_DELAY ? NATIVE_FOREVER : native_clock_us + (uint64_t)ticks * 1000;
+}
+
+// ── Tasks ────────────────────────────────────────────────────────────────────
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t, void *arg,
+                                          UBaseType_t, TaskHandle_t *handle, BaseType_t) {
+  NativeSim &s = nativeSim();
+  std::lock_guard<std::mutex> g(s.m);
+  const size_t id = s.tasks.size();
+  NativeTask *t = new NativeTask{ name };
+  s.tasks.push_back(t);
+  if (handle) *handle = t;
+  std::thread([=] {
+    native_self = id;
+    {
+      std::unique_lock<std::mutex> lk(nativeSim().m);
+      nativeSim().cv.wait(lk, [&] { return nativeSim().running == id; });
+    }
+    fn(arg);
+    fprintf(stderr, "[NativeRTOS] task %s returned\n", name);
+    abort();
+  }).detach();
+  return pdPASS;
+}
+inline BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack, void *arg,
+                              UBaseType_t prio, TaskHandle_t *handle) {
+  return xTaskCreatePinnedToCore(fn, name, stack, arg, prio, handle, tskNO_AFFINITY);
+}
+inline void       vTaskDelay(TickType_t ticks) { native_sleep_us((uint64_t)ticks * 1000); }
+inline TickType_t xTaskGetTickCount() { return (TickType_t)(native_clock_us / 1000); }
+inline BaseType_t xPortGetCoreID() { return native_self == 0 ? 1 : 0; }
+inline UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t) { return 1024; }
+
+// Time a task spent in delay()/delayMicroseconds(), by name ("main" = the test)
+inline uint64_t nativeTaskBusyUs(const char *name) {
+  std::lock_guard<std::mutex> g(nativeSim().m);
+  for (NativeTask *t : nativeSim().tasks) if (!strcmp(t->name, name)) return t->busy_us;
+  return 0;
+}
+
+// ── Queues ───────────────────────────────────────────────────────────────────
+struct NativeQueue {
+  size_t item, cap;
+  std::deque<std::vector<uint8_t>> items;
+};
+typedef NativeQueue *QueueHandle_t;
+
+inline QueueHandle_t xQueueCreate(UBaseType_t len, UBaseType_t item) {
+  NativeHeapExempt exempt;   // FreeRTOS objects are not part of the firmware's budget here
+  return new NativeQueue{ item, len, {} };
+}
+
+inline BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t ticks) {
+  std::unique_lock<std::mutex> lk(nativeSim().m);
+  const uint64_t deadline = native_deadline(ticks);
+  while (q->items.size() >= q->cap) {
+    if (native_clock_us >= deadline) return pdFALSE;
+    native_block(lk, q, deadline);
+  }
+  NativeHeapExempt exempt;
+  q->items.emplace_back((const uint8_t *)item, (const uint8_t *)item + q->item);
+  native_signal(q);
+  return pdTRUE;
+}
+inline BaseType_t xQueueSendToBack(QueueHandle_t q, const void *item, TickType_t ticks) {
+  return xQueueSend(q, item, ticks);
+}
+
+inline BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t ticks) {
+  std::unique_lock<std::mutex> lk(nativeSim().m);
+  const uint64_t deadline = native_deadline(ticks);
+  while (q->items.empty()) {
+    if (native_clock_us >= deadline) return pdFALSE;
+    native_block(lk, q, deadline);
+  }
+  NativeHeapExempt exempt;
+  memcpy(item, q->items.front().data(), q->item);
+  q->items.pop_front();
+  native_signal(q);
+  return pdTRUE;
+}
+
+inline UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) {
+  std::lock_guard<std::mutex> g(nativeSim().m);
+  return (UBaseType_t)q->items.size();
+}
+
+// ── Semaphores ───────────────────────────────────────────────────────────────
+struct NativeSemaphore {
+  int    count, max;
+  bool   recursive;
+  size_t owner;
+  int    depth;
+};
+typedef NativeSemaphore *SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateBinary() {
+  NativeHeapExempt exempt;
+  return new NativeSemaphore{ 0, 1, false, 0, 0 };
+}
+inline SemaphoreHandle_t xSemaphoreCreateMutex() {
+  NativeHeapExempt exempt;
+  return new NativeSemaphore{ 1, 1, false, 0, 0 };
+}
+inline SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() {
+  NativeHeapExempt exempt;
+  return new NativeSemaphore{ 1, 1, true, 0, 0 };
+}
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t ticks) {
+  std::unique_lock<std::mutex> lk(nativeSim().m);
+  const uint64_t deadline = native_deadline(ticks);
+  while (s->count == 0) {
+    if (native_clock_us >= deadline) return pdFALSE;
+    native_block(lk, s, deadline);
+  }
+  s->count--;
+  s->owner = native_self;
+  return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t s) {
+  std::lock_guard<std::mutex> g(nativeSim().m);
+  if (s->count >= s->max) return pdFALSE;
+  s->count++;
+  native_signal(s);
+  return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t s, TickType_t ticks) {
+  {
+    std::lock_guard<std::mutex> g(nativeSim().m);
+    if (s->depth > 0 && s->owner == native_self) {
+      s->depth++;
+      return pdTRUE;
+    }
+  }
+  if (xSemaphoreTake(s, ticks) != pdTRUE) return pdFALSE;
+  std::lock_guard<std::mutex> g(nativeSim().m);
+  s->depth = 1;
+  return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t s) {
+  {
+    std::lock_guard<std::mutex> g(nativeSim().m);
+    if (s->depth == 0 || s->owner != native_self) return pdFALSE;
+    if (--s->depth > 0) return pdTRUE;
+  }
+  return xSemaphoreGive(s);
+}
@@ -0,0 +1,240 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// Stand-ins for the services the firmware talks to
+//
+// api.weather.gov (points, gridpoint forecast, active alerts), the three
+// SWPC feeds, the CelesTrak ISS element set and the GOES CDN, answering with
+// bodies shaped like the real ones from the state in noaa(). A test changes
+// that state (a new alert, a re-gridded office, a new GOES frame) and the
+// next request sees it. Each host releases bodies in noaa().pace[host]
+// segments, so any of them can be made as slow as a bad day on the real
+// network. Register them with noaaServe(); a test can still replace any one
+// host's handler with its own.
+// ---------------------------------------------------------------------------
+#include "JPEGDEC.h"
+#include "StandIn.h"
+
+#define NOAA_NWS       "api.weather.gov"
+#define NOAA_SWPC      "services.swpc.noaa.gov"
+#define NOAA_CELESTRAK "celestrak.org"
+#define NOAA_GOES      "cdn.star.nesdis.noaa.gov"
+
+struct NoaaAlert {
+  std::string id, event, severity, headline;
+};
+
+// Bodies go out seg_bytes at a time, gap_ms apart (0 = all at once)
+struct NoaaPace {
+  size_t        seg_bytes = 1460;
+  unsigned long gap_ms    = 0;
+};
+
+struct NoaaState {
+  // api.weather.gov: /points answers with this grid, and only this grid's
+  // forecast exists (an old one 404s, as after NWS re-grids an office)
+  std::string office = "BOU";
+  int         grid_x = 63, grid_y = 62;
+  int         periods = 14;
+  std::string weather = "Sunny";            // first period's short forecast
+  std::vector<NoaaAlert> alerts;
+
+  // SWPC: rows per feed, latest Kp, and whether a suffix Range
+  // (bytes=-N) is answered 206 with the last N bytes or ignored (200)
+  int         swpc_rows  = 200;
+  std::string kp         = "3.33";
+  bool        swpc_range = false;
+
+  // CelesTrak: an ISS element set with this epoch (unix time), 0 = 404
+  time_t      tle_epoch = 0;
+
+  // GOES CDN: published frame per image path, served with ETag "v<n>"
+  std::map<std::string, int> goes_version;
+  int         goes_default_version = 1;
+
+  std::map<std::string, NoaaPace> pace;
+};
+
+inline NoaaState &noaa() {
+  static NoaaState s;
+  return s;
+}
+
+// ── Bodies ───────────────────────────────────────────────────────────────────
+inline std::string noaaGridPath(const NoaaState &s) {
+  return "/gridpoints/" + s.office + "/" + std::to_string(s.grid_x) + "," + std::to_string(s.grid_y);
+}
+
+inline std::string noaaPointsJson(const std::string &where) {
+  const NoaaState &s = noaa();
+  const std::string grid = "https://" NOAA_NWS + noaaGridPath(s);
+  return "{\"@context\":[\"https://geojson.org/geojson-ld/geojson-context.jsonld\"],"
+         "\"id\":\"https://" NOAA_NWS "/points/" + where + "\",\"type\":\"Feature\","
+         "\"geometry\":{\"type\":\"Point\",\"coordinates\":[-104.9903,39.7392]},"
+         "\"properties\":{\"@id\":\"https://" NOAA_NWS "/points/" + where + "\",\"cwa\":\"" + s.office + "\","
+         "\"forecastOffice\":\"https://" NOAA_NWS "/offices/" + s.office + "\",\"gridId\":\"" + s.office + "\","
+         "\"gridX\":" + std::to_string(s.grid_x) + ",\"gridY\":" + std::to_string(s.grid_y) + ","
+         "\"forecast\":\"" + grid + "/forecast\",\"forecastHourly\":\"" + grid + "/forecast/hourly\","
+         "\"forecastGridData\":\"" + grid + "\",\"observationStations\":\"" + grid + "/stations\","
+         "\"relativeLocation\":{\"type\":\"Feature\",\"properties\":{\"city\":\"Denver\",\"state\":\"CO\"}},"
+         "\"timeZone\":\"America/Denver\",\"radarStation\":\"KFTG\"}}";
+}
+
+inline std::string noaaForecastJson() {
+  const NoaaState &s = noaa();
+  static const char *const names[] = { "Tonight", "Monday", "Monday Night", "Tuesday", "Tuesday Night",
+                                       "Wednesday", "Wednesday Night", "Thursday", "Thursday Night",
+                                       "Friday", "Friday Night", "Saturday", "Saturday Night", "Sunday" };
+  std::string j = "{\"@context\":[\"https://geojson.org/geojson-ld/geojson-context.jsonld\"],"
+                  "\"type\":\"Feature\",\"geometry\":{\"type\":\"Polygon\",\"coordinates\":[[[-105.0,39.7],"
+                  "[-104.9,39.7],[-104.9,39.8],[-105.0,39.8],[-105.0,39.7]]]},\"properties\":{"
+                  "\"units\":\"us\",\"forecastGenerator\":\"BaselineForecastGenerator\","
+                  "\"generatedAt\":\"2026-06-21T18:04:12+00:00\",\"updateTime\":\"2026-06-21T17:32:05+00:00\","
+                  "\"elevation\":{\"unitCode\":\"wmoUnit:m\",\"value\":1609.6},\"periods\":[";
+  for (int i = 0; i < s.periods; i++) {
+    const std::string name = names[i % 14];
+    const std::string sky  = i == 0 ? s.weather : (i % 2 ? "Mostly Clear" : "Partly Sunny");
+    if (i) j += ",";
+    j += "{\"number\":" + std::to_string(i + 1) + ",\"name\":\"" + name + "\","
+         "\"startTime\":\"2026-06-21T18:00:00-06:00\",\"endTime\":\"2026-06-22T06:00:00-06:00\","
+         "\"isDaytime\":" + (i % 2 ? "false" : "true") + ",\"temperature\":" + std::to_string(58 + i) + ","
+         "\"temperatureUnit\":\"F\",\"temperatureTrend\":null,"
+         "\"probabilityOfPrecipitation\":{\"unitCode\":\"wmoUnit:percent\",\"value\":" + std::to_string(i * 5) + "},"
+         "\"windSpeed\":\"5 to 10 mph\",\"windDirection\":\"SSW\","
+         "\"icon\":\"https://" NOAA_NWS "/icons/land/day/few?size=medium\",\"shortForecast\":\"" + sky + "\","
+         "\"detailedForecast\":\"" + sky + ", with a high near " + std::to_string(58 + i) +
+         ". South southwest wind 5 to 10 mph, with gusts as high as 20 mph.\"}";
+  }
+  return j + "]}}";
+}
+
+inline std::string noaaAlertsJson() {
+  std::string j = "{\"@context\":[\"https://geojson.org/geojson-ld/geojson-context.jsonld\"],"
+                  "\"type\":\"FeatureCollection\",\"features\":[";
+  bool first = true;
+  for (const NoaaAlert &a : noaa().alerts) {
+    if (!first) j += ",";
+    first = false;
+    j += "{\"id\":\"https://" NOAA_NWS "/alerts/" + a.id + "\",\"type\":\"Feature\",\"geometry\":null,"
+         "\"properties\":{\"@id\":\"https://" NOAA_NWS "/alerts/" + a.id + "\",\"id\":\"" + a.id + "\","
+         "\"areaDesc\":\"Denver\",\"sent\":\"2026-06-21T17:50:00-06:00\",\"status\":\"Actual\","
+         "\"messageType\":\"Alert\",\"category\":\"Met\",\"severity\":\"" + a.severity + "\","
+         "\"certainty\":\"Likely\",\"urgency\":\"Expected\",\"event\":\"" + a.event + "\","
+         "\"senderName\":\"NWS Boulder CO\",\"headline\":\"" + a.headline + "\","
+         "\"description\":\"* WHAT...See the headline.\\n\\n* WHERE...Denver.\",\"instruction\":null}}";
+  }
+  return j + "],\"title\":\"Current watches, warnings, and advisories\",\"updated\":\"2026-06-21T18:00:00+00:00\"}";
+}
+
+// A SWPC product: header row then rows oldest first, the last one current
+inline std::string noaaSwpcJson(const std::string &path) {
+  const NoaaState &s = noaa();
+  std::string j;
+  if (path.find("k-index") != std::string::npos) {
+    j = "[[\"time_tag\",\"Kp\",\"a_running\",\"station_count\"]";
+    for (int i = 0; i < s.swpc_rows; i++)
+      j += ",[\"2026-06-21 " + std::string(i + 1 < s.swpc_rows ? "12" : "15") + ":00:00.000\",\"" +
+           (i + 1 < s.swpc_rows ? "2.00" : s.kp) + "\",\"7\",\"8\"]";
+  } else if (path.find("plasma") != std::string::npos) {
+    j = "[[\"time_tag\",\"density\",\"speed\",\"temperature\"]";
+    for (int i = 0; i < s.swpc_rows; i++) j += ",[\"2026-06-21 17:55:00.000\",\"4.12\",\"" + std::to_string(380 + i % 40) + ".4\",\"81234\"]";
+  } else {
+    j = "[[\"time_tag\",\"bx_gsm\",\"by_gsm\",\"bz_gsm\",\"lon_gsm\",\"lat_gsm\",\"bt\"]";
+    for (int i = 0; i < s.swpc_rows; i++) j += ",[\"2026-06-21 17:55:00.000\",\"1.02\",\"-3.40\",\"-" + std::to_string(i % 9) + ".15\",\"286.91\",\"-36.49\",\"5.71\"]";
+  }
+  return j + "]";
+}
+
+// The ISS element set with its epoch moved to `epoch` (checksums fixed up)
+inline std::string noaaIssTle(time_t epoch) {
+  std::string l1 = "1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927";
+  std::string l2 = "2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537";
+  struct tm tm;
+  gmtime_r(&epoch, &tm);
+  const double day = tm.tm_yday + 1 + (tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec) / 86400.0;
+  char f[16];
+  snprintf(f, sizeof(f), "%02d%012.8f", tm.tm_year % 100, day);
+  l1.replace(18, 14, f);
+  for (std::string *l : { &l1, &l2 }) {
+    int sum = 0;
+    for (int i = 0; i < 68; i++) sum += isdigit((unsigned char)(*l)[i]) ? (*l)[i] - '0' : (*l)[i] == '-';
+    (*l)[68] = (char)('0' + sum % 10);
+  }
+  return "ISS (ZARYA)             \r\n" + l1 + "\r\n" + l2 + "\r\n";
+}
+
+// GOES frame n for an image path, the size its name says. Every MCU's
+// colour changes between versions.
+inline const std::string &noaaGoesFrame(const std::string &path, int version) {
+  static std::map<std::string, std::string> files;
+  static int colour_version;
+  std::string &f = files[path + "#" + std::to_string(version)];
+  if (f.empty()) {
+    int w = 250, h = 250;
+    size_t x = path.rfind('x'), slash = path.rfind('/');
+    if (x != std::string::npos && slash != std::string::npos && x > slash) {
+      w = atoi(path.c_str() + slash + 1);
+      h = atoi(path.c_str() + x + 1);
+    }
+    colour_version = version;
+    f = jpegStandInFile(w, h, 16, 96, [](int mx, int my) {
+      return (uint16_t)(mx * 2113 + my * 977 + colour_version * 7919);
+    });
+  }
+  return f;
+}
+
+// ── Handlers ─────────────────────────────────────────────────────────────────
+inline StandInReply noaaPaced(const std::string &host, int code, const std::string &body,
+                              const std::string &extra = "") {
+  const NoaaPace p = noaa().pace[host];
+  StandInReply r;
+  r.send(standInHead(code, extra + "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n"));
+  if (!p.gap_ms) return r.send(body);
+  for (size_t i = 0, k = 1; i < body.size(); i += p.seg_bytes, k++) r.send(body.substr(i, p.seg_bytes), k * p.gap_ms);
+  return r;
+}
+
+inline StandInReply noaaNws(const StandInRequest &r) {
+  static const std::string json = "Content-Type: application/geo+json\r\n";
+  if (r.path.compare(0, 8, "/points/") == 0) return noaaPaced(NOAA_NWS, 200, noaaPointsJson(r.path.substr(8)), json);
+  if (r.path == noaaGridPath(noaa()) + "/forecast") return noaaPaced(NOAA_NWS, 200, noaaForecastJson(), json);
+  if (r.path.compare(0, 15, "/alerts/active?") == 0) return noaaPaced(NOAA_NWS, 200, noaaAlertsJson(), json);
+  return noaaPaced(NOAA_NWS, 404, "{\"title\":\"Not Found\",\"status\":404}", json);
+}
+
+inline StandInReply noaaSwpc(const StandInRequest &r) {
+  static const std::string json = "Content-Type: application/json\r\n";
+  if (r.path.compare(0, 10, "/products/") != 0) return noaaPaced(NOAA_SWPC, 404, "");
+  const std::string body  = noaaSwpcJson(r.path);
+  const std::string range = r.header("Range");
+  if (!noaa().swpc_range || range.compare(0, 7, "bytes=-") != 0) return noaaPaced(NOAA_SWPC, 200, body, json);
+  const size_t n = std::min(body.size(), (size_t)atol(range.c_str() + 7));
+  const size_t from = body.size() - n;
+  return noaaPaced(NOAA_SWPC, 206, body.substr(from), json + "Content-Range: bytes " + std::to_string(from) + "-" +
+                   std::to_string(body.size() - 1) + "/" + std::to_string(body.size()) + "\r\n");
+}
+
+inline StandInReply noaaCelestrak(const StandInRequest &r) {
+  if (!noaa().tle_epoch) return noaaPaced(NOAA_CELESTRAK, 404, "No GP data found");
+  return noaaPaced(NOAA_CELESTRAK, 200, noaaIssTle(noaa().tle_epoch), "Content-Type: text/plain\r\n");
+}
+
+inline StandInReply noaaGoes(const StandInRequest &r) {
+  auto it = noaa().goes_version.find(r.path);
+  const int v = it == noaa().goes_version.end() ? noaa().goes_default_version : it->second;
+  if (v <= 0) return noaaPaced(NOAA_GOES, 404, "");
+  const std::string etag = "\"v" + std::to_string(v) + "\"";
+  if (r.header("If-None-Match") == etag) return StandInReply().send(standInHead(304, "ETag: " + etag + "\r\n\r\n"));
+  return noaaPaced(NOAA_GOES, 200, noaaGoesFrame(r.path, v), "Content-Type: image/jpeg\r\nETag: " + etag + "\r\n");
+}
+
+// Register all four hosts, each handshake and round trip as given
+inline void noaaServe(unsigned long handshake_ms = 300, unsigned long rtt_ms = 60) {
+  for (auto h : { std::make_pair(NOAA_NWS, &noaaNws), std::make_pair(NOAA_SWPC, &noaaSwpc),
+                  std::make_pair(NOAA_CELESTRAK, &noaaCelestrak), std::make_pair(NOAA_GOES, &noaaGoes) }) {
+    StandInHost &host = standInHost(h.first, h.second);
+    host.handshake_ms = handshake_ms;
+    host.rtt_ms       = rtt_ms;
+  }
+}
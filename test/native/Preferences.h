@@ -0,0 +1,105 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// Host stand-in for the Arduino-ESP32 Preferences (NVS) library
+//
+// Every namespace lives in one process-wide map, so what one Preferences
+// object writes the next one reads back — as across a reboot on the board.
+// Values are kept as raw bytes; tests seed or inspect them directly with
+// nativeNvs() and count flash writes with native_nvs_writes.
+// ---------------------------------------------------------------------------
+#include <Arduino.h>
+
+#include <map>
+
+typedef std::map<std::string, std::string> NativeNvsSpace;
+
+inline std::map<std::string, NativeNvsSpace> &nativeNvs() {
+  static std::map<std::string, NativeNvsSpace> nvs;
+  return nvs;
+}
+inline uint32_t native_nvs_writes = 0;
+
+class Preferences {
+ public:
+  bool begin(const char *name, bool readOnly = false) {
+    NativeHeapExempt exempt;
+    ns = &nativeNvs()[name];
+    ro = readOnly;
+    return true;
+  }
+  void end() { ns = nullptr; }
+
+  bool isKey(const char *key) { return ns && ns->count(key); }
+  bool remove(const char *key) { return !ro && ns && ns->erase(key) > 0; }
+  bool clear() {
+    if (ro || !ns) return false;
+    ns->clear();
+    return true;
+  }
+
+  size_t putBytes(const char *key, const void *v, size_t len) {
+    if (ro || !ns) return 0;
+    NativeHeapExempt exempt;
+    (*ns)[key].assign((const char *)v, len);
+    native_nvs_writes++;
+    return len;
+  }
+  size_t getBytesLength(const char *key) {
+    const std::string *v = find(key);
+    return v ? v->size() : 0;
+  }
+  size_t getBytes(const char *key, void *buf, size_t len) {
+    const std::string *v = find(key);
+    if (!v || v->size() > len) return 0;
+    memcpy(buf, v->data(), v->size());
+    return v->size();
+  }
+
+  size_t putString(const char *key, const char *v) { return putBytes(key, v, strlen(v)); }
+  size_t putString(const char *key, const String &v) { return putString(key, v.c_str()); }
+  String getString(const char *key, const String &def = String()) {
+    const std::string *v = find(key);
+    return v ? String(*v) : def;
+  }
+  size_t getString(const char *key, char *buf, size_t len) {
+    const std::string *v = find(key);
+    if (!v || v->size() >= len) return 0;
+    memcpy(buf, v->data(), v->size());
+    buf[v->size()] = '\0';
+    return v->size() + 1;
+  }
+
+  size_t putInt(const char *key, int32_t v) { return put(key, v); }
+  size_t putUInt(const char *key, uint32_t v) { return put(key, v); }
+  size_t putLong(const char *key, int32_t v) { return put(key, v); }
+  size_t putULong(const char *key, uint32_t v) { return put(key, v); }
+  size_t putBool(const char *key, bool v) { return put(key, (uint8_t)v); }
+  size_t putFloat(const char *key, float v) { return put(key, v); }
+  size_t putDouble(const char *key, double v) { return put(key, v); }
+  int32_t  getInt(const char *key, int32_t def = 0) { return get(key, def); }
+  uint32_t getUInt(const char *key, uint32_t def = 0) { return get(key, def); }
+  int32_t  getLong(const char *key, int32_t def = 0) { return get(key, def); }
+  uint32_t getULong(const char *key, uint32_t def = 0) { return get(key, def); }
+  bool     getBool(const char *key, bool def = false) { return get(key, (uint8_t)def) != 0; }
+  float    getFloat(const char *key, float def = 0) { return get(key, def); }
+  double   getDouble(const char *key, double def = 0) { return get(key, def); }
+
+ private:
+  const std::string *find(const char *key) {
+    if (!ns) return nullptr;
+    auto it = ns->find(key);
+    return it == ns->end() ? nullptr : &it->second;
+  }
+  template <class T> size_t put(const char *key, T v) { return putBytes(key, &v, sizeof(v)); }
+  template <class T> T get(const char *key, T def) {
+    const std::string *v = find(key);
+    if (!v || v->size() != sizeof(T)) return def;
+    T out;
+    memcpy(&out, v->data(), sizeof(T));
+    return out;
+  }
+
+  NativeNvsSpace *ns = nullptr;
+  bool            ro = false;
+};
@@ -0,0 +1,307 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// Scripted in-memory HTTPS server for the native tests
+//
+// Stands in for every host the firmware talks to. A test registers a host
+// with a handler that turns each parsed request into a reply: raw response
+// bytes released in segments at chosen delays, optionally followed by the
+// peer closing (or resetting) the connection. WiFiClientSecure (see
+// WiFiClientSecure.h) connects to these hosts instead of the network.
+//
+// Every connect() is counted as a TLS handshake and costs handshake_ms of
+// clock; every response is held back rtt_ms after its request is written,
+// and a session answers pipelined requests strictly in order. On the
+// virtual clock (Arduino.h) all of this is instant and deterministic.
+// ---------------------------------------------------------------------------
+#include <Arduino.h>
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct StandInRequest {
+  std::string   host, method, path;
+  std::vector<std::pair<std::string, std::string>> headers;
+  int           session;   // connection it came in on (1 = first handshake to this host)
+  int           seq;       // request number on that connection, from 0
+  unsigned long at_ms;     // millis() when it was written
+
+  // Value of header name (case-insensitive), "" if absent
+  std::string header(const char *name) const {
+    for (const auto &h : headers) if (strcasecmp(h.first.c_str(), name) == 0) return h.second;
+    return "";
+  }
+};
+
+struct StandInReply {
+  struct Seg {
+    unsigned long after_ms;  // released this long after the request arrived
+    std::string   bytes;
+  };
+  std::vector<Seg> segs;
+  bool close = false;        // peer closes once the last segment is out
+  bool reset = false;        // drop the connection instead of answering
+
+  StandInReply &send(const std::string &bytes, unsigned long after_ms = 0) {
+    segs.push_back({ after_ms, bytes });
+    return *this;
+  }
+  StandInReply &thenClose() { close = true; return *this; }
+};
+
+typedef std::function<StandInReply(const StandInRequest &)> StandInHandler;
+
+struct StandInHost {
+  std::string    name;
+  StandInHandler handler;
+  unsigned long  handshake_ms = 0;   // clock a connect() costs
+  unsigned long  rtt_ms       = 0;   // request to first response byte
+  bool           refuse       = false;
+  uint32_t       handshakes   = 0;
+  uint32_t       requests     = 0;
+  int            sessions     = 0;
+  unsigned long  hung_up_ms   = 0;   // last time a client closed a session
+};
+
+// One accepted connection
+struct StandInSession {
+  StandInHost  *host;
+  int           id;
+  int           seq = 0;
+  std::string   inbound;             // request bytes not yet parsed
+  struct Out { unsigned long at_ms; std::string bytes; size_t off; };
+  std::deque<Out> out;               // response bytes in release order
+  unsigned long tail_ms   = 0;       // release time of the last queued byte
+  bool          closing   = false;   // peer closes at closes_ms
+  unsigned long closes_ms = 0;
+  bool          open      = true;
+  bool          stale     = false;   // peer gone, but the client has not noticed yet
+
+  void closeAt(unsigned long t) {
+    if (!closing || (long)(t - closes_ms) < 0) closes_ms = t;
+    closing = true;
+  }
+  bool closedBy(unsigned long t) const { return closing && (long)(t - closes_ms) >= 0; }
+};
+
+struct StandInServer {
+  std::recursive_mutex lock;
+  std::map<std::string, std::unique_ptr<StandInHost>> hosts;
+  std::vector<StandInSession *> sessions;  // open connections
+  std::vector<StandInRequest> log;   // every request, in arrival order
+};
+
+inline StandInServer &standIn() {
+  static StandInServer s;
+  return s;
+}
+
+// Held by every entry point: serialises the worker and the test thread, and
+// keeps the server's own buffers out of the firmware's heap figures
+struct StandInLock {
+  NativeHeapExempt                      exempt;
+  std::lock_guard<std::recursive_mutex> guard{ standIn().lock };
+};
+
+// Forget every host, counter and logged request. Connections still held by
+// clients go dead, so the next request on them reconnects.
+inline void standInReset() {
+  StandInLock g;
+  for (StandInSession *s : standIn().sessions) s->open = false;
+  standIn().hosts.clear();
+  standIn().log.clear();
+}
+
+inline StandInHost &standInHost(const std::string &name, StandInHandler handler) {
+  StandInLock g;
+  auto &h = standIn().hosts[name];
+  h.reset(new StandInHost);
+  h->name    = name;
+  h->handler = handler;
+  return *h;
+}
+
+inline StandInHost *standInFind(const std::string &name) {
+  auto it = standIn().hosts.find(name);
+  return it == standIn().hosts.end() ? nullptr : it->second.get();
+}
+
+inline uint32_t standInHandshakes(const std::string &name) {
+  StandInLock g;
+  StandInHost *h = standInFind(name);
+  return h ? h->handshakes : 0;
+}
+
+inline uint32_t standInRequests(const std::string &name) {
+  StandInLock g;
+  StandInHost *h = standInFind(name);
+  return h ? h->requests : 0;
+}
+
+// Requests for paths on host containing `part`
+inline int standInCount(const std::string &name, const char *part) {
+  StandInLock g;
+  int n = 0;
+  for (const auto &r : standIn().log) if (r.host == name && r.path.find(part) != std::string::npos) n++;
+  return n;
+}
+
+// ── Response builders ────────────────────────────────────────────────────────
+inline std::string standInHead(int code, const std::string &extra = "") {
+  const char *reason = code == 200 ? "OK" : code == 206 ? "Partial Content" : code == 304 ? "Not Modified" : code == 404 ? "Not Found"
+                     : (code >= 300 && code < 400) ? "Found" : "Error";
+  return "HTTP/1.1 " + std::to_string(code) + " " + reason + "\r\n" + extra;
+}
+
+// Complete Content-Length response
+inline std::string standInResponse(int code, const std::string &body, const std::string &extra = "") {
+  return standInHead(code, extra) + "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+}
+
+// Chunked encoding of body in pieces of `piece` bytes, with the 0-chunk
+inline std::string standInChunked(const std::string &body, size_t piece) {
+  std::string out;
+  char line[16];
+  for (size_t i = 0; i < body.size(); i += piece) {
+    size_t n = std::min(piece, body.size() - i);
+    snprintf(line, sizeof(line), "%zx\r\n", n);
+    out += line + body.substr(i, n) + "\r\n";
+  }
+  return out + "0\r\n\r\n";
+}
+
+inline StandInReply standInOk(const std::string &body, const std::string &extra = "") {
+  return StandInReply().send(standInResponse(200, body, extra));
+}
+
+// ── Connection side (used by WiFiClientSecure) ───────────────────────────────
+inline StandInSession *standInConnect(const char *name) {
+  StandInLock g;
+  StandInHost *h = standInFind(name);
+  if (!h || h->refuse) return nullptr;
+  h->handshakes++;
+  StandInSession *s = new StandInSession;
+  s->host = h;
+  s->id   = ++h->sessions;
+  standIn().sessions.push_back(s);
+  return s;
+}
+
+// Client side close (WiFiClientSecure::stop)
+inline void standInClose(StandInSession *s) {
+  StandInLock g;
+  if (s->open) s->host->hung_up_ms = millis();
+  auto &all = standIn().sessions;
+  all.erase(std::remove(all.begin(), all.end(), s), all.end());
+  delete s;
+}
+
+// Parse whatever complete requests have arrived and queue their replies
+inline void standIn_dispatch(StandInSession *s) {
+  size_t end;
+  while (s->open && (end = s->inbound.find("\r\n\r\n")) != std::string::npos) {
+    std::string head = s->inbound.substr(0, end);
+    s->inbound.erase(0, end + 4);
+
+    StandInRequest r;
+    r.host    = s->host->name;
+    r.session = s->id;
+    r.seq     = s->seq++;
+    r.at_ms   = millis();
+    size_t eol = head.find("\r\n");
+    std::string first = head.substr(0, eol);
+    size_t sp1 = first.find(' '), sp2 = first.rfind(' ');
+    r.method = first.substr(0, sp1);
+    r.path   = first.substr(sp1 + 1, sp2 - sp1 - 1);
+    while (eol != std::string::npos) {
+      size_t next = head.find("\r\n", eol + 2);
+      std::string line = head.substr(eol + 2, next == std::string::npos ? std::string::npos : next - eol - 2);
+      size_t colon = line.find(':');
+      if (colon != std::string::npos) {
+        size_t v = line.find_first_not_of(' ', colon + 1);
+        r.headers.push_back({ line.substr(0, colon), v == std::string::npos ? "" : line.substr(v) });
+      }
+      eol = next;
+    }
+    s->host->requests++;
+    standIn().log.push_back(r);
+
+    StandInReply reply = s->host->handler(r);
+    const unsigned long base = std::max(r.at_ms + s->host->rtt_ms, s->tail_ms);
+    if (reply.reset) {
+      s->closeAt(base);
+      return;
+    }
+    for (const auto &seg : reply.segs) {
+      s->tail_ms = std::max(s->tail_ms, base + seg.after_ms);
+      s->out.push_back({ s->tail_ms, seg.bytes, 0 });
+    }
+    if (reply.segs.empty()) s->tail_ms = std::max(s->tail_ms, base);
+    if (reply.close) {
+      s->closeAt(s->tail_ms);
+      return;
+    }
+  }
+}
+
+// Bytes released by now
+inline int standInAvailable(StandInSession *s) {
+  StandInLock g;
+  const unsigned long now = millis();
+  int n = 0;
+  for (const auto &o : s->out) {
+    if ((long)(o.at_ms - now) > 0 || (s->closing && (long)(o.at_ms - s->closes_ms) > 0)) break;
+    n += o.bytes.size() - o.off;
+  }
+  return n;
+}
+
+inline bool standInConnected(StandInSession *s) {
+  StandInLock g;
+  if (!s->open) return false;
+  if (s->stale || !s->closedBy(millis())) return true;
+  return standInAvailable(s) > 0;   // closed, but unread data is still delivered
+}
+
+inline int standInRead(StandInSession *s, uint8_t *buf, size_t len) {
+  StandInLock g;
+  size_t avail = standInAvailable(s), got = 0;
+  while (got < len && got < avail) {
+    auto &o = s->out.front();
+    size_t n = std::min(len - got, o.bytes.size() - o.off);
+    memcpy(buf + got, o.bytes.data() + o.off, n);
+    o.off += n;
+    got   += n;
+    if (o.off == o.bytes.size()) s->out.pop_front();
+  }
+  return (int)got;
+}
+
+// Request bytes from the client. A peer that already closed takes the bytes
+// (they sit in the TCP send buffer) but never answers.
+inline size_t standInWrite(StandInSession *s, const uint8_t *buf, size_t len) {
+  StandInLock g;
+  if (!s->open) return 0;
+  if (s->stale) {
+    // The write goes out; the answer is a reset
+    s->stale = false;
+    s->closeAt(millis());
+  }
+  if (s->closedBy(millis())) return len;
+  s->inbound.append((const char *)buf, len);
+  standIn_dispatch(s);
+  return len;
+}
+
+// Server side: close every idle session to host as if it timed them out. The
+// client only finds out when it next writes on one (a stale keep-alive session).
+inline void standInDropIdle(const std::string &name) {
+  StandInLock g;
+  for (StandInSession *s : standIn().sessions) {
+    if (s->open && s->host->name == name && s->out.empty()) s->stale = true;
+  }
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+// Host stand-in for the Arduino-ESP32 WebServer. Routes are registered but
+// no client ever connects: the tests boot with settings already in NVS
+// (Preferences.h), so neither the portal nor /identify is exercised.
+#include <WiFi.h>
+
+typedef enum { HTTP_ANY, HTTP_GET, HTTP_POST } HTTPMethod;
+
+class WebServer {
+ public:
+  typedef void (*THandlerFunction)();
+
+  WebServer(int port = 80) {}
+  void on(const char *uri, THandlerFunction fn) {}
+  void on(const char *uri, HTTPMethod method, THandlerFunction fn) {}
+  void onNotFound(THandlerFunction fn) {}
+  void begin() {}
+  void stop() {}
+  void handleClient() {}
+
+  void send(int code, const char *type = nullptr, const String &body = String()) {}
+  void sendHeader(const String &name, const String &value, bool first = false) {}
+  bool hasArg(const String &name) { return false; }
+  String arg(const String &name) { return String(); }
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+// Host stand-in for the Arduino-ESP32 WiFi library: a link that is up unless
+// a test takes it down with nativeWiFiUp(false), and a plain client base class.
+#include <Arduino.h>
+
+typedef enum { WL_IDLE_STATUS = 0, WL_DISCONNECTED = 6, WL_CONNECTED = 3 } wl_status_t;
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2 } wifi_mode_t;
+#define ESP_MAC_WIFI_STA 0
+
+struct IPAddress {
+  uint8_t a = 192, b = 168, c = 4, d = 1;
+  String toString() const {
+    char s[16];
+    snprintf(s, sizeof(s), "%u.%u.%u.%u", a, b, c, d);
+    return String(s);
+  }
+};
+
+inline volatile bool native_wifi_up = true;
+inline void nativeWiFiUp(bool up) { native_wifi_up = up; }
+
+struct WiFiClass {
+  wl_status_t status() { return native_wifi_up ? WL_CONNECTED : WL_DISCONNECTED; }
+  void mode(wifi_mode_t) {}
+  void begin(const char *, const char *) {}
+  void disconnect(bool = false) {}
+  void reconnect() {}
+  int  RSSI() { return -60; }
+  bool softAP(const char *, const char *) { return true; }
+  IPAddress softAPIP() { return IPAddress(); }
+  bool softAPdisconnect(bool) { return true; }
+};
+inline WiFiClass WiFi;
+
+inline void esp_read_mac(uint8_t *mac, int) {
+  static const uint8_t m[6] = { 0x24, 0x6F, 0x28, 0x12, 0x34, 0x56 };
+  memcpy(mac, m, 6);
+}
+
+class WiFiClient : public Stream {
+ public:
+  virtual int     connect(const char *host, uint16_t port) = 0;
+  virtual uint8_t connected() = 0;
+  virtual void    stop() = 0;
+  virtual int     read(uint8_t *buf, size_t len) = 0;
+  using Stream::read;
+  using Print::write;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+// Host stand-in for WiFiClientSecure: a socket to the scripted server in
+// StandIn.h. Each connect() is one "TLS handshake" to a stand-in host.
+#include <WiFi.h>
+#include "StandIn.h"
+
+class WiFiClientSecure : public WiFiClient {
+ public:
+  ~WiFiClientSecure() override { stop(); }
+  void setInsecure() {}
+  void setCACert(const char *) {}
+  void setHandshakeTimeout(unsigned long) {}
+  void setTimeout(unsigned long) {}
+
+  int connect(const char *host, uint16_t) override {
+    stop();
+    if (!native_wifi_up) return 0;
+    session = standInConnect(host);
+    if (!session) return 0;
+    delay(session->host->handshake_ms);
+    return 1;
+  }
+  uint8_t connected() override { return session && standInConnected(session); }
+  void stop() override {
+    if (session) standInClose(session);
+    session = nullptr;
+  }
+  int available() override { return session ? standInAvailable(session) : 0; }
+  int read() override {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+  }
+  int read(uint8_t *buf, size_t len) override {
+    int n = session ? standInRead(session, buf, len) : 0;
+    return n > 0 ? n : -1;
+  }
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t *buf, size_t len) override {
+    return session ? standInWrite(session, buf, len) : 0;
+  }
+  // Drop whatever has arrived (HTTPClient::end() on a reused session)
+  void flush() override {
+    uint8_t junk[256];
+    while (available() > 0 && read(junk, sizeof(junk)) > 0) {}
+  }
+
+ private:
+  StandInSession *session = nullptr;
+};
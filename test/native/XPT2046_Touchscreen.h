@@ -0,0 +1,29 @@
+#pragma once
+
+// Host stand-in for PaulStoffregen/XPT2046_Touchscreen: a finger the test
+// puts down with nativeTouch(x, y) (raw 0-4095 ADC units, as the firmware
+// reads them) and lifts with nativeRelease()
+#include <SPI.h>
+
+struct TS_Point {
+  int16_t x, y, z;
+};
+
+inline bool     native_touch_down = false;
+inline TS_Point native_touch_at   = { 0, 0, 0 };
+
+inline void nativeTouch(int16_t x, int16_t y) {
+  native_touch_at   = { x, y, 1200 };
+  native_touch_down = true;
+}
+inline void nativeRelease() { native_touch_down = false; }
+
+class XPT2046_Touchscreen {
+ public:
+  XPT2046_Touchscreen(uint8_t cs, uint8_t tirq = 255) {}
+  bool begin(SPIClass &spi) { return true; }
+  void setRotation(uint8_t r) {}
+  bool tirqTouched() { return native_touch_down; }
+  bool touched() { return native_touch_down; }
+  TS_Point getPoint() { return native_touch_down ? native_touch_at : TS_Point{ 0, 0, 0 }; }
+};
@@ -0,0 +1,127 @@
+// Background NWS alert watcher, replayed through the whole firmware: a GOES
+// camera stays on screen while the stand-in's active alert set changes
+// between polls. A new alert raises the red banner over the camera, the
+// same set again changes nothing, a routine re-issue stays quiet, the same
+// event at a higher severity raises it again, and a new location starts
+// from a clean slate so whatever is active there is announced.
+#include <unity.h>
+
+#include "Firmware.h"
+#include "NoaaStandIn.h"
+
+static const NoaaAlert TORNADO = { "urn:oid:2.49.0.1.840.0.1", "Tornado Warning", "Extreme",
+                                   "Tornado Warning issued June 21 at 11:50AM MDT" };
+static const NoaaAlert FLOOD   = { "urn:oid:2.49.0.1.840.0.2", "Flood Watch", "Moderate",
+                                   "Flood Watch issued June 21 at 11:55AM MDT" };
+
+static int polls() {
+  int n = 0;
+  for (const auto &r : standIn().log) n += (r.path.compare(0, 15, "/alerts/active?") == 0);
+  return n;
+}
+
+// Run until the firmware has polled alerts once more and applied the result
+static void next_poll() {
+  const int n = polls();
+  TEST_ASSERT_TRUE(nativeRunUntil([=] { return polls() > n; }, NWS_ALERTS_INTERVAL + 30000));
+  TEST_ASSERT_TRUE(nativeRunUntil([] { return fetch_running != NWS_ALERTS_MODE; }, 10000));
+  nativeRunFor(200);
+}
+
+static bool banner_on_panel() { return gfx->pixel(2, 22) == 0xF800; }
+
+static void go_to(int mode, int tap) {
+  while (wc_camera_idx != mode) {
+    nativeRunFor(500);   // touch debounce
+    nativeTap(tap);
+  }
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_quiet_area_has_no_banner() {
+  TEST_ASSERT_TRUE(nativeRunUntil([] { return goes_on_screen == 0 && mode_data[NWS_ALERTS_MODE].data; }, 60000));
+  TEST_ASSERT_EQUAL_STRING("", alert_banner);
+  TEST_ASSERT_FALSE(banner_on_panel());
+}
+
+static void test_new_alert_raises_the_banner() {
+  noaa().alerts = { FLOOD };
+  next_poll();
+  TEST_ASSERT_EQUAL_STRING("Flood Watch", alert_banner);
+  TEST_ASSERT_TRUE(banner_on_panel());
+  TEST_ASSERT_EQUAL_INT(0, wc_camera_idx);
+  TEST_ASSERT_EQUAL_INT(1, ((const NwsAlertsData *)mode_data[NWS_ALERTS_MODE].data)->count);
+
+  // A worse one on top takes the banner over
+  noaa().alerts = { FLOOD, TORNADO };
+  next_poll();
+  TEST_ASSERT_EQUAL_STRING("Tornado Warning", alert_banner);
+}
+
+static void test_same_set_changes_nothing() {
+  // Seen on the alerts page, then back to the camera
+  go_to(NWS_ALERTS_MODE, NATIVE_TAP_PREV);
+  TEST_ASSERT_EQUAL_STRING("", alert_banner);
+  go_to(0, NATIVE_TAP_NEXT);
+  TEST_ASSERT_TRUE(nativeRunUntil([] { return goes_on_screen == 0; }, 10000));
+
+  const void *snapshot = mode_data[NWS_ALERTS_MODE].data;
+  const uint32_t camera = gfx->checksum(0, 20, gfx->width(), gfx->height() - 40);
+  next_poll();
+  TEST_ASSERT_EQUAL_STRING("", alert_banner);
+  TEST_ASSERT_FALSE(banner_on_panel());
+  // Nothing new kept and nothing drawn
+  TEST_ASSERT_TRUE(snapshot == mode_data[NWS_ALERTS_MODE].data);
+  TEST_ASSERT_EQUAL_UINT32(camera, gfx->checksum(0, 20, gfx->width(), gfx->height() - 40));
+
+  // A routine re-issue (new id, same event and severity) stays quiet too
+  NoaaAlert reissue = FLOOD;
+  reissue.id += "1";
+  noaa().alerts = { reissue, TORNADO };
+  next_poll();
+  TEST_ASSERT_EQUAL_STRING("", alert_banner);
+  TEST_ASSERT_FALSE(banner_on_panel());
+}
+
+static void test_severity_upgrade_raises_the_banner() {
+  NoaaAlert upgraded = FLOOD;
+  upgraded.id      += "2";
+  upgraded.severity = "Severe";
+  noaa().alerts = { upgraded, TORNADO };
+  next_poll();
+  TEST_ASSERT_EQUAL_STRING("Flood Watch", alert_banner);
+  TEST_ASSERT_TRUE(banner_on_panel());
+}
+
+static void test_location_change_resets() {
+  go_to(NWS_ALERTS_MODE, NATIVE_TAP_PREV);
+  go_to(0, NATIVE_TAP_NEXT);
+  TEST_ASSERT_EQUAL_STRING("", alert_banner);
+
+  // Moved (what the portal writes): the tornado warning is active here
+  // too, and is news at this location
+  strcpy(wc_lat, "40.0150");
+  strcpy(wc_lon, "-105.2705");
+  noaa().alerts = { TORNADO };
+  next_poll();
+  TEST_ASSERT_EQUAL_STRING("Tornado Warning", alert_banner);
+  TEST_ASSERT_EQUAL_STRING("40.0150,-105.2705", nws_alerts_where);
+  TEST_ASSERT_EQUAL_INT(1, nws_alerts_seen_n);
+}
+
+int main(int argc, char **argv) {
+  const time_t now = 1782064800;   // 2026-06-21 18:00 UTC
+  nativeSetTime(now);
+  noaaServe(300, 60);
+  noaa().tle_epoch = now - 86400;
+  nativeBoot();
+  UNITY_BEGIN();
+  RUN_TEST(test_quiet_area_has_no_banner);
+  RUN_TEST(test_new_alert_raises_the_banner);
+  RUN_TEST(test_same_set_changes_nothing);
+  RUN_TEST(test_severity_upgrade_raises_the_banner);
+  RUN_TEST(test_location_change_resets);
+  return UNITY_END();
+}
@@ -0,0 +1,192 @@
+// PoolBody framing against replayed responses: Content-Length, chunked and
+// close-delimited bodies, split across segments the way TLS records arrive.
+// Each replay checks the payload byte for byte, whether the session may be
+// reused, and that end-of-body is seen within one poll step of the last byte
+// (not after POOL_TIMEOUT_MS).
+#include <unity.h>
+
+#include "HTTPPool.h"
+
+#define HOST "api.weather.gov"
+
+static std::map<std::string, StandInReply> replies;
+
+static StandInReply replay(const StandInRequest &r) {
+  auto it = replies.find(r.path);
+  return it == replies.end() ? StandInReply().send(standInResponse(404, "")) : it->second;
+}
+
+// A forecast-like JSON payload of n bytes
+static std::string payload(size_t n) {
+  std::string s = "{\"periods\":[";
+  for (int i = 0; s.size() < n - 3; i++) s += "{\"n\":" + std::to_string(i) + ",\"t\":\"Sunny\\u00b0\"},";
+  s.resize(n - 3);
+  return s + "]}\n";
+}
+
+// Cut wire bytes into segments at the given offsets, `gap_ms` apart
+static StandInReply segmented(const std::string &wire, std::vector<size_t> cuts, unsigned long gap_ms) {
+  StandInReply r;
+  size_t from = 0;
+  unsigned long at = 0;
+  cuts.push_back(wire.size());
+  for (size_t c : cuts) {
+    r.send(wire.substr(from, c - from), at);
+    from = c;
+    at += gap_ms;
+  }
+  return r;
+}
+
+struct Read {
+  std::string   body;
+  bool          done, error, reusable;
+  unsigned long last_byte_ms;   // when the server released the final segment
+  unsigned long end_ms;         // when pool_body_read reported the end
+};
+
+static Read read_body(const char *path, int32_t bufsize) {
+  const StandInReply &reply = replies[path];
+  PoolConn *c;
+  int code = pool_get(String("https://" HOST) + path, nullptr, &c);
+  TEST_ASSERT_EQUAL_INT_MESSAGE(200, code, path);
+  Read out;
+  out.last_byte_ms = standIn().log.back().at_ms + standInFind(HOST)->rtt_ms + reply.segs.back().after_ms;
+  PoolBody b;
+  pool_body_begin(&b, c);
+  std::vector<uint8_t> buf(bufsize);
+  int32_t n;
+  while ((n = pool_body_read(&b, buf.data(), bufsize)) > 0) out.body.append((const char *)buf.data(), n);
+  out.end_ms   = millis();
+  out.done     = b.done;
+  out.error    = b.error;
+  out.reusable = pool_body_reusable(&b);
+  pool_end(c, out.reusable);
+  return out;
+}
+
+static void expect_clean(const char *path, const std::string &want) {
+  for (int32_t bufsize : { 1, 7, 512, 65536 }) {
+    pool_close_all();
+    Read r = read_body(path, bufsize);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(want.size(), r.body.size(), path);
+    TEST_ASSERT_TRUE_MESSAGE(r.body == want, path);
+    TEST_ASSERT_TRUE_MESSAGE(r.done, path);
+    TEST_ASSERT_FALSE_MESSAGE(r.error, path);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32_MESSAGE(POOL_POLL_MS, r.end_ms - r.last_byte_ms, path);
+  }
+}
+
+void setUp() {
+  pool_close_all();
+  standInReset();
+  replies.clear();
+  standInHost(HOST, replay).rtt_ms = 40;
+}
+
+void tearDown() {}
+
+static void test_content_length_dripped() {
+  std::string body = payload(9000);
+  std::string wire = standInResponse(200, body, "Content-Type: application/geo+json\r\n");
+  replies["/cl"] = segmented(wire, { 120, 1400, 2900, 4300, 5700, 7200, 8600 }, 35);
+  expect_clean("/cl", body);
+  TEST_ASSERT_TRUE(read_body("/cl", 512).reusable);
+}
+
+static void test_chunked_with_extensions() {
+  std::string body = payload(6000);
+  std::string wire = standInHead(200, "Transfer-Encoding: chunked\r\n\r\n");
+  char line[48];
+  for (size_t i = 0; i < body.size(); i += 1500) {
+    size_t n = std::min((size_t)1500, body.size() - i);
+    // Extensions are legal on any chunk and must be ignored
+    snprintf(line, sizeof(line), i ? "%zx\r\n" : "%zX;name=\"first\";q=1\r\n", n);
+    wire += line + body.substr(i, n) + "\r\n";
+  }
+  wire += "0\r\n\r\n";
+  replies["/ext"] = segmented(wire, { 200, 1700, 3100, 4800 }, 50);
+  expect_clean("/ext", body);
+}
+
+static void test_chunked_crlf_split_across_segments() {
+  std::string body = payload(3000);
+  std::string wire = standInHead(200, "Transfer-Encoding: chunked\r\n\r\n") + standInChunked(body, 1000);
+  // Cut inside every CRLF: after each chunk's data, inside each size line,
+  // and between the last chunk's CR and LF
+  std::vector<size_t> cuts;
+  for (size_t p = wire.find("\r\n\r\n") + 4; (p = wire.find("\r\n", p)) != std::string::npos; p += 2) cuts.push_back(p + 1);
+  replies["/split"] = segmented(wire, cuts, 25);
+  expect_clean("/split", body);
+  TEST_ASSERT_TRUE(read_body("/split", 64).reusable);
+}
+
+static void test_zero_chunk_with_trailers() {
+  std::string body = payload(2500);
+  std::string wire = standInHead(200, "Transfer-Encoding: chunked\r\nTrailer: Expires, X-Checksum\r\n\r\n") +
+                     standInChunked(body, 800);
+  wire.resize(wire.size() - 2);   // drop the empty line, add trailers in its place
+  wire += "Expires: Wed, 21 Oct 2026 07:28:00 GMT\r\nX-Checksum: 9f86d081884c7d65\r\n\r\n";
+  replies["/trailers"] = segmented(wire, { wire.size() - 40, wire.size() - 1 }, 30);
+  expect_clean("/trailers", body);
+
+  // The trailers were consumed: the session serves the next request
+  replies["/after"] = standInOk("next");
+  Read r = read_body("/trailers", 512);
+  TEST_ASSERT_TRUE(r.reusable);
+  const uint32_t handshakes = standInHandshakes(HOST);
+  TEST_ASSERT_EQUAL_STRING("next", pool_get_string("https://" HOST "/after", nullptr, "test").c_str());
+  TEST_ASSERT_EQUAL_UINT32(handshakes, standInHandshakes(HOST));
+}
+
+static void test_peer_close_mid_chunk() {
+  std::string body = payload(4000);
+  const std::string head = standInHead(200, "Transfer-Encoding: chunked\r\n\r\n");
+  std::string wire = head + standInChunked(body, 1024);
+  size_t cut = head.size() + 5 + 1024 + 2 + 5 + (1500 - 1024);   // inside the second chunk
+  replies["/cut"] = segmented(wire.substr(0, cut), { cut / 2 }, 60).thenClose();
+  Read r = read_body("/cut", 512);
+  TEST_ASSERT_FALSE(r.done);
+  TEST_ASSERT_TRUE(r.error);
+  TEST_ASSERT_FALSE(r.reusable);
+  // Everything before the close is delivered, nothing invented after it
+  TEST_ASSERT_EQUAL_UINT32(1500, r.body.size());
+  TEST_ASSERT_TRUE(r.body == body.substr(0, 1500));
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(POOL_POLL_MS, r.end_ms - r.last_byte_ms);
+}
+
+static void test_close_delimited() {
+  std::string body = payload(5000);
+  std::string wire = standInHead(200, "Connection: close\r\n\r\n") + body;
+  replies["/close"] = segmented(wire, { 90, 2000, 3500 }, 45).thenClose();
+  for (int32_t bufsize : { 7, 4096 }) {
+    pool_close_all();
+    Read r = read_body("/close", bufsize);
+    TEST_ASSERT_TRUE(r.body == body);
+    TEST_ASSERT_TRUE(r.done);
+    TEST_ASSERT_FALSE(r.reusable);   // no framing: the session cannot carry another request
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(POOL_POLL_MS, r.end_ms - r.last_byte_ms);
+  }
+}
+
+static void test_stalled_body_times_out() {
+  std::string body = payload(2000);
+  std::string wire = standInResponse(200, body);
+  replies["/stall"] = StandInReply().send(wire.substr(0, 1000));   // rest never comes
+  Read r = read_body("/stall", 512);
+  TEST_ASSERT_TRUE(r.error);
+  TEST_ASSERT_FALSE(r.done);
+  TEST_ASSERT_UINT32_WITHIN(POOL_POLL_MS, POOL_TIMEOUT_MS, r.end_ms - r.last_byte_ms);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_content_length_dripped);
+  RUN_TEST(test_chunked_with_extensions);
+  RUN_TEST(test_chunked_crlf_split_across_segments);
+  RUN_TEST(test_zero_chunk_with_trailers);
+  RUN_TEST(test_peer_close_mid_chunk);
+  RUN_TEST(test_close_delimited);
+  RUN_TEST(test_stalled_body_times_out);
+  return UNITY_END();
+}
@@ -0,0 +1,112 @@
+// Cancelling the fetch in flight on a mode change: the firmware is partway
+// through a GOES download from a slow-drip CDN (a 1460 B segment every
+// 400 ms, ~11 s per frame) when the user taps. The transfer must stop within
+// ~100 ms and give back its stream ring and TLS session, and the new mode's
+// fetch must start right after instead of once the old download finishes.
+#include <unity.h>
+
+#include "NativeHeap.h"
+#include "Firmware.h"
+#include "NoaaStandIn.h"
+
+#define HANDSHAKE_MS 900
+#define DRIP_BYTES   1460
+#define DRIP_MS      400
+
+static const char *path_of(int cam) { return CAMERAS[cam].url + strlen("https://" NOAA_GOES); }
+
+// When the server saw the first request for cam's frame since `since`, 0 = none
+static unsigned long request_at(int cam, unsigned long since) {
+  for (const auto &r : standIn().log)
+    if (r.path == path_of(cam) && r.at_ms >= since) return r.at_ms;
+  return 0;
+}
+
+static unsigned long hung_up_ms() { return standInFind(NOAA_GOES)->hung_up_ms; }
+
+// Time the whole of cam's current frame takes to trickle in
+static unsigned long transfer_ms(int cam) {
+  const std::string &f = noaaGoesFrame(path_of(cam), noaa().goes_default_version);
+  return (f.size() + DRIP_BYTES - 1) / DRIP_BYTES * DRIP_MS;
+}
+
+// Start a slow download of the camera on screen and let it run for ms
+static void download_for(unsigned long ms) {
+  const int cam = wc_camera_idx;
+  TEST_ASSERT_TRUE(nativeRunUntil([=] { return fetch_running == cam; }, 5000));
+  nativeRunFor(ms);
+  TEST_ASSERT_EQUAL_INT_MESSAGE(cam, fetch_running, "download finished too soon");
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_tap_aborts_the_transfer_and_frees_it() {
+  TEST_ASSERT_TRUE_MESSAGE(NATIVE_HEAP_TRACKED, "heap tracking needs glibc");
+  // Everything loaded and the neighbour prefetched, at full speed
+  TEST_ASSERT_TRUE(nativeRunUntil([] {
+    for (int m = NUM_CAMERAS; m < NUM_MODES; m++) if (!mode_data[m].data) return false;
+    return goes_on_screen == 0 && prefetch_slots[1].data != nullptr;
+  }, 60000));
+
+  // A new frame, and now the CDN crawls
+  noaa().pace[NOAA_GOES]  = { DRIP_BYTES, DRIP_MS };
+  noaa().goes_default_version = 2;
+  schedAt(0, millis());
+  download_for(3000);
+  const int64_t heap_mid = native_heap_used;
+
+  // To Sun & Moon, which is drawn from RAM and fetches nothing
+  const unsigned long tap = millis();
+  nativeTap(NATIVE_TAP_PREV);
+  TEST_ASSERT_EQUAL_INT(SUN_MOON_MODE, wc_camera_idx);
+  TEST_ASSERT_TRUE(nativeRunUntil([=] { return hung_up_ms() >= tap; }, 5000));
+  const unsigned long abort_ms = hung_up_ms() - tap;
+  nativeRunFor(200);
+  const int64_t freed = heap_mid - native_heap_used;
+
+  printf("tap to transfer aborted: %lu ms (%lu ms of the %lu ms download were left)\n",
+         abort_ms, transfer_ms(0) - 3000, transfer_ms(0));
+  printf("heap freed by the abort: %lld B (stream ring %u B)\n", (long long)freed, (unsigned)sizeof(JpegStream));
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(100, abort_ms);
+  TEST_ASSERT_GREATER_OR_EQUAL_INT64((int64_t)sizeof(JpegStream), freed);
+  TEST_ASSERT_EQUAL_INT(-1, fetch_running);
+  TEST_ASSERT_EQUAL_INT(-1, goes_on_screen);
+}
+
+static void test_input_to_the_new_fetch() {
+  // Back to camera 0, cold, and tap on to camera 1 partway through
+  nativeRunFor(500);   // touch debounce
+  nativeTap(NATIVE_TAP_NEXT);
+  TEST_ASSERT_EQUAL_INT(0, wc_camera_idx);
+  download_for(2000);
+  prefetchTrim(-1, NUM_MODES);   // camera 1 has to come from the network too
+
+  const unsigned long tap = millis();
+  nativeTap(NATIVE_TAP_NEXT);
+  TEST_ASSERT_EQUAL_INT(1, wc_camera_idx);
+  TEST_ASSERT_TRUE(nativeRunUntil([=] { return request_at(1, tap) != 0; }, 10000));
+  const unsigned long abort_ms = hung_up_ms() - tap;
+  const unsigned long start_ms = request_at(1, tap) - tap;
+
+  printf("tap to old transfer aborted: %lu ms\n", abort_ms);
+  printf("tap to new request on the wire: %lu ms (incl. %d ms TLS handshake); "
+         "without cancellation ~%lu ms\n", start_ms, HANDSHAKE_MS, transfer_ms(0) - 2000 + start_ms);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(100, abort_ms);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(100 + HANDSHAKE_MS, start_ms);
+
+  // And the new frame gets all the way to the screen
+  TEST_ASSERT_TRUE(nativeRunUntil([] { return goes_on_screen == 1; }, transfer_ms(1) + 5000));
+}
+
+int main(int argc, char **argv) {
+  const time_t now = 1782064800;   // 2026-06-21 18:00 UTC
+  nativeSetTime(now);
+  noaaServe(HANDSHAKE_MS, 100);
+  noaa().tle_epoch = now - 86400;
+  nativeBoot();
+  UNITY_BEGIN();
+  RUN_TEST(test_tap_aborts_the_transfer_and_frees_it);
+  RUN_TEST(test_input_to_the_new_fetch);
+  return UNITY_END();
+}
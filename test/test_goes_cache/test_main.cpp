@@ -0,0 +1,127 @@
+// GOES conditional GET through the firmware: the camera on screen is
+// refreshed against a stand-in CDN that answers 200, then 304 while the
+// frame is unchanged, then 200 once a new frame (new ETag) is published.
+// Checks the per-camera hit/miss counters, what goes over the wire and what
+// ends up on the panel, and that a camera whose frame is no longer on screen
+// asks unconditionally.
+#include <unity.h>
+
+#include "Firmware.h"
+
+#define GOES "cdn.star.nesdis.noaa.gov"
+
+// Published frame per camera path: version n is served with ETag "vn"
+static std::map<std::string, int> published;
+static std::map<std::string, std::string> files;
+
+static const char *path_of(int cam) { return CAMERAS[cam].url + strlen("https://" GOES); }
+
+// Version n of a frame differs from n-1 in every MCU
+static int colour_version;
+static uint16_t colour_at(int mx, int my) { return (uint16_t)(mx * 2113 + my * 977 + colour_version * 7919); }
+
+static const std::string &frame_file(const std::string &path, int version) {
+  std::string &f = files[path + "#" + std::to_string(version)];
+  if (f.empty()) {
+    const bool conus = path.find("416x250") != std::string::npos;
+    colour_version = version;
+    f = jpegStandInFile(conus ? 416 : 250, 250, 16, 64, colour_at);
+  }
+  return f;
+}
+
+static StandInReply cdn(const StandInRequest &r) {
+  auto it = published.find(r.path);
+  if (it == published.end()) return StandInReply().send(standInResponse(404, ""));
+  const std::string etag = "\"v" + std::to_string(it->second) + "\"";
+  if (r.header("If-None-Match") == etag) return StandInReply().send(standInHead(304, "ETag: " + etag + "\r\n\r\n"));
+  return standInOk(frame_file(r.path, it->second), "Content-Type: image/jpeg\r\nETag: " + etag + "\r\n");
+}
+
+// The last request the firmware made for cam's frame
+static const StandInRequest *last_request(int cam) {
+  for (auto it = standIn().log.rbegin(); it != standIn().log.rend(); ++it)
+    if (it->path == path_of(cam)) return &*it;
+  return nullptr;
+}
+
+static uint32_t image_area() { return gfx->checksum(0, 20, gfx->width(), gfx->height() - 40); }
+
+static uint32_t hits0, misses0;
+static bool refreshed() { return camera_cache[0].hits + camera_cache[0].misses > hits0 + misses0; }
+
+void setUp() {
+  hits0   = camera_cache[0].hits;
+  misses0 = camera_cache[0].misses;
+}
+
+void tearDown() {}
+
+static void test_first_fetch_is_a_miss_and_draws() {
+  published[path_of(0)] = 1;
+  TEST_ASSERT_TRUE(nativeRunUntil([] { return goes_on_screen == 0; }, 10000));
+  TEST_ASSERT_EQUAL_UINT32(0, camera_cache[0].hits);
+  TEST_ASSERT_EQUAL_UINT32(1, camera_cache[0].misses);
+  TEST_ASSERT_EQUAL_STRING("", last_request(0)->header("If-None-Match").c_str());
+  TEST_ASSERT_EQUAL_STRING("\"v1\"", camera_cache[0].validator.etag);
+  TEST_ASSERT_GREATER_THAN_UINT32(0, gfx_native_stats.bitmap_px);
+}
+
+static void test_unchanged_frame_is_a_304_hit() {
+  const uint32_t before = image_area();
+  const uint64_t bitmap_px = gfx_native_stats.bitmap_px;
+  TEST_ASSERT_TRUE(nativeRunUntil(refreshed, UPDATE_INTERVAL + 10000));
+  TEST_ASSERT_EQUAL_UINT32(1, camera_cache[0].hits);
+  TEST_ASSERT_EQUAL_UINT32(1, camera_cache[0].misses);
+  TEST_ASSERT_EQUAL_STRING("\"v1\"", last_request(0)->header("If-None-Match").c_str());
+  // Nothing decoded or pushed: the frame on screen stays as it was
+  TEST_ASSERT_EQUAL_UINT64(bitmap_px, gfx_native_stats.bitmap_px);
+  TEST_ASSERT_EQUAL_UINT32(before, image_area());
+  TEST_ASSERT_EQUAL_INT(0, goes_on_screen);
+}
+
+static void test_new_frame_is_a_200_miss() {
+  const uint32_t before = image_area();
+  published[path_of(0)] = 2;
+  TEST_ASSERT_TRUE(nativeRunUntil(refreshed, UPDATE_INTERVAL + 10000));
+  TEST_ASSERT_EQUAL_UINT32(1, camera_cache[0].hits);
+  TEST_ASSERT_EQUAL_UINT32(2, camera_cache[0].misses);
+  TEST_ASSERT_EQUAL_STRING("\"v1\"", last_request(0)->header("If-None-Match").c_str());
+  TEST_ASSERT_EQUAL_STRING("\"v2\"", camera_cache[0].validator.etag);
+  TEST_ASSERT_TRUE(before != image_area());
+  TEST_ASSERT_EQUAL_INT(0, goes_on_screen);
+
+  // And the new ETag is what the next refresh sends
+  TEST_ASSERT_TRUE(nativeRunUntil([] { return camera_cache[0].hits == 2; }, UPDATE_INTERVAL + 10000));
+  TEST_ASSERT_EQUAL_STRING("\"v2\"", last_request(0)->header("If-None-Match").c_str());
+  TEST_ASSERT_EQUAL_UINT32(2, camera_cache[0].misses);
+}
+
+static void test_camera_off_screen_drops_its_validator() {
+  // To Sun & Moon and straight back, inside the prefetch idle time: the
+  // panel was repainted meanwhile, so a 304 would leave it blank
+  nativeRunFor(500);
+  nativeTap(NATIVE_TAP_PREV);
+  TEST_ASSERT_EQUAL_INT(SUN_MOON_MODE, wc_camera_idx);
+  TEST_ASSERT_EQUAL_INT(-1, goes_on_screen);
+  nativeRunFor(500);
+  nativeTap(NATIVE_TAP_NEXT);
+  TEST_ASSERT_EQUAL_INT(0, wc_camera_idx);
+
+  TEST_ASSERT_TRUE(nativeRunUntil([] { return goes_on_screen == 0; }, 10000));
+  TEST_ASSERT_EQUAL_STRING("", last_request(0)->header("If-None-Match").c_str());
+  TEST_ASSERT_EQUAL_UINT32(hits0, camera_cache[0].hits);
+  TEST_ASSERT_EQUAL_UINT32(misses0 + 1, camera_cache[0].misses);
+  TEST_ASSERT_EQUAL_STRING("\"v2\"", camera_cache[0].validator.etag);
+}
+
+int main(int argc, char **argv) {
+  standInHost(GOES, cdn).rtt_ms = 60;
+  nativeBoot();
+  UNITY_BEGIN();
+  RUN_TEST(test_first_fetch_is_a_miss_and_draws);
+  RUN_TEST(test_unchanged_frame_is_a_304_hit);
+  RUN_TEST(test_new_frame_is_a_200_miss);
+  RUN_TEST(test_camera_off_screen_drops_its_validator);
+  return UNITY_END();
+}
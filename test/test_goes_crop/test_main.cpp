@@ -0,0 +1,88 @@
+// Crop-to-screen GOES decode, per CAMERAS entry, on the JPEGDEC and panel
+// stand-ins: the firmware's layout with goesCropToScreen() against the same
+// layout decoded whole and clipped by the panel, as before. MCUs off screen
+// are still entropy-decoded (walked) but skip IDCT and the push; the panel
+// must come out pixel for pixel the same either way.
+//
+// The result is the MCU count per camera: exactly the MCUs that reach the
+// panel are drawn and the rest walked. The ms columns are a model, not a
+// measurement: the stand-in charges a fixed jpeg_native_us_idct per drawn
+// MCU and jpeg_native_us_walk per walked one, so the saving is just walked
+// MCUs times the difference. Real decode time of real frames is not here.
+#include <unity.h>
+
+#include "Firmware.h"
+#include "NoaaStandIn.h"
+
+static const char *path_of(int cam) { return CAMERAS[cam].url + strlen("https://" NOAA_GOES); }
+
+struct Decode { unsigned long us; uint32_t drawn, walked, screen; };
+
+// MCUs along one axis of n source pixels whose output (at offset off, `out`
+// output pixels per MCU) overlaps [0, panel)
+static int mcus_on_panel(int n, int off, int out, int panel) {
+  int k = 0;
+  for (int m = 0; m * 16 < n; m++) k += off + (m + 1) * out > 0 && off + m * out < panel;
+  return k;
+}
+
+static Decode decode(int cam, bool crop) {
+  gfx->fillScreen(RGB565_BLACK);
+  const std::string &f = noaaGoesFrame(path_of(cam), 1);
+  TEST_ASSERT_TRUE(jpeg.openRAM((uint8_t *)f.data(), (int)f.size(), JPEGDraw));
+  const unsigned long t0 = micros();
+  pipeStart();
+  jpeg.setPixelType(RGB565_BIG_ENDIAN);
+  int x, y, w, h;
+  const int scale = goesLayout(x, y, w, h);
+  if (crop) {
+    goesCropToScreen(x, y, scale);
+  } else {
+    goes_org_x    = x;
+    goes_org_y    = y;
+    goes_anchored = false;
+  }
+  TEST_ASSERT_TRUE(jpeg.decode(x, y, scale | JPEG_USES_DMA));
+  TEST_ASSERT_TRUE(pipeFlush());
+  const Decode d = { micros() - t0, jpeg_native_stats.mcus_drawn, jpeg_native_stats.mcus_walked,
+                     gfx->checksum(0, 0, gfx->width(), gfx->height()) };
+  jpeg.close();
+  return d;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_mcus_per_camera() {
+  printf("camera                     size     scale  whole: drawn   cropped: drawn walked"
+         "   model ms whole/cropped\n");
+  for (int cam = 0; cam < NUM_CAMERAS; cam++) {
+    const Decode whole = decode(cam, false);
+    const Decode crop  = decode(cam, true);
+    const int iw = jpeg.getWidth(), ih = jpeg.getHeight();
+    int x, y, w, h;
+    const int scale = goesLayout(x, y, w, h);
+    const int shift = scale == JPEG_SCALE_EIGHTH ? 3 : scale == JPEG_SCALE_QUARTER ? 2 : scale == JPEG_SCALE_HALF;
+    printf("%-26.26s %4dx%-4d 1/%d %13u %15u %6u   %6.1f / %.1f\n", CAMERAS[cam].name, iw, ih, 1 << shift,
+           (unsigned)whole.drawn, (unsigned)crop.drawn, (unsigned)crop.walked, whole.us / 1000.0,
+           crop.us / 1000.0);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(whole.screen, crop.screen, CAMERAS[cam].name);
+
+    // Whole: every MCU drawn. Cropped: at full size, exactly the MCUs that
+    // reach the panel; a scaled decode is not cropped
+    const uint32_t total = ((iw + 15) / 16) * ((ih + 15) / 16);
+    TEST_ASSERT_EQUAL_UINT32(total, whole.drawn);
+    TEST_ASSERT_EQUAL_UINT32(0, whole.walked);
+    const uint32_t on_panel = shift ? total
+                            : mcus_on_panel(iw, x, 16, gfx->width()) * mcus_on_panel(ih, y, 16, gfx->height());
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(on_panel, crop.drawn, CAMERAS[cam].name);
+    TEST_ASSERT_EQUAL_UINT32(total - on_panel, crop.walked);
+  }
+}
+
+int main(int argc, char **argv) {
+  nativeBoot();   // gfx up and the push task started; loop() is never run
+  UNITY_BEGIN();
+  RUN_TEST(test_mcus_per_camera);
+  return UNITY_END();
+}
@@ -0,0 +1,142 @@
+// Header-driven GOES layout (goesLayout) over several product sizes, through
+// the firmware's decode path on the JPEGDEC and panel stand-ins. The native
+// sizes must keep the offsets that used to be hand-tuned; a larger product
+// must decode at the cheapest 1/2^n scale that still covers 320x240,
+// centred. Quality is PSNR of the panel against a reference downscale (area
+// average of the full-resolution frame, laid out independently of
+// goesLayout), time is decode+display on the virtual clock against decoding
+// the whole frame at full size (the stand-in charges a scaled MCU its walk
+// plus a share of the IDCT that shrinks with its output pixels).
+//
+// The frames are detailed stand-ins: every pixel carries a ramp and a hash
+// on top of its MCU's colour, and a scaled decode runs the reduced IDCT on
+// each 8x8 block. That is not an area average, so the PSNR is the scaled
+// decode's real loss against the reference, not an exact match by
+// construction; a wrong scale or a frame off by a pixel still drops far
+// below the bound.
+#include <unity.h>
+
+#include <cmath>
+
+#include "Firmware.h"
+#include "NoaaStandIn.h"
+
+#define MCU 16
+
+static uint16_t colour_at(int mx, int my) {
+  return (uint16_t)((((mx * 7 + my * 3) & 31) << 11) | (((mx * 5 + my * 11) & 63) << 5) | ((mx * 13 + my * 2) & 31));
+}
+
+// Area average of the full-resolution w x h frame by 2^shift, placed the way
+// the panel should show it
+static std::vector<uint16_t> reference(int w, int h, int shift, int &x0, int &y0) {
+  const int pw = gfx->width(), ph = gfx->height(), k = 1 << shift;
+  const int ow = w >> shift, oh = h >> shift;
+  x0 = (pw - ow) / 2;
+  y0 = (ph - oh) / 2;
+  std::vector<uint16_t> ref(pw * ph, RGB565_BLACK);
+  for (int y = max(0, y0); y < min(ph, y0 + oh); y++)
+    for (int x = max(0, x0); x < min(pw, x0 + ow); x++) {
+      double r = 0, g = 0, b = 0;
+      for (int j = 0; j < k; j++)
+        for (int i = 0; i < k; i++) {
+          const int sx = (x - x0) * k + i, sy = (y - y0) * k + j;
+          const uint16_t c = jpegStandInPixel(colour_at(sx / MCU, sy / MCU), sx, sy);
+          r += c >> 11;
+          g += (c >> 5) & 63;
+          b += c & 31;
+        }
+      const int n = k * k;
+      ref[y * pw + x] = (uint16_t)((lround(r / n) << 11) | (lround(g / n) << 5) | lround(b / n));
+    }
+  return ref;
+}
+
+// PSNR over the panel, each RGB565 channel against its own full scale
+static double psnr(const std::vector<uint16_t> &ref) {
+  const int pw = gfx->width(), ph = gfx->height();
+  double se = 0;
+  for (int y = 0; y < ph; y++)
+    for (int x = 0; x < pw; x++) {
+      const uint16_t a = gfx->pixel(x, y), b = ref[y * pw + x];
+      const double dr = ((a >> 11) - (b >> 11)) / 31.0;
+      const double dg = (((a >> 5) & 63) - ((b >> 5) & 63)) / 63.0;
+      const double db = ((a & 31) - (b & 31)) / 31.0;
+      se += (dr * dr + dg * dg + db * db) / 3;
+    }
+  return se ? 10 * std::log10(pw * ph / se) : INFINITY;
+}
+
+// Decode f onto a cleared panel, laid out by goesLayout() and cropped as
+// goesDecodeOpened() does, or (scaled = false) the whole frame at full size
+// clipped by the panel. Virtual microseconds from the first MCU to the last pixel.
+static unsigned long decode(const std::string &f, bool scaled) {
+  gfx->fillScreen(RGB565_BLACK);
+  TEST_ASSERT_TRUE(jpeg.openRAM((uint8_t *)f.data(), (int)f.size(), JPEGDraw));
+  const unsigned long t0 = micros();
+  pipeStart();
+  jpeg.setPixelType(RGB565_BIG_ENDIAN);
+  int x = 0, y = 0, w, h, scale = 0;
+  if (scaled) {
+    scale = goesLayout(x, y, w, h);
+    goesCropToScreen(x, y, scale);
+  } else {
+    goes_org_x = goes_org_y = 0;
+    goes_anchored = false;
+  }
+  TEST_ASSERT_TRUE(jpeg.decode(x, y, scale | JPEG_USES_DMA));
+  TEST_ASSERT_TRUE(pipeFlush());
+  jpeg.close();
+  return micros() - t0;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_native_sizes_keep_their_offsets() {
+  static const struct { int w, h, x, y; } native[] = {
+    { 416, 250, -48, -5 }, { 250, 250, 35, -5 }, { 339, 339, -9, -49 },
+  };
+  for (const auto &n : native) {
+    const std::string f = jpegStandInFile(n.w, n.h, MCU, 16, colour_at);
+    TEST_ASSERT_TRUE(jpeg.openRAM((uint8_t *)f.data(), (int)f.size(), JPEGDraw));
+    int x, y, w, h;
+    TEST_ASSERT_EQUAL_INT(0, goesLayout(x, y, w, h));
+    jpeg.close();
+    TEST_ASSERT_EQUAL_INT(n.x, x);
+    TEST_ASSERT_EQUAL_INT(n.y, y);
+  }
+}
+
+static void test_scaled_decode_per_size() {
+  static const struct { int w, h, shift; } sizes[] = {
+    { 416, 250, 0 }, { 832, 500, 1 }, { 1250, 750, 1 }, { 2500, 1500, 2 },
+    { 339, 339, 0 }, { 678, 678, 1 }, { 1356, 1356, 2 }, { 1400, 520, 1 },   // height decides
+  };
+  printf("source      scale  full size ms  scaled ms   PSNR\n");
+  for (const auto &s : sizes) {
+    const std::string f = jpegStandInFile(s.w, s.h, MCU, 16, colour_at, true);
+    const unsigned long full = decode(f, false);
+    const unsigned long us = decode(f, true);
+    int x0, y0;
+    const std::vector<uint16_t> ref = reference(s.w, s.h, s.shift, x0, y0);
+    const double db = psnr(ref);
+    printf("%4dx%-5d   1/%d %12.1f %10.1f %6.1f dB\n", s.w, s.h, 1 << s.shift, full / 1000.0, us / 1000.0, db);
+    char msg[24];
+    snprintf(msg, sizeof(msg), "%dx%d", s.w, s.h);
+    // Full size is the frame's own pixels; a reduced IDCT loses its top
+    // frequencies (~35 dB at 1/2, ~37.6 dB at 1/4), a frame off by a pixel
+    // scores under 20 dB
+    if (!s.shift) TEST_ASSERT_TRUE_MESSAGE(std::isinf(db), msg);
+    else          TEST_ASSERT_TRUE_MESSAGE(db >= 33.0, msg);
+    if (s.shift) TEST_ASSERT_LESS_THAN_UINT32_MESSAGE(full / 2, us, msg);
+  }
+}
+
+int main(int argc, char **argv) {
+  nativeBoot();   // gfx up and the push task started; loop() is never run
+  UNITY_BEGIN();
+  RUN_TEST(test_native_sizes_keep_their_offsets);
+  RUN_TEST(test_scaled_decode_per_size);
+  return UNITY_END();
+}
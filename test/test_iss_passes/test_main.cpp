@@ -0,0 +1,199 @@
+// ISS pass prediction, first against a brute-force scan of its own model:
+// the same SGP4 and elevation model sampled every second over the day. The
+// coarse scan plus golden-section and bisection search must find the same
+// passes with AOS, culmination and LOS within a couple of seconds, for a
+// small fraction of the propagations. A search started in the middle of a
+// pass, before or after its culmination, must still report that pass first.
+//
+// Then against an independent pass list: the same SGP4 state, but a proper
+// topocentric look angle (TEME to Earth-fixed by sidereal time, minus the
+// observer's WGS-84 position, elevation off the ellipsoid normal) where the
+// firmware uses a spherical Earth and a haversine on geodetic latitude.
+// That difference is the predictor's systematic AOS/LOS error, measured.
+// Last, host wall time per 24 h search against the 100 ms budget.
+#include <unity.h>
+
+#include <chrono>
+#include <vector>
+
+#include "ISSTracker.h"
+
+Arduino_GFX *gfx = nullptr;
+
+static const char *L1 = "1 25544U 98067A   24173.50000000  .00016717  00000-0  30306-3 0  9999";
+static const char *L2 = "2 25544  51.6410 261.2530 0010120  31.7050 328.4530 15.49815350460004";
+static const float LAT = 40.015f, LON = -105.2705f;   // Boulder, CO
+
+static IssOrbit orbit;
+static std::vector<IssPass> ref;   // every pass in the day after epoch, to the second
+
+static void reference_passes(double from, double to) {
+  bool up = false;
+  IssPass p = {};
+  for (double t = from; t <= to; t += 1.0) {
+    float e = iss_elev_at(&orbit, LAT, LON, t);
+    if (e >= 0.0f && !up) p = { t, t, t, e };
+    if (e >= 0.0f && e > p.max_el) { p.tmax = t; p.max_el = e; }
+    if (e < 0.0f && up) { p.los = t - 1.0; ref.push_back(p); }
+    up = e >= 0.0f;
+  }
+}
+
+// ── Independent reference: topocentric elevation on the WGS-84 ellipsoid ───
+
+// Elevation (degrees) of the SGP4 position above the observer's horizon
+static double true_elev_at(double t) {
+  double r[3], v[3];
+  if (!sgp4Propagate(&orbit.sat, sgp4Minutes(&orbit.sat, t), r, v)) return -90.0;
+  // TEME -> pseudo Earth-fixed: rotate by GMST (IAU-82; polar motion is metres)
+  const double T   = (t / 86400.0 + 2440587.5 - 2451545.0) / 36525.0;
+  const double sec = 67310.54841 + (876600.0 * 3600.0 + 8640184.812866) * T + 0.093104 * T * T - 6.2e-6 * T * T * T;
+  const double th  = fmod(sec, 86400.0) / 86400.0 * 2.0 * M_PI;
+  const double x = cos(th) * r[0] + sin(th) * r[1], y = -sin(th) * r[0] + cos(th) * r[1], z = r[2];
+  // Observer on the ellipsoid, and the ellipsoid normal there
+  const double a = 6378.137, f = 1.0 / 298.257223563, e2 = f * (2.0 - f);
+  const double la = LAT * M_PI / 180.0, lo = LON * M_PI / 180.0;
+  const double N  = a / sqrt(1.0 - e2 * sin(la) * sin(la));
+  const double o[3]  = { N * cos(la) * cos(lo), N * cos(la) * sin(lo), N * (1.0 - e2) * sin(la) };
+  const double up[3] = { cos(la) * cos(lo), cos(la) * sin(lo), sin(la) };
+  const double d[3]  = { x - o[0], y - o[1], z - o[2] };
+  const double rho = sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+  return asin((d[0] * up[0] + d[1] * up[1] + d[2] * up[2]) / rho) * 180.0 / M_PI;
+}
+
+// Horizon crossing of true_elev_at in [a, b] to a millisecond
+static double true_crossing(double a, double b, bool rising) {
+  while (b - a > 1e-3) {
+    const double m = 0.5 * (a + b);
+    if ((true_elev_at(m) >= 0.0) == rising) b = m;
+    else                                     a = m;
+  }
+  return 0.5 * (a + b);
+}
+
+static std::vector<IssPass> truth;   // the same day's passes, true look angle
+
+static void true_passes(double from, double to) {
+  bool up = false;
+  IssPass p = {};
+  for (double t = from; t <= to; t += 1.0) {
+    const double e = true_elev_at(t);
+    if (e >= 0.0 && !up) p = { true_crossing(t - 1.0, t, true), t, 0, (float)e };
+    if (e >= 0.0 && e > p.max_el) { p.tmax = t; p.max_el = (float)e; }
+    if (e < 0.0 && up) {
+      p.los = true_crossing(t - 1.0, t, false);
+      // Culmination to 10 ms around the best whole second
+      for (double u = p.tmax - 1.0; u <= p.tmax + 1.0; u += 0.01) {
+        const double eu = true_elev_at(u);
+        if (eu > p.max_el) { p.tmax = u; p.max_el = (float)eu; }
+      }
+      truth.push_back(p);
+    }
+    up = e >= 0.0;
+  }
+}
+
+static void assert_same_pass(const IssPass &want, const IssPass &got) {
+  TEST_ASSERT_DOUBLE_WITHIN(2.0, want.aos, got.aos);
+  TEST_ASSERT_DOUBLE_WITHIN(2.0, want.los, got.los);
+  // The peak is flat: a few seconds either side is the same elevation. Near
+  // the zenith it is sharp instead, and there the 1 s grid is what misses
+  // the top by a few hundredths of a degree
+  TEST_ASSERT_DOUBLE_WITHIN(5.0, want.tmax, got.tmax);
+  TEST_ASSERT_FLOAT_WITHIN(0.1f, want.max_el, got.max_el);
+  TEST_ASSERT_TRUE(got.max_el >= want.max_el - 0.01f);
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_search_matches_the_reference() {
+  const double from = orbit.sat.epoch_unix;
+  iss_find_passes(&orbit, LAT, LON, from);
+  const uint32_t evals = iss_evals;
+  TEST_ASSERT_EQUAL_INT(min((int)ref.size(), ISS_MAX_PASSES), orbit.npass);
+
+  printf("pass  AOS err  TCA err  LOS err  max el (ref)\n");
+  for (int i = 0; i < orbit.npass; i++) {
+    const IssPass &p = orbit.pass[i], &r = ref[i];
+    printf("%4d %7.1fs %7.1fs %7.1fs  %5.2f (%5.2f)\n", i, p.aos - r.aos, p.tmax - r.tmax,
+           p.los - r.los, p.max_el, r.max_el);
+    assert_same_pass(r, p);
+  }
+  const double span = orbit.scanned_until - from;
+  printf("search: %u SGP4 steps to cover %.1f h; the 1 s reference takes %.0f\n", (unsigned)evals,
+         span / 3600.0, span);
+  TEST_ASSERT_LESS_THAN_UINT32(span / 50, evals);
+}
+
+static void test_search_from_inside_a_pass() {
+  const IssPass &r = ref[1];
+  const double starts[] = {
+    r.aos + 30,                       // rising
+    r.tmax + 20,                      // just past culmination, inside the first step
+    r.tmax + 0.6 * (r.los - r.tmax),  // sinking, culmination well behind
+    r.los - 5,                        // about to set
+  };
+  for (double from : starts) {
+    iss_find_passes(&orbit, LAT, LON, from);
+    TEST_ASSERT_TRUE(orbit.npass > 0);
+    printf("from AOS%+5.0fs: first pass AOS%+5.1fs, max el %.2f\n", from - r.aos,
+           orbit.pass[0].aos - r.aos, orbit.pass[0].max_el);
+    assert_same_pass(r, orbit.pass[0]);
+    // and the next one after it, not the same pass twice
+    if (orbit.npass > 1) assert_same_pass(ref[2], orbit.pass[1]);
+  }
+}
+
+static void test_accuracy_against_true_look_angles() {
+  const double from = orbit.sat.epoch_unix;
+  iss_find_passes(&orbit, LAT, LON, from);
+  TEST_ASSERT_EQUAL_INT(min((int)truth.size(), ISS_MAX_PASSES), orbit.npass);
+
+  double worst_t = 0, worst_el = 0;
+  printf("pass  AOS err  TCA err  LOS err  max el (true)\n");
+  for (int i = 0; i < orbit.npass; i++) {
+    const IssPass &p = orbit.pass[i], &r = truth[i];
+    printf("%4d %7.1fs %7.1fs %7.1fs  %5.2f (%5.2f)\n", i, p.aos - r.aos, p.tmax - r.tmax,
+           p.los - r.los, p.max_el, r.max_el);
+    worst_t  = max(worst_t, max(fabs(p.aos - r.aos), fabs(p.los - r.los)));
+    worst_el = max(worst_el, fabs((double)p.max_el - r.max_el));
+    TEST_ASSERT_DOUBLE_WITHIN(5.0, r.tmax, p.tmax);
+  }
+  printf("spherical Earth vs WGS-84 look angle: AOS/LOS off by up to %.1f s, max el by %.2f deg\n",
+         worst_t, worst_el);
+  // The geodetic latitudes on both ends of the haversine largely cancel, so
+  // the sphere costs under a second at the horizon and hundredths of a degree
+  // at the top. Putting the observer 0.19 deg off (geocentric latitude) would
+  // cost 4.6 s and 2.4 deg
+  TEST_ASSERT_TRUE(worst_t < 2.0);
+  TEST_ASSERT_TRUE(worst_el < 0.25);
+}
+
+static void test_search_time() {
+  const double from = orbit.sat.epoch_unix;
+  double best = 1e9;
+  for (int rep = 0; rep < 20; rep++) {
+    auto t0 = std::chrono::steady_clock::now();
+    iss_find_passes(&orbit, LAT, LON, from);
+    auto t1 = std::chrono::steady_clock::now();
+    best = min(best, std::chrono::duration<double, std::milli>(t1 - t0).count());
+  }
+  printf("24 h search on the host: %.3f ms wall (best of 20), %u SGP4 steps\n", best, (unsigned)iss_evals);
+  // The ESP32 does double in software, far more than ten times slower per
+  // step (test_sgp4), so the host has to come in well under a tenth of the
+  // 100 ms budget for the device to make it
+  TEST_ASSERT_TRUE(best < 10.0);
+}
+
+int main(int argc, char **argv) {
+  TEST_ASSERT_TRUE(sgp4Parse(L1, L2, &orbit.sat));
+  reference_passes(orbit.sat.epoch_unix - 900, orbit.sat.epoch_unix + ISS_PASS_WINDOW);
+  true_passes(orbit.sat.epoch_unix - 900, orbit.sat.epoch_unix + ISS_PASS_WINDOW);
+  UNITY_BEGIN();
+  RUN_TEST(test_search_matches_the_reference);
+  RUN_TEST(test_search_from_inside_a_pass);
+  RUN_TEST(test_accuracy_against_true_look_angles);
+  RUN_TEST(test_search_time);
+  return UNITY_END();
+}
@@ -0,0 +1,156 @@
+// Streaming GOES decode: peak heap and time to last pixel for CONUS, a
+// sector and Full Disk, against downloading the whole file first.
+//
+// The images are stand-in JPEGs (see JPEGDEC.h) the size of the real
+// thumbnails, dripped by the server in 1460 B segments. Decode time is the
+// stand-in decoder's per-MCU cost on the virtual clock, so the numbers show
+// how decoding overlaps the transfer, not how fast the ESP32 is.
+#include <unity.h>
+
+#include "NativeHeap.h"
+#include "HTTPS.h"
+
+#define GOES "cdn.star.nesdis.noaa.gov"
+#define SEG_BYTES 1460
+#define SEG_MS    5          // ~290 KB/s
+
+struct Frame {
+  const char *name;
+  int         w, h;
+  std::string file;
+};
+
+static Frame frames[] = {
+  { "CONUS",     416, 250, "" },
+  { "sector",    600, 600, "" },
+  { "Full Disk", 678, 678, "" },
+};
+
+static uint16_t color_at(int mx, int my) { return (uint16_t)(mx * 2113 + my * 977); }
+
+static StandInReply serve(const StandInRequest &r) {
+  for (auto &f : frames) {
+    if (r.path != std::string("/") + f.name) continue;
+    StandInReply reply;
+    std::string body = f.file;
+    reply.send(standInHead(200, "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n"));
+    for (size_t i = 0, k = 1; i < body.size(); i += SEG_BYTES, k++)
+      reply.send(body.substr(i, SEG_BYTES), k * SEG_MS);
+    return reply;
+  }
+  return StandInReply().send(standInResponse(404, ""));
+}
+
+// Checks every pixel of every strip against the MCU colour it came from
+static uint32_t       drawn_px, bad_px;
+static unsigned long  last_px_ms;
+static int JPEGDraw(JPEGDRAW *d) {
+  for (int r = 0; r < d->iHeight; r++) {
+    for (int i = 0; i < d->iWidthUsed; i++) {
+      if (d->pPixels[r * d->iWidth + i] != color_at((d->x + i) / 16, (d->y + r) / 16)) bad_px++;
+      drawn_px++;
+    }
+  }
+  last_px_ms = millis();
+  return 1;
+}
+
+struct Run {
+  int64_t       peak;        // heap above the idle baseline
+  unsigned long last_px;     // request to last pixel
+  unsigned long transfer;    // request to last body byte
+};
+
+static unsigned long transfer_ms(const Frame &f) {
+  return ((f.file.size() + SEG_BYTES - 1) / SEG_BYTES) * SEG_MS;
+}
+
+static void expect_whole_frame(const Frame &f) {
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, bad_px, f.name);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(f.w * ((f.h + 15) / 16 * 16), drawn_px, f.name);   // whole MCU rows
+}
+
+// The firmware path: decode straight off the socket
+static Run run_stream(const Frame &f) {
+  drawn_px = bad_px = 0;
+  const int64_t base = native_heap_used;
+  nativeHeapPeakReset();
+  const unsigned long t0 = millis();
+  TEST_ASSERT_TRUE_MESSAGE(https_open_jpeg_stream(String("https://" GOES "/") + f.name, JPEGDraw), f.name);
+  TEST_ASSERT_EQUAL_INT_MESSAGE(1, jpeg.decode(0, 0, 0), f.name);
+  jpeg.close();
+  expect_whole_frame(f);
+  return { nativeHeapPeakAbove(base), last_px_ms - t0, transfer_ms(f) };
+}
+
+// The old path: the whole file into RAM, then decode
+static Run run_buffered(const Frame &f) {
+  drawn_px = bad_px = 0;
+  const int64_t base = native_heap_used;
+  nativeHeapPeakReset();
+  const unsigned long t0 = millis();
+  HttpsJpeg *j = https_get_jpeg_buf(String("https://" GOES "/") + f.name, 512 * 1024);
+  TEST_ASSERT_NOT_NULL_MESSAGE(j, f.name);
+  TEST_ASSERT_TRUE(jpeg.openRAM(j->buf, j->len, JPEGDraw));
+  TEST_ASSERT_EQUAL_INT_MESSAGE(1, jpeg.decode(0, 0, 0), f.name);
+  jpeg.close();
+  https_jpeg_free(j);
+  expect_whole_frame(f);
+  return { nativeHeapPeakAbove(base), last_px_ms - t0, transfer_ms(f) };
+}
+
+void setUp() {
+  pool_close_all();
+  standInReset();
+  standInHost(GOES, serve);
+  // One request to open the session, so the runs measure only the image
+  HttpsJpeg *warm = https_get_jpeg_buf("https://" GOES "/CONUS", 512 * 1024);
+  https_jpeg_free(warm);
+}
+
+void tearDown() {}
+
+static void test_stream_peak_heap_is_the_ring_not_the_image() {
+  TEST_ASSERT_TRUE_MESSAGE(NATIVE_HEAP_TRACKED, "heap tracking needs glibc");
+  printf("%-10s %8s | %-26s | %-26s\n", "", "", "streamed", "buffered");
+  printf("%-10s %8s | %8s %8s %8s | %8s %8s %8s\n", "frame", "bytes", "peak B", "last px", "transfer",
+         "peak B", "last px", "transfer");
+  for (auto &f : frames) {
+    Run s = run_stream(f);
+    Run b = run_buffered(f);
+    printf("%-10s %8u | %8lld %6lums %6lums | %8lld %6lums %6lums\n", f.name, (unsigned)f.file.size(),
+           (long long)s.peak, s.last_px, s.transfer, (long long)b.peak, b.last_px, b.transfer);
+
+    // Streaming holds the ring and a few small objects, whatever the image size
+    TEST_ASSERT_LESS_OR_EQUAL_INT64_MESSAGE((int64_t)sizeof(JpegStream) + 1024, s.peak, f.name);
+    TEST_ASSERT_GREATER_OR_EQUAL_INT64_MESSAGE((int64_t)f.file.size(), b.peak, f.name);
+  }
+}
+
+static void test_stream_decode_overlaps_the_transfer() {
+  for (auto &f : frames) {
+    const unsigned long cpu_ms =
+      (unsigned long)((f.w + 15) / 16) * ((f.h + 15) / 16) * jpeg_native_us_idct / 1000;
+    Run s = run_stream(f);
+    Run b = run_buffered(f);
+    // Buffered pays transfer + decode; streamed finishes close to the last byte
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32_MESSAGE(b.transfer + cpu_ms, b.last_px, f.name);
+    TEST_ASSERT_LESS_THAN_UINT32_MESSAGE(s.transfer + cpu_ms / 2, s.last_px, f.name);
+  }
+}
+
+static void test_full_disk_exceeds_the_old_100k_cap() {
+  TEST_ASSERT_GREATER_THAN_UINT32(100 * 1024, frames[2].file.size());
+  Run s = run_stream(frames[2]);
+  TEST_ASSERT_LESS_THAN_INT64(16 * 1024, s.peak);
+}
+
+int main(int argc, char **argv) {
+  // Entropy bytes per 16x16 MCU in line with the real thumbnails' sizes
+  for (auto &f : frames) f.file = jpegStandInFile(f.w, f.h, 16, 96, color_at);
+  UNITY_BEGIN();
+  RUN_TEST(test_stream_peak_heap_is_the_ring_not_the_image);
+  RUN_TEST(test_stream_decode_overlaps_the_transfer);
+  RUN_TEST(test_full_disk_exceeds_the_old_100k_cap);
+  return UNITY_END();
+}
@@ -0,0 +1,204 @@
+// Streaming JSON on recorded-shape api.weather.gov payloads (fixtures/): the
+// forecast and alerts parsers pull out exactly their fields, and peak heap
+// while parsing is set by what they keep, not by the 11-14 KB bodies. Then
+// JsonStream.h's limits: 16 levels of nesting (one more is a bad body, not
+// an overrun), keys past 23 characters cut and never matching, and the
+// 64 KB drain cap that decides between keeping and closing the session.
+//
+// Parse time is host wall-clock per call (the virtual clock only moves on
+// the network), so it is a relative figure, not the ESP32's.
+#include <unity.h>
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+#include "NativeHeap.h"
+#include "Firmware.h"
+#include "NoaaStandIn.h"
+
+#define JSON_HOST "json.test"
+
+static std::string fixture(const char *name) {
+  std::string dir = __FILE__;
+  dir.erase(dir.find_last_of('/') + 1);
+  std::ifstream f(dir + "fixtures/" + name, std::ios::binary);
+  std::stringstream ss;
+  ss << f.rdbuf();
+  return ss.str();
+}
+
+static std::string forecast_json, alerts_json;
+static std::map<std::string, std::string> bodies;   // JSON_HOST path -> body
+
+static StandInReply nws(const StandInRequest &r) {
+  static const std::string json = "Content-Type: application/geo+json\r\n";
+  if (r.path.compare(0, 8, "/points/") == 0) return standInOk(noaaPointsJson(r.path.substr(8)), json);
+  if (r.path == noaaGridPath(noaa()) + "/forecast") return standInOk(forecast_json, json);
+  if (r.path.compare(0, 15, "/alerts/active?") == 0) return standInOk(alerts_json, json);
+  return StandInReply().send(standInResponse(404, ""));
+}
+
+static StandInReply json_host(const StandInRequest &r) {
+  return standInOk(bodies[r.path], "Content-Type: application/json\r\n");
+}
+
+// Heap above the idle baseline while fn runs, and host microseconds per call
+struct Cost { int64_t peak; double us; };
+template <class Fn> static Cost measure(Fn fn, int reps = 50) {
+  fn();   // warm: the session is pooled from here on
+  const int64_t base = native_heap_used;
+  nativeHeapPeakReset();
+  fn();
+  const int64_t peak = nativeHeapPeakAbove(base);
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < reps; i++) fn();
+  auto t1 = std::chrono::steady_clock::now();
+  return { peak, std::chrono::duration<double, std::micro>(t1 - t0).count() / reps };
+}
+
+void setUp() {}
+void tearDown() {}
+
+// ── NWS parsers on the fixtures ─────────────────────────────────────────────
+
+static void test_forecast_fields_and_cost() {
+  TEST_ASSERT_TRUE_MESSAGE(NATIVE_HEAP_TRACKED, "heap tracking needs glibc");
+  NwsForecastData *d = nwsFetchForecast("39.7392", "-104.9903");
+  TEST_ASSERT_NOT_NULL(d);
+  TEST_ASSERT_EQUAL_STRING("This Afternoon", d->p0Name.c_str());
+  TEST_ASSERT_EQUAL_STRING("A chance of showers and thunderstorms after 2pm. Partly sunny, with a high near 91. "
+                           "South southeast wind 5 to 10 mph, with gusts as high as 20 mph. Chance of "
+                           "precipitation is 40%. New rainfall amounts less than a tenth of an inch possible.",
+                           d->p0Detail.c_str());
+  TEST_ASSERT_EQUAL_STRING("Tonight", d->p1Name.c_str());
+  TEST_ASSERT_EQUAL_STRING("A chance of showers and thunderstorms before midnight. Mostly clear, with a low "
+                           "around 63. South southwest wind 5 to 10 mph, with gusts as high as 20 mph. "
+                           "Chance of precipitation is 30%.", d->p1Detail.c_str());
+  const size_t kept = sizeof(*d) + d->p0Name.length() + d->p0Detail.length() + d->p1Name.length() + d->p1Detail.length();
+  delete d;
+
+  const Cost c = measure([] { delete nwsFetchForecast("39.7392", "-104.9903"); });
+  printf("forecast: %u B body, %lld B peak heap (%u B kept), %.1f us/parse on the host; "
+         "getString() + 8 KB document held %u B\n", (unsigned)forecast_json.size(), (long long)c.peak,
+         (unsigned)kept, c.us, (unsigned)(forecast_json.size() + 8192));
+  // The fields plus the URL and request Strings, nowhere near the body
+  TEST_ASSERT_LESS_OR_EQUAL_INT64((int64_t)kept + 1024, c.peak);
+  TEST_ASSERT_LESS_THAN_INT64((int64_t)forecast_json.size() / 4, c.peak);
+}
+
+static void test_alerts_fields_and_cost() {
+  bool unchanged;
+  nws_alerts_where[0] = '\0';   // first poll at this location
+  NwsAlertsData *d = nwsFetchAlerts("39.7392", "-104.9903", &unchanged);
+  TEST_ASSERT_NOT_NULL(d);
+  TEST_ASSERT_FALSE(unchanged);
+  TEST_ASSERT_EQUAL_INT(3, d->count);
+  TEST_ASSERT_EQUAL_STRING("Severe Thunderstorm Warning", d->event[0].c_str());
+  TEST_ASSERT_EQUAL_STRING("Flood Watch", d->event[1].c_str());
+  TEST_ASSERT_EQUAL_STRING("Severe Thunderstorm Warning issued June 21 at 11:46AM MDT until June 21 at "
+                           "12:30PM MDT by NWS Boulder CO", d->headline[0].c_str());
+  TEST_ASSERT_EQUAL_STRING("Flood Watch issued June 21 at 10:12AM MDT until June 21 at 9:00PM MDT by NWS "
+                           "Boulder CO", d->headline[1].c_str());
+  TEST_ASSERT_EQUAL_STRING("Severe Thunderstorm Warning", d->banner);
+  TEST_ASSERT_EQUAL_INT(3, nws_alerts_seen_n);
+  delete d;
+
+  // A re-poll of the same set parses the body and keeps nothing
+  TEST_ASSERT_NULL(nwsFetchAlerts("39.7392", "-104.9903", &unchanged));
+  TEST_ASSERT_TRUE(unchanged);
+
+  const Cost c = measure([] {
+    bool u;
+    nws_alerts_where[0] = '\0';
+    delete nwsFetchAlerts("39.7392", "-104.9903", &u);
+  });
+  printf("alerts: %u B body, %lld B peak heap, %.1f us/parse on the host\n",
+         (unsigned)alerts_json.size(), (long long)c.peak, c.us);
+  TEST_ASSERT_LESS_THAN_INT64(2048, c.peak);
+  TEST_ASSERT_LESS_THAN_INT64((int64_t)alerts_json.size() / 4, c.peak);
+}
+
+// ── JsonStream.h limits ─────────────────────────────────────────────────────
+
+struct Seen {
+  int         values = 0, deepest = 0;
+  std::string last_key;
+  bool        matched_full = false, matched_cut = false;
+  bool        stop_at_first = false;
+};
+
+static void seen_sink(void *ctx, JsonStream *js, const char *text, size_t len, bool isString, bool done) {
+  Seen *s = (Seen *)ctx;
+  s->values++;
+  s->deepest = max(s->deepest, js->depth);
+  if (js->depth > 0 && !js->level[js->depth - 1].array) s->last_key = js->level[js->depth - 1].key;
+  s->matched_full |= jsonPathIs(js, "abcdefghijklmnopqrstuvwxyz0123");
+  s->matched_cut  |= jsonPathIs(js, "abcdefghijklmnopqrstuvw");
+  if (s->stop_at_first) js->stop = true;
+}
+
+static int get(const std::string &path, Seen *s) {
+  return jsonStreamGet(String("https://" JSON_HOST) + path.c_str(), nullptr, "test", seen_sink, s);
+}
+
+static void test_sixteen_levels_deep() {
+  bodies["/16"] = std::string(16, '[') + "1" + std::string(16, ']');
+  bodies["/17"] = std::string(17, '[') + "1" + std::string(17, ']');
+  Seen s16, s17;
+  TEST_ASSERT_EQUAL_INT(HTTP_CODE_OK, get("/16", &s16));
+  TEST_ASSERT_EQUAL_INT(1, s16.values);
+  TEST_ASSERT_EQUAL_INT(JSON_STREAM_DEPTH, s16.deepest);
+  // One level past the stack is refused as a bad body, never written past it
+  TEST_ASSERT_EQUAL_INT(JSON_STREAM_BAD_BODY, get("/17", &s17));
+  TEST_ASSERT_EQUAL_INT(0, s17.values);
+}
+
+static void test_long_keys_are_cut_and_never_match() {
+  Seen s;
+  bodies["/keys"] = "{\"abcdefghijklmnopqrstuvwxyz0123\":1}";
+  TEST_ASSERT_EQUAL_INT(HTTP_CODE_OK, get("/keys", &s));
+  TEST_ASSERT_EQUAL_UINT32(JSON_STREAM_KEY - 1, s.last_key.size());
+  const std::string kept = s.last_key.substr(0, JSON_STREAM_KEY - 2);
+  TEST_ASSERT_EQUAL_STRING("abcdefghijklmnopqrstuv", kept.c_str());
+  TEST_ASSERT_FALSE(s.matched_full);
+  TEST_ASSERT_FALSE(s.matched_cut);   // nor a 23-character key it starts with
+
+  Seen fits;
+  bodies["/fits"] = "{\"abcdefghijklmnopqrstuvw\":2}";
+  TEST_ASSERT_EQUAL_INT(HTTP_CODE_OK, get("/fits", &fits));
+  TEST_ASSERT_TRUE(fits.matched_cut);
+}
+
+static void test_drain_cap_decides_the_session() {
+  // The sink stops at the first value; the rest has to be drained or dropped
+  bodies["/small"] = "{\"a\":1,\"pad\":\"" + std::string(JSON_STREAM_DRAIN / 2, 'x') + "\"}";
+  bodies["/large"] = "{\"a\":1,\"pad\":\"" + std::string(JSON_STREAM_DRAIN + 4096, 'x') + "\"}";
+  Seen s;
+  s.stop_at_first = true;
+  TEST_ASSERT_EQUAL_INT(HTTP_CODE_OK, get("/small", &s));   // session now warm
+
+  uint32_t hs = pool_handshakes;
+  TEST_ASSERT_EQUAL_INT(HTTP_CODE_OK, get("/small", &s));
+  TEST_ASSERT_EQUAL_INT(HTTP_CODE_OK, get("/small", &s));
+  TEST_ASSERT_EQUAL_UINT32(hs, pool_handshakes);            // drained, reused
+
+  TEST_ASSERT_EQUAL_INT(HTTP_CODE_OK, get("/large", &s));
+  TEST_ASSERT_EQUAL_UINT32(hs, pool_handshakes);
+  TEST_ASSERT_EQUAL_INT(HTTP_CODE_OK, get("/small", &s));
+  TEST_ASSERT_EQUAL_UINT32(hs + 1, pool_handshakes);        // past the cap it was closed
+}
+
+int main(int argc, char **argv) {
+  forecast_json = fixture("forecast.json");
+  alerts_json   = fixture("alerts.json");
+  standInHost(NOAA_NWS, nws).handshake_ms = 300;
+  standInHost(JSON_HOST, json_host).handshake_ms = 300;
+  UNITY_BEGIN();
+  RUN_TEST(test_forecast_fields_and_cost);
+  RUN_TEST(test_alerts_fields_and_cost);
+  RUN_TEST(test_sixteen_levels_deep);
+  RUN_TEST(test_long_keys_are_cut_and_never_match);
+  RUN_TEST(test_drain_cap_decides_the_session);
+  return UNITY_END();
+}
@@ -0,0 +1,115 @@
+// loop() latency while the fetch worker is busy: the firmware boots against
+// slow stand-ins for every service (multi-second NWS, SWPC, CelesTrak and
+// GOES transfers) and the test times each loop() pass until every source
+// has loaded. Before the worker, loop() ran each fetch itself, so its worst
+// pass was the longest fetch; now it should only ever wait for the panel.
+//
+// Times are virtual (NativeRTOS.h): the network is the stand-in's pacing,
+// the panel is 40 MHz SPI per pixel pushed (Arduino_GFX_Library.h) and
+// decoding is JPEGDEC.h's per-MCU cost. Pure computation is free, so the
+// numbers are a lower bound on the board's.
+#include <unity.h>
+
+#include "Firmware.h"
+#include "NoaaStandIn.h"
+
+#define LOOP_IDLE_US (50 * 1000UL)   // the delay() that ends every loop() pass
+
+static unsigned long worst_us, worst_busy_us, passes, busy_passes;
+static unsigned long job_start, longest_job_ms;
+static int           job_mode = -1, longest_job_mode = -1;
+
+// One loop() pass, timed without its closing delay()
+static unsigned long timed_loop() {
+  const bool busy = fetch_running >= 0 || prefetch_running >= 0;
+  const unsigned long t0 = micros();
+  loop();
+  const unsigned long took = micros() - t0 - LOOP_IDLE_US;
+  worst_us = max(worst_us, took);
+  passes++;
+  if (busy) {
+    worst_busy_us = max(worst_busy_us, took);
+    busy_passes++;
+  }
+
+  // Track how long each scheduled job kept the worker
+  if (job_mode < 0 && fetch_running >= 0) {
+    job_mode  = fetch_running;
+    job_start = millis();
+  } else if (job_mode >= 0 && fetch_running != job_mode) {
+    if (millis() - job_start > longest_job_ms) {
+      longest_job_ms   = millis() - job_start;
+      longest_job_mode = job_mode;
+    }
+    job_mode = fetch_running;
+    job_start = millis();
+  }
+  return took;
+}
+
+static bool all_loaded() {
+  for (int m = NUM_CAMERAS; m < NUM_MODES; m++)
+    if (!mode_data[m].data) return false;
+  return goes_on_screen == wc_camera_idx;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_worst_pass_while_every_source_loads() {
+  const unsigned long t0 = millis();
+  while (!all_loaded() && millis() - t0 < 180000) timed_loop();
+  TEST_ASSERT_TRUE_MESSAGE(all_loaded(), "not every source loaded");
+
+  printf("boot to all sources loaded: %lu ms, %lu loop passes (%lu with a fetch in flight)\n",
+         millis() - t0, passes, busy_passes);
+  printf("longest fetch: mode %d, %lu ms (what loop() used to block for)\n", longest_job_mode, longest_job_ms);
+  printf("worst loop pass: %lu us overall, %lu us with a fetch in flight\n", worst_us, worst_busy_us);
+
+  // The fetches were slow enough to matter...
+  TEST_ASSERT_GREATER_THAN_UINT32(3000, longest_job_ms);
+  TEST_ASSERT_GREATER_THAN_UINT32(100, busy_passes);
+  // ...and loop() never waited on one: its worst pass is a panel update
+  TEST_ASSERT_LESS_THAN_UINT32(60 * 1000, worst_busy_us);
+}
+
+static void test_tap_during_a_slow_fetch_switches_at_once() {
+  // Forecast on screen, refreshed against a crawling server
+  noaa().pace[NOAA_NWS] = { 256, 1000 };
+  noaa().weather = "Thunderstorms";
+  while (wc_camera_idx != NWS_FORECAST_MODE) {
+    nativeTap(NATIVE_TAP_NEXT);
+    nativeRunFor(500);
+  }
+  schedAt(NWS_FORECAST_MODE, millis());
+  TEST_ASSERT_TRUE(nativeRunUntil([] { return fetch_running == NWS_FORECAST_MODE; }, 5000));
+  nativeRunFor(2000);
+  TEST_ASSERT_EQUAL_INT(NWS_FORECAST_MODE, fetch_running);   // still downloading
+
+  nativeTouch(3500, 2000);
+  const unsigned long took = timed_loop();
+  nativeRelease();
+  const unsigned long transfer_ms = noaaForecastJson().size() / 256 * 1000;
+  printf("tap to new mode on screen, 2 s into a %lu ms forecast transfer: %lu us\n", transfer_ms, took);
+  // The pass repaints the panel for the new mode and waits for nothing else
+  TEST_ASSERT_EQUAL_INT(NWS_ALERTS_MODE, wc_camera_idx);
+  TEST_ASSERT_LESS_THAN_UINT32(100 * 1000, took);
+  TEST_ASSERT_GREATER_THAN_UINT32(10000, transfer_ms);
+}
+
+int main(int argc, char **argv) {
+  const time_t now = 1782064800;   // 2026-06-21 18:00 UTC
+  nativeSetTime(now);
+  noaaServe(900, 150);
+  noaa().tle_epoch = now - 86400;
+  // A bad day: every body trickles in over seconds
+  noaa().pace[NOAA_NWS]       = { 512, 250 };
+  noaa().pace[NOAA_SWPC]      = { 512, 200 };
+  noaa().pace[NOAA_CELESTRAK] = { 64, 500 };
+  noaa().pace[NOAA_GOES]      = { 1460, 60 };
+  nativeBoot();
+  UNITY_BEGIN();
+  RUN_TEST(test_worst_pass_while_every_source_loads);
+  RUN_TEST(test_tap_during_a_slow_fetch_switches_at_once);
+  return UNITY_END();
+}
@@ -0,0 +1,124 @@
+// Reference lunar ephemeris for the moonrise tests: Meeus, Astronomical
+// Algorithms (2nd ed.) ch. 47, the truncated ELP-2000/82 series with the
+// full 60-term longitude/distance and latitude tables, plus the principal
+// nutation terms (ch. 22). Good to about 10" in longitude and 4" in
+// latitude, two orders better than the Schlyter series the firmware runs,
+// and independent of it. All double; host only.
+#pragma once
+
+#include <math.h>
+
+namespace meeus {
+
+static const double R = M_PI / 180.0;
+
+static double rev(double x) { return x - 360.0 * floor(x / 360.0); }
+
+// Table 47.A: D, M, M', F multipliers; sigma-l (1e-6 deg), sigma-r (1e-3 km)
+static const int LR[60][6] = {
+  { 0,  0,  1,  0, 6288774, -20905355 }, { 2,  0, -1,  0, 1274027, -3699111 },
+  { 2,  0,  0,  0,  658314,  -2955968 }, { 0,  0,  2,  0,  213618,  -569925 },
+  { 0,  1,  0,  0, -185116,     48888 }, { 0,  0,  0,  2, -114332,    -3149 },
+  { 2,  0, -2,  0,   58793,    246158 }, { 2, -1, -1,  0,   57066,  -152138 },
+  { 2,  0,  1,  0,   53322,   -170733 }, { 2, -1,  0,  0,   45758,  -204586 },
+  { 0,  1, -1,  0,  -40923,   -129620 }, { 1,  0,  0,  0,  -34720,   108743 },
+  { 0,  1,  1,  0,  -30383,    104755 }, { 2,  0,  0, -2,   15327,    10321 },
+  { 0,  0,  1,  2,  -12528,         0 }, { 0,  0,  1, -2,   10980,    79661 },
+  { 4,  0, -1,  0,   10675,    -34782 }, { 0,  0,  3,  0,   10034,   -23210 },
+  { 4,  0, -2,  0,    8548,    -21636 }, { 2,  1, -1,  0,   -7888,    24208 },
+  { 2,  1,  0,  0,   -6766,     30824 }, { 1,  0, -1,  0,   -5163,    -8379 },
+  { 1,  1,  0,  0,    4987,    -16675 }, { 2, -1,  1,  0,    4036,   -12831 },
+  { 2,  0,  2,  0,    3994,    -10445 }, { 4,  0,  0,  0,    3861,   -11650 },
+  { 2,  0, -3,  0,    3665,     14403 }, { 0,  1, -2,  0,   -2689,    -7003 },
+  { 2,  0, -1,  2,   -2602,         0 }, { 2, -1, -2,  0,    2390,    10056 },
+  { 1,  0,  1,  0,   -2348,      6322 }, { 2, -2,  0,  0,    2236,    -9884 },
+  { 0,  1,  2,  0,   -2120,      5751 }, { 0,  2,  0,  0,   -2069,        0 },
+  { 2, -2, -1,  0,    2048,     -4950 }, { 2,  0,  1, -2,   -1773,     4130 },
+  { 2,  0,  0,  2,   -1595,         0 }, { 4, -1, -1,  0,    1215,    -3958 },
+  { 0,  0,  2,  2,   -1110,         0 }, { 3,  0, -1,  0,    -892,     3258 },
+  { 2,  1,  1,  0,    -810,      2616 }, { 4, -1, -2,  0,     759,    -1897 },
+  { 0,  2, -1,  0,    -713,     -2117 }, { 2,  2, -1,  0,    -700,     2354 },
+  { 2,  1, -2,  0,     691,         0 }, { 2, -1,  0, -2,     596,        0 },
+  { 4,  0,  1,  0,     549,     -1423 }, { 0,  0,  4,  0,     537,    -1117 },
+  { 4, -1,  0,  0,     520,     -1571 }, { 1,  0, -2,  0,    -487,    -1739 },
+  { 2,  1,  0, -2,    -399,         0 }, { 0,  0,  2, -2,    -381,    -4421 },
+  { 1,  1,  1,  0,     351,         0 }, { 3,  0, -2,  0,    -340,        0 },
+  { 4,  0, -3,  0,     330,         0 }, { 2, -1,  2,  0,     327,        0 },
+  { 0,  2,  1,  0,    -323,      1165 }, { 1,  1, -1,  0,     299,        0 },
+  { 2,  0,  3,  0,     294,         0 }, { 2,  0, -1, -2,       0,     8752 },
+};
+
+// Table 47.B: D, M, M', F multipliers; sigma-b (1e-6 deg)
+static const int B[60][5] = {
+  { 0,  0,  0,  1, 5128122 }, { 0,  0,  1,  1, 280602 }, { 0,  0,  1, -1, 277693 },
+  { 2,  0,  0, -1,  173237 }, { 2,  0, -1,  1,  55413 }, { 2,  0, -1, -1,  46271 },
+  { 2,  0,  0,  1,   32573 }, { 0,  0,  2,  1,  17198 }, { 2,  0,  1, -1,   9266 },
+  { 0,  0,  2, -1,    8822 }, { 2, -1,  0, -1,   8216 }, { 2,  0, -2, -1,   4324 },
+  { 2,  0,  1,  1,    4200 }, { 2,  1,  0, -1,  -3359 }, { 2, -1, -1,  1,   2463 },
+  { 2, -1,  0,  1,    2211 }, { 2, -1, -1, -1,   2065 }, { 0,  1, -1, -1,  -1870 },
+  { 4,  0, -1, -1,    1828 }, { 0,  1,  0,  1,  -1794 }, { 0,  0,  0,  3,  -1749 },
+  { 0,  1, -1,  1,   -1565 }, { 1,  0,  0,  1,  -1491 }, { 0,  1,  1,  1,  -1475 },
+  { 0,  1,  1, -1,   -1410 }, { 0,  1,  0, -1,  -1344 }, { 1,  0,  0, -1,  -1335 },
+  { 0,  0,  3,  1,    1107 }, { 4,  0,  0, -1,   1021 }, { 4,  0, -1,  1,    833 },
+  { 0,  0,  1, -3,     777 }, { 4,  0, -2,  1,    671 }, { 2,  0,  0, -3,    607 },
+  { 2,  0,  2, -1,     596 }, { 2, -1,  1, -1,    491 }, { 2,  0, -2,  1,   -451 },
+  { 0,  0,  3, -1,     439 }, { 2,  0,  2,  1,    422 }, { 2,  0, -3, -1,    421 },
+  { 2,  1, -1,  1,    -366 }, { 2,  1,  0,  1,   -351 }, { 4,  0,  0,  1,    331 },
+  { 2, -1,  1,  1,     315 }, { 2, -2,  0, -1,    302 }, { 0,  0,  1,  3,   -283 },
+  { 2,  1,  1, -1,    -229 }, { 1,  1,  0, -1,    223 }, { 1,  1,  0,  1,    223 },
+  { 0,  1, -2, -1,    -220 }, { 2,  1, -1, -1,   -220 }, { 1,  0,  1,  1,   -185 },
+  { 2, -1, -2, -1,     181 }, { 0,  1,  2,  1,   -177 }, { 4,  0, -2, -1,    176 },
+  { 4, -1, -1, -1,     166 }, { 1,  0,  1, -1,   -164 }, { 4,  0,  1, -1,    132 },
+  { 1,  0, -1, -1,    -119 }, { 4, -1,  0, -1,    115 }, { 2, -2,  0,  1,    107 },
+};
+
+// Apparent geocentric right ascension / declination (degrees) and distance
+// (km) at Julian Ephemeris Day jde
+static void moon(double jde, double &ra, double &dec, double &dist, double *sums = nullptr) {
+  const double T = (jde - 2451545.0) / 36525.0;
+  const double Lp = rev(218.3164477 + 481267.88123421 * T - 0.0015786 * T * T + T * T * T / 538841.0 - T * T * T * T / 65194000.0);
+  const double D  = rev(297.8501921 + 445267.1114034 * T - 0.0018819 * T * T + T * T * T / 545868.0 - T * T * T * T / 113065000.0);
+  const double M  = rev(357.5291092 + 35999.0502909 * T - 0.0001536 * T * T + T * T * T / 24490000.0);
+  const double Mp = rev(134.9633964 + 477198.8675055 * T + 0.0087414 * T * T + T * T * T / 69699.0 - T * T * T * T / 14712000.0);
+  const double F  = rev(93.2720950 + 483202.0175233 * T - 0.0036539 * T * T - T * T * T / 3526000.0 + T * T * T * T / 863310000.0);
+  const double A1 = rev(119.75 + 131.849 * T), A2 = rev(53.09 + 479264.290 * T), A3 = rev(313.45 + 481266.484 * T);
+  const double E  = 1.0 - 0.002516 * T - 0.0000074 * T * T;
+
+  double sl = 0, sr = 0, sb = 0;
+  for (const auto &t : LR) {
+    const double arg = (t[0] * D + t[1] * M + t[2] * Mp + t[3] * F) * R;
+    const double e   = t[1] ? pow(E, abs(t[1])) : 1.0;
+    sl += t[4] * e * sin(arg);
+    sr += t[5] * e * cos(arg);
+  }
+  for (const auto &t : B) {
+    const double e = t[1] ? pow(E, abs(t[1])) : 1.0;
+    sb += t[4] * e * sin((t[0] * D + t[1] * M + t[2] * Mp + t[3] * F) * R);
+  }
+  sl += 3958 * sin(A1 * R) + 1962 * sin((Lp - F) * R) + 318 * sin(A2 * R);
+  sb += -2235 * sin(Lp * R) + 382 * sin(A3 * R) + 175 * sin((A1 - F) * R) + 175 * sin((A1 + F) * R) +
+        127 * sin((Lp - Mp) * R) - 115 * sin((Lp + Mp) * R);
+  if (sums) { sums[0] = sl; sums[1] = sb; sums[2] = sr; }
+
+  // Principal nutation terms (ch. 22, good to 0.5")
+  const double Om = rev(125.04452 - 1934.136261 * T), Ls = rev(280.4665 + 36000.7698 * T);
+  const double dpsi = (-17.20 * sin(Om * R) - 1.32 * sin(2 * Ls * R) - 0.23 * sin(2 * Lp * R) + 0.21 * sin(2 * Om * R)) / 3600.0;
+  const double deps = (9.20 * cos(Om * R) + 0.57 * cos(2 * Ls * R) + 0.10 * cos(2 * Lp * R) - 0.09 * cos(2 * Om * R)) / 3600.0;
+  const double eps  = 23.4392911 - 0.0130042 * T + deps;
+
+  const double lam = (Lp + sl / 1e6 + dpsi) * R, bet = sb / 1e6 * R;
+  dist = 385000.56 + sr / 1000.0;
+  ra   = rev(atan2(sin(lam) * cos(eps * R) - tan(bet) * sin(eps * R), cos(lam)) / R);
+  dec  = asin(sin(bet) * cos(eps * R) + cos(bet) * sin(eps * R) * sin(lam)) / R;
+}
+
+// Apparent sidereal time at Greenwich (degrees) at Julian Day jd (UT)
+static double gast(double jd) {
+  const double T  = (jd - 2451545.0) / 36525.0;
+  const double Om = rev(125.04452 - 1934.136261 * T), Ls = rev(280.4665 + 36000.7698 * T);
+  const double dpsi = (-17.20 * sin(Om * R) - 1.32 * sin(2 * Ls * R)) / 3600.0;
+  return rev(280.46061837 + 360.98564736629 * (jd - 2451545.0) + 0.000387933 * T * T - T * T * T / 38710000.0 +
+             dpsi * cos(23.4393 * R));
+}
+
+}  // namespace meeus
@@ -0,0 +1,156 @@
+// Moonrise / moonset from sm_moon_riseset() against an independent
+// reference: the Meeus ch. 47 lunar series (meeus_moon.h, ~10"), with the
+// same almanac definition of the event (upper limb on the horizon with
+// standard refraction, h0 = 0.7275*parallax - 0.5667 deg) found to the
+// second by a fine scan. Five sites from the equator to the Arctic over 336
+// days of 2024: every event the reference has must be found and none
+// invented, times within a minute (more in the Arctic), and the cost as
+// sm_moon_alt evaluations per call (the old half-hour scan made 49).
+//
+// The Arctic site covers the awkward days: the moon staying up or down all
+// day, and grazing passes that rise and set again within a few hours.
+#include <unity.h>
+
+#include <vector>
+
+#include "SunMoon.h"
+#include "meeus_moon.h"
+
+Arduino_GFX *gfx = nullptr;
+
+#define DAYS     336
+#define DELTA_T  69.2            // TT - UT in 2024, seconds
+#define JD_2024  2460310.5       // 2024-01-01 00:00 UTC
+
+// worst = allowed error in minutes. In the Arctic the moon can cross the
+// horizon at a few degrees an hour, so the Schlyter series' ~2' turns into
+// minutes there.
+struct Site { const char *name; double lat, lon, worst; };
+static const Site SITES[] = {
+  { "Singapore",  1.3521,  103.8198,  1.0 },
+  { "Sydney",   -33.8688,  151.2093,  1.0 },
+  { "Boulder",   40.0150, -105.2705,  1.0 },
+  { "London",    51.5074,   -0.1278,  1.0 },
+  { "Tromso",    69.6492,   18.9553, 15.0 },
+};
+
+// Reference: the moon's upper limb above the refracted horizon (degrees)
+static double ref_horizon(double jd, double lat, double lon) {
+  double ra, dec, dist;
+  meeus::moon(jd + DELTA_T / 86400.0, ra, dec, dist);
+  const double R = meeus::R, par = asin(6378.14 / dist) / R;
+  const double H = (meeus::gast(jd) + lon - ra) * R;
+  const double alt = asin(sin(lat * R) * sin(dec * R) + cos(lat * R) * cos(dec * R) * cos(H)) / R;
+  return alt - (0.7275 * par - 0.5667);
+}
+
+struct Day { double rise, set; double up_min; };   // minutes after UTC midnight, -1 = none
+
+// First rise and first set in the UTC day, to the second; up_min = how long
+// the moon is above the horizon that day
+static Day ref_day(double jd0, double lat, double lon) {
+  Day d = { -1, -1, 0 };
+  const double step = 2.0 / 1440.0;
+  double a = jd0, fa = ref_horizon(a, lat, lon);
+  for (int i = 1; i <= 720; i++) {
+    double b = jd0 + i * step, fb = ref_horizon(b, lat, lon);
+    if (fb > 0) d.up_min += 2;
+    if ((fa < 0) != (fb < 0)) {
+      double lo = a, hi = b, flo = fa;
+      while (hi - lo > 0.5 / 86400.0) {
+        double m = 0.5 * (lo + hi), fm = ref_horizon(m, lat, lon);
+        if ((fm < 0) == (flo < 0)) { lo = m; flo = fm; } else hi = m;
+      }
+      double t = (0.5 * (lo + hi) - jd0) * 1440.0;
+      if (fa < 0 && d.rise < 0) d.rise = t;
+      if (fa >= 0 && d.set < 0) d.set = t;
+    }
+    a = b;
+    fa = fb;
+  }
+  return d;
+}
+
+static void civil(double jd, int &y, int &m, int &d) {
+  time_t t = (time_t)((jd - 2440587.5) * 86400.0);
+  struct tm tm;
+  gmtime_r(&t, &tm);
+  y = tm.tm_year + 1900;
+  m = tm.tm_mon + 1;
+  d = tm.tm_mday;
+}
+
+struct Stats {
+  int    events = 0, missed = 0, invented = 0, none_days = 0, grazing = 0;
+  double worst = 0, sum = 0;
+  uint32_t evals = 0, evals_max = 0;
+};
+
+static Stats stats[5];
+
+static void compare(double want, double got, Stats &s, const char *what, const Site &site, int y, int m, int d) {
+  if (want < 0 && got < 0) return;
+  if (want < 0 || got < 0) {
+    // Only an event within a minute of midnight may land on the other side
+    const double t = want < 0 ? got : want;
+    if (t > 1.0 && t < 1439.0) {
+      (want < 0 ? s.invented : s.missed)++;
+      printf("  %s %04d-%02d-%02d %s: reference %.2f, firmware %.2f\n", site.name, y, m, d, what, want, got);
+    }
+    return;
+  }
+  const double err = fabs(want - got);
+  s.events++;
+  s.sum += err;
+  if (err > s.worst) s.worst = err;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_five_sites_a_year() {
+  printf("site        events  worst err  mean err  no-event days  grazing  evals/call (max)\n");
+  for (int k = 0; k < 5; k++) {
+    const Site &site = SITES[k];
+    Stats &s = stats[k];
+    for (int i = 0; i < DAYS; i++) {
+      int y, m, d;
+      civil(JD_2024 + i, y, m, d);
+      const Day want = ref_day(JD_2024 + i, site.lat, site.lon);
+      double rise, set;
+      sm_moon_evals = 0;
+      sm_moon_riseset(y, m, d, site.lat, site.lon, rise, set);
+      s.evals += sm_moon_evals;
+      if (sm_moon_evals > s.evals_max) s.evals_max = sm_moon_evals;
+
+      compare(want.rise, rise, s, "rise", site, y, m, d);
+      compare(want.set, set, s, "set", site, y, m, d);
+      if (want.rise < 0 || want.set < 0) s.none_days++;
+      if (want.rise >= 0 && want.set >= 0 && want.up_min < 240 && want.up_min > 0 && want.set > want.rise) s.grazing++;
+    }
+    printf("%-10s %7d %8.2f m %8.2f m %14d %8d %8.1f (%u)\n", site.name, s.events, s.worst,
+           s.sum / s.events, s.none_days, s.grazing, (double)s.evals / DAYS, (unsigned)s.evals_max);
+  }
+  for (int k = 0; k < 5; k++) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, stats[k].missed, SITES[k].name);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, stats[k].invented, SITES[k].name);
+    TEST_ASSERT_TRUE_MESSAGE(stats[k].worst < SITES[k].worst, SITES[k].name);
+    TEST_ASSERT_TRUE_MESSAGE(stats[k].sum / stats[k].events < 0.5, SITES[k].name);
+    TEST_ASSERT_TRUE_MESSAGE(stats[k].evals < 20u * DAYS, SITES[k].name);
+  }
+}
+
+static void test_the_hard_days_were_exercised() {
+  // Every site has its monthly day without a rise or a set; the Arctic has
+  // days with neither, and grazing passes
+  for (int k = 0; k < 5; k++) TEST_ASSERT_GREATER_OR_EQUAL_INT(DAYS / 30, stats[k].none_days);
+  TEST_ASSERT_GREATER_THAN_INT(4 * DAYS / 30, stats[4].none_days);
+  TEST_ASSERT_GREATER_THAN_INT(0, stats[4].grazing);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_five_sites_a_year);
+  RUN_TEST(test_the_hard_days_were_exercised);
+  return UNITY_END();
+}
@@ -0,0 +1,83 @@
+// Moon phase widget on the framebuffer stand-in, which counts what the
+// ILI9341 would see: address windows, pixels and the SPI time they cost at
+// 40 MHz. sm_draw_moon() against the rasterizer it replaced (kept here as
+// legacy_draw_moon: a sqrt per row, two drawFastHLine calls per row and the
+// library's drawCircle) at the screen's R = 38 through a whole lunation.
+// The picture must be pixel for pixel the same; the bus traffic should
+// collapse to one window.
+#include <unity.h>
+
+#include "SunMoon.h"
+
+Arduino_GFX *gfx = new Arduino_ILI9341(new Arduino_HWSPI(2, 15), GFX_NOT_DEFINED, 1);
+
+#define CX 160
+#define CY 130
+#define R  38
+
+static void legacy_draw_moon(int cx, int cy, int r, double age) {
+  float p = (float)(age / 29.53058853), c2p = std::cos(float(2.0 * M_PI) * p);
+  bool waxing = p < 0.5f;
+  for (int dy = -r; dy <= r; dy++) {
+    int rx2 = r * r - dy * dy;
+    float rxf = std::sqrt((float)rx2);
+    int rx = (int)rxf;
+    if (rx == 0) continue;
+    gfx->drawFastHLine(cx - rx, cy + dy, 2 * rx + 1, SM_MOON_DARK);
+    float term = c2p * rxf;
+    int lit_x0, lit_w;
+    if (waxing) {
+      int x0 = (int)std::floor(term) + 1;
+      if (x0 > rx) continue;
+      lit_x0 = cx + x0;
+      lit_w  = rx - x0 + 1;
+    } else {
+      int x1 = (int)std::floor(-term - 1e-6f);
+      if (x1 < -rx) continue;
+      lit_x0 = cx - rx;
+      lit_w  = x1 + rx + 1;
+    }
+    if (lit_w > 0) gfx->drawFastHLine(lit_x0, cy + dy, lit_w, RGB565_WHITE);
+  }
+  gfx->drawCircle(cx, cy, r, RGB565_WHITE);
+}
+
+struct Cost { uint32_t windows; uint64_t px; unsigned long us; uint32_t sum; };
+
+template <class Draw> static Cost draw(Draw fn) {
+  gfx->fillScreen(RGB565_BLACK);
+  gfx_native_stats = {};
+  const unsigned long t0 = micros();
+  fn();
+  return { gfx_native_stats.windows, gfx_native_stats.px, micros() - t0,
+           gfx->checksum(CX - R, CY - R, 2 * R + 1, 2 * R + 1) };
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_same_pixels_one_window() {
+  Cost worst_old = {}, worst_new = {};
+  for (double age = 0.0; age < 29.53; age += 0.25) {
+    const Cost old_ = draw([=] { legacy_draw_moon(CX, CY, R, age); });
+    const Cost new_ = draw([=] { sm_draw_moon(CX, CY, R, age); });
+    char msg[32];
+    snprintf(msg, sizeof(msg), "age %.2f", age);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(old_.sum, new_.sum, msg);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(1, new_.windows, msg);
+    if (old_.us > worst_old.us) worst_old = old_;
+    if (new_.us > worst_new.us) worst_new = new_;
+  }
+  printf("moon widget, R=%d, worst phase: before %u windows / %llu px / %lu us of bus, "
+         "after %u window / %llu px / %lu us\n", R, (unsigned)worst_old.windows,
+         (unsigned long long)worst_old.px, worst_old.us, (unsigned)worst_new.windows,
+         (unsigned long long)worst_new.px, worst_new.us);
+  TEST_ASSERT_LESS_THAN_UINT32(worst_old.us, worst_new.us);
+}
+
+int main(int argc, char **argv) {
+  gfx->begin();
+  UNITY_BEGIN();
+  RUN_TEST(test_same_pixels_one_window);
+  return UNITY_END();
+}
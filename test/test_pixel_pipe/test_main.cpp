@@ -0,0 +1,122 @@
+// GOES decode through the double-buffered pixel pipeline (PixelPipe.h), on
+// the firmware with the JPEGDEC and panel stand-ins: decoding an MCU and
+// shifting a pixel out both cost clock time, and the push task and the
+// decoder each run while the other waits. Every strip the push task takes is
+// copied before it goes out and compared after: if the decoder wrote into a
+// half still being pushed, the strip is torn. With JPEG_USES_DMA no strip of
+// any camera may be torn and the panel must end up exactly as an inline
+// push leaves it; the same pipeline on a single buffer must tear, or the
+// check proves nothing. Then decode+display time per CAMERAS entry, inline
+// against pipelined.
+#include <unity.h>
+
+#include "Firmware.h"
+#include "NoaaStandIn.h"
+
+static const char *path_of(int cam) { return CAMERAS[cam].url + strlen("https://" NOAA_GOES); }
+
+static uint32_t image_area() { return gfx->checksum(0, SCR_TOP, gfx->width(), gfx->height() - SCR_TOP); }
+
+static HttpsJpeg frame_of(int cam) {
+  const std::string &f = noaaGoesFrame(path_of(cam), 1);
+  HttpsJpeg img = {};
+  img.buf = (uint8_t *)f.data();
+  img.len = (int32_t)f.size();
+  return img;
+}
+
+// Push handler wrapped with the race check
+static uint32_t strips = 0, torn = 0;
+static bool checked_push(const PipeStrip &s) {
+  static uint16_t copy[MAX_BUFFERED_PIXELS];
+  const size_t n = (size_t)s.w * s.h;
+  memcpy(copy, s.pixels, n * sizeof(uint16_t));
+  const bool ok = goesPushStrip(s);
+  strips++;
+  torn += memcmp(copy, s.pixels, n * sizeof(uint16_t)) != 0;
+  return ok;
+}
+
+// JPEGDraw as it was before the pipeline: push the strip, then decode on
+static int inline_draw(JPEGDRAW *p) {
+  if (!goes_anchored) {
+    goes_dx = goes_org_x - p->x;
+    goes_dy = goes_org_y - p->y;
+    goes_anchored = true;
+  }
+  gfx->draw16bitBeRGBBitmap(p->x + goes_dx, p->y + goes_dy, p->pPixels, p->iWidth, p->iHeight);
+  return 1;
+}
+
+// Decode cam onto a cleared image area the way goesDecodeOpened() lays it
+// out; virtual microseconds from the first MCU to the last pixel
+static unsigned long decode(int cam, JPEG_DRAW_CALLBACK *draw, int dma) {
+  gfx->fillRect(0, SCR_TOP, gfx->width(), gfx->height() - SCR_TOP, RGB565_BLACK);
+  HttpsJpeg img = frame_of(cam);
+  TEST_ASSERT_TRUE(jpeg.openRAM(img.buf, img.len, draw));
+  const unsigned long t0 = micros();
+  pipeStart();
+  jpeg.setPixelType(RGB565_BIG_ENDIAN);
+  int x, y, w, h;
+  const int scale = goesLayout(x, y, w, h);
+  goesCropToScreen(x, y, scale);
+  TEST_ASSERT_TRUE(jpeg.decode(x, y, scale | dma));
+  TEST_ASSERT_TRUE(pipeFlush());
+  const unsigned long us = micros() - t0;
+  jpeg.close();
+  return us;
+}
+
+void setUp() {
+  strips = torn = 0;
+  pipe_handler = checked_push;
+}
+
+void tearDown() { pipe_handler = goesPushStrip; }
+
+static void test_no_strip_is_torn() {
+  for (int cam = 0; cam < NUM_CAMERAS; cam++) {
+    decode(cam, inline_draw, 0);
+    const uint32_t want = image_area();
+
+    // The firmware's own path: goesDecodeCached -> goesDecodeOpened -> JPEGDraw
+    FetchJob job = {};
+    job.mode = cam;
+    job.gen  = fetch_gen;
+    HttpsJpeg img = frame_of(cam);
+    strips = torn = 0;
+    TEST_ASSERT_EQUAL_INT(FETCH_DRAWN, goesDecodeCached(job, &img));
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, torn, CAMERAS[cam].name);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(jpeg_native_stats.draws, strips, CAMERAS[cam].name);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(want, image_area(), CAMERAS[cam].name);
+  }
+}
+
+static void test_one_buffer_tears() {
+  // Same handoff, but JPEGDEC decodes every strip into the same buffer
+  decode(0, JPEGDraw, 0);
+  printf("single buffer: %u of %u strips torn\n", (unsigned)torn, (unsigned)strips);
+  TEST_ASSERT_GREATER_THAN_UINT32(0, torn);
+}
+
+static void test_decode_display_time_per_camera() {
+  printf("camera                       inline   pipelined  decoder waited\n");
+  for (int cam = 0; cam < NUM_CAMERAS; cam++) {
+    const unsigned long alone = decode(cam, inline_draw, 0);
+    const unsigned long piped = decode(cam, JPEGDraw, JPEG_USES_DMA);
+    printf("%-26.26s %6.1f ms %8.1f ms %10.1f ms\n", CAMERAS[cam].name, alone / 1000.0,
+           piped / 1000.0, pipe_stall_us / 1000.0);
+    TEST_ASSERT_EQUAL_UINT32(0, torn);
+    // Decode and push overlap: at least a quarter off, never slower
+    TEST_ASSERT_LESS_THAN_UINT32(alone * 3 / 4, piped);
+  }
+}
+
+int main(int argc, char **argv) {
+  nativeBoot();   // gfx up and the push task started; loop() is never run
+  UNITY_BEGIN();
+  RUN_TEST(test_no_strip_is_torn);
+  RUN_TEST(test_one_buffer_tears);
+  RUN_TEST(test_decode_display_time_per_camera);
+  return UNITY_END();
+}
@@ -0,0 +1,108 @@
+// NWS /points cache, counted at the stand-in: the first run for a location
+// resolves it once and persists the grid in NVS; after a restart the
+// forecast goes straight to the gridpoint URL for every refresh; a 404 from
+// that URL (office re-gridded) costs exactly one re-resolve, as does moving.
+//
+// setup() runs once per binary, so the "previous boot" is a direct
+// nwsFetchForecast() call before it, followed by dropping what a restart
+// loses (the RAM copy of the point and every pooled session).
+#include <unity.h>
+
+#include "Firmware.h"
+#include "NoaaStandIn.h"
+
+static int requests(const std::string &prefix) {
+  int n = 0;
+  for (const auto &r : standIn().log) n += (r.path.compare(0, prefix.size(), prefix) == 0);
+  return n;
+}
+static int points()    { return requests("/points/"); }
+static int forecasts() { return requests("/gridpoints/"); }
+
+// Have the worker refresh the forecast now and wait for it to land
+static void refresh_forecast() {
+  const unsigned long before = mode_data[NWS_FORECAST_MODE].fetched_ms;
+  schedAt(NWS_FORECAST_MODE, millis());
+  TEST_ASSERT_TRUE(nativeRunUntil([=] { return mode_data[NWS_FORECAST_MODE].fetched_ms != before; }, 30000));
+}
+
+static NwsPoint stored_point() {
+  NwsPoint p = {};
+  Preferences prefs;
+  prefs.begin("nwspoint", true);
+  prefs.getBytes("point", &p, sizeof(p));
+  prefs.end();
+  return p;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_first_run_resolves_once_and_persists() {
+  NwsForecastData *d = nwsFetchForecast("39.7392", "-104.9903");
+  TEST_ASSERT_NOT_NULL(d);
+  delete d;
+  TEST_ASSERT_EQUAL_INT(1, points());
+  TEST_ASSERT_EQUAL_INT(1, forecasts());
+  const NwsPoint p = stored_point();
+  TEST_ASSERT_EQUAL_STRING("39.7392,-104.9903", p.key);
+  TEST_ASSERT_EQUAL_STRING("BOU", p.office);
+  TEST_ASSERT_EQUAL_INT(63, p.gridX);
+  TEST_ASSERT_EQUAL_INT(62, p.gridY);
+}
+
+static void test_warm_boot_makes_no_points_requests() {
+  // Restart: RAM is gone, NVS is not
+  nws_point_valid = false;
+  memset(&nws_point, 0, sizeof(nws_point));
+  pool_close_all();
+  standIn().log.clear();
+
+  nativeBoot();
+  TEST_ASSERT_TRUE(nativeRunUntil([] { return mode_data[NWS_FORECAST_MODE].data != nullptr; }, 60000));
+  for (int i = 0; i < 3; i++) refresh_forecast();
+  printf("warm boot + 3 refreshes: %d /points, %d forecast requests\n", points(), forecasts());
+  TEST_ASSERT_EQUAL_INT(0, points());
+  TEST_ASSERT_EQUAL_INT(4, forecasts());
+}
+
+static void test_404_re_resolves_exactly_once() {
+  // NWS re-grids the office: the cached forecast URL now 404s
+  noaa().grid_x = 64;
+  standIn().log.clear();
+  refresh_forecast();
+  TEST_ASSERT_NOT_NULL(mode_data[NWS_FORECAST_MODE].data);
+  TEST_ASSERT_EQUAL_INT(1, points());
+  TEST_ASSERT_EQUAL_INT(2, forecasts());   // the 404 and the retry
+  TEST_ASSERT_EQUAL_INT(64, stored_point().gridX);
+
+  // And from then on the new grid comes from the cache
+  refresh_forecast();
+  TEST_ASSERT_EQUAL_INT(1, points());
+  TEST_ASSERT_EQUAL_INT(3, forecasts());
+}
+
+static void test_location_change_re_resolves_once() {
+  strcpy(wc_lat, "40.0150");   // as the portal writes it
+  strcpy(wc_lon, "-105.2705");
+  standIn().log.clear();
+  refresh_forecast();
+  refresh_forecast();
+  TEST_ASSERT_EQUAL_INT(1, points());
+  TEST_ASSERT_EQUAL_INT(2, forecasts());
+  const NwsPoint p = stored_point();
+  TEST_ASSERT_EQUAL_STRING("40.0150,-105.2705", p.key);
+}
+
+int main(int argc, char **argv) {
+  const time_t now = 1782064800;   // 2026-06-21 18:00 UTC
+  nativeSetTime(now);
+  noaaServe(300, 60);
+  noaa().tle_epoch = now - 86400;
+  UNITY_BEGIN();
+  RUN_TEST(test_first_run_resolves_once_and_persists);
+  RUN_TEST(test_warm_boot_makes_no_points_requests);
+  RUN_TEST(test_404_re_resolves_exactly_once);
+  RUN_TEST(test_location_change_re_resolves_once);
+  return UNITY_END();
+}
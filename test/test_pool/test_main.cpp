@@ -0,0 +1,227 @@
+// Keep-alive pool against the stand-in server: one TLS handshake per host per
+// refresh cycle, however many requests the cycle makes to that host, and a
+// GET on a warm session re-sent only if the server dropped it, never if it
+// went quiet. Then pool_pipeline(): what pipelining saves against a server
+// with real latency, which failures it retries (the same rule), and 3xx
+// answers re-issued through pool_get() so they are followed.
+#include <unity.h>
+
+#include "HTTPPool.h"
+
+#define NWS  "api.weather.gov"
+#define SWPC "services.swpc.noaa.gov"
+#define GOES "cdn.star.nesdis.noaa.gov"
+
+static StandInReply echo_path(const StandInRequest &r) {
+  if (r.path == "/moved") return StandInReply().send(standInResponse(302, "", "Location: /here\r\n"));
+  if (r.path.compare(0, 6, "/quiet") == 0)
+    return StandInReply().send(standInOk("{}").segs[0].bytes, POOL_TIMEOUT_MS + 5000);
+  return standInOk("{\"path\":\"" + r.path + "\"}");
+}
+
+void setUp() {
+  pool_close_all();
+  standInReset();
+  standInHost(NWS, echo_path).handshake_ms  = 900;
+  standInHost(SWPC, echo_path).handshake_ms = 900;
+  standInHost(GOES, echo_path).handshake_ms = 900;
+  pool_handshakes = pool_requests = 0;
+}
+
+void tearDown() {}
+
+// What one refresh of the NWS and SWPC modes asks for
+static void run_cycle() {
+  static const char *const urls[] = {
+    "https://" NWS "/points/39.74,-104.99",
+    "https://" NWS "/gridpoints/BOU/63,62/forecast",
+    "https://" NWS "/alerts/active?point=39.74,-104.99",
+    "https://" SWPC "/products/noaa-planetary-k-index.json",
+    "https://" SWPC "/products/solar-wind/plasma-5-minute.json",
+    "https://" SWPC "/products/solar-wind/mag-5-minute.json",
+  };
+  for (const char *url : urls) {
+    String body = pool_get_string(url, nullptr, "test");
+    TEST_ASSERT_TRUE_MESSAGE(body.indexOf(strchr(url + 8, '/')) > 0, url);
+  }
+}
+
+static void test_one_handshake_per_host_per_cycle() {
+  run_cycle();
+  TEST_ASSERT_EQUAL_UINT32(6, pool_requests);
+  TEST_ASSERT_EQUAL_UINT32(2, pool_handshakes);
+  TEST_ASSERT_EQUAL_UINT32(1, standInHandshakes(NWS));
+  TEST_ASSERT_EQUAL_UINT32(1, standInHandshakes(SWPC));
+}
+
+static void test_back_to_back_cycles_stay_warm() {
+  run_cycle();
+  delay(5000);
+  pool_tick();
+  run_cycle();
+  TEST_ASSERT_EQUAL_UINT32(12, pool_requests);
+  TEST_ASSERT_EQUAL_UINT32(2, pool_handshakes);
+}
+
+static void test_idle_sessions_close_between_cycles() {
+  run_cycle();
+  delay(POOL_IDLE_MS + 1000);
+  pool_tick();  // releases the ~40 KB of TLS buffers per idle session
+  TEST_ASSERT_FALSE(pool_slots[0].client.connected());
+  TEST_ASSERT_FALSE(pool_slots[1].client.connected());
+  run_cycle();
+  TEST_ASSERT_EQUAL_UINT32(12, pool_requests);
+  TEST_ASSERT_EQUAL_UINT32(4, pool_handshakes);  // still one per host per cycle
+}
+
+static void test_third_host_evicts_least_recently_used() {
+  run_cycle();
+  String img = pool_get_string("https://" GOES "/GOES19/ABI/CONUS/GEOCOLOR/416x250.jpg", nullptr, "test");
+  TEST_ASSERT_TRUE(img.length() > 0);
+  TEST_ASSERT_EQUAL_UINT32(3, pool_handshakes);
+  // SWPC was used last, so NWS lost its slot and SWPC kept its session
+  String kp = pool_get_string("https://" SWPC "/products/noaa-planetary-k-index.json", nullptr, "test");
+  TEST_ASSERT_TRUE(kp.length() > 0);
+  TEST_ASSERT_EQUAL_UINT32(3, pool_handshakes);
+  TEST_ASSERT_EQUAL_UINT32(1, standInHandshakes(SWPC));
+}
+
+static void test_stale_session_reconnects_once() {
+  run_cycle();
+  standInDropIdle(NWS);  // server timed the keep-alive session out
+  String body = pool_get_string("https://" NWS "/alerts/active?point=39.74,-104.99", nullptr, "test");
+  TEST_ASSERT_TRUE(body.indexOf("/alerts/active") > 0);
+  TEST_ASSERT_EQUAL_UINT32(3, pool_handshakes);
+  TEST_ASSERT_EQUAL_UINT32(2, standInHandshakes(NWS));
+  TEST_ASSERT_EQUAL_UINT32(7, pool_requests);
+}
+
+static void test_quiet_server_is_not_asked_again() {
+  run_cycle();   // warm session, so a stale-session retry would be allowed
+  const uint32_t before = standInRequests(SWPC);
+  const unsigned long t0 = millis();
+  PoolConn *c;
+  TEST_ASSERT_EQUAL_INT(HTTPC_ERROR_READ_TIMEOUT, pool_get("https://" SWPC "/quiet/1", nullptr, &c));
+  const unsigned long took = millis() - t0;
+  TEST_ASSERT_NULL(c);
+  printf("GET to a server that went quiet: gave up after %lu ms, %u request(s)\n",
+         took, (unsigned)(standInRequests(SWPC) - before));
+  TEST_ASSERT_EQUAL_UINT32(before + 1, standInRequests(SWPC));   // asked once
+  TEST_ASSERT_EQUAL_UINT32(1, standInHandshakes(SWPC));
+  TEST_ASSERT_LESS_THAN_UINT32(POOL_TIMEOUT_MS + 1000, took);    // one timeout, not two
+}
+
+// ── pool_pipeline ───────────────────────────────────────────────────────────
+
+#define RTT_MS 250
+
+static const char *const feeds[] = {
+  "/products/noaa-planetary-k-index.json",
+  "/products/solar-wind/plasma-5-minute.json",
+  "/products/solar-wind/mag-5-minute.json",
+};
+
+struct Piped {
+  int         n = 0;
+  int         code[POOL_PIPE_MAX];
+  std::string body[POOL_PIPE_MAX];
+};
+
+static void piped_sink(void *ctx, int i, int code, PoolBody *b) {
+  Piped *p = (Piped *)ctx;
+  p->n++;
+  p->code[i] = code;
+  p->body[i].clear();
+  char buf[128];
+  int32_t r;
+  while (b && (r = pool_body_read(b, (uint8_t *)buf, sizeof(buf))) > 0) p->body[i].append(buf, r);
+}
+
+static unsigned long timed(void (*fn)()) {
+  const unsigned long t0 = millis();
+  fn();
+  return millis() - t0;
+}
+
+static void get_feeds(bool fresh_session) {
+  for (const char *path : feeds) {
+    if (fresh_session) pool_close_all();
+    String body = pool_get_string(String("https://" SWPC) + path, nullptr, "test");
+    TEST_ASSERT_TRUE(body.indexOf(path) > 0);
+  }
+}
+
+static void pipeline_feeds() {
+  Piped p;
+  TEST_ASSERT_EQUAL_INT(3, pool_pipeline(SWPC, feeds, 3, nullptr, piped_sink, &p));
+  TEST_ASSERT_EQUAL_INT(3, p.n);
+  for (int i = 0; i < 3; i++) TEST_ASSERT_TRUE(p.body[i].find(feeds[i]) != std::string::npos);
+}
+
+static void test_pipeline_latency() {
+  standInFind(SWPC)->rtt_ms = RTT_MS;
+  const unsigned long separate = timed([] { get_feeds(true); });
+  pool_close_all();
+  const unsigned long cold_seq = timed([] { get_feeds(false); });
+  const unsigned long warm_seq = timed([] { get_feeds(false); });
+  pool_close_all();
+  const unsigned long cold_pipe = timed(pipeline_feeds);
+  const unsigned long warm_pipe = timed(pipeline_feeds);
+  printf("3 feeds, %u ms handshake, %u ms RTT: separate connections %lu ms, "
+         "keep-alive %lu ms cold / %lu ms warm, pipelined %lu ms cold / %lu ms warm\n",
+         900u, RTT_MS, separate, cold_seq, warm_seq, cold_pipe, warm_pipe);
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(3 * RTT_MS, warm_seq);
+  TEST_ASSERT_LESS_THAN_UINT32(2 * RTT_MS, warm_pipe);           // one round trip for all three
+  TEST_ASSERT_LESS_THAN_UINT32(900 + 2 * RTT_MS, cold_pipe);
+}
+
+static void test_pipeline_dropped_session_retries_once() {
+  pipeline_feeds();
+  standInDropIdle(SWPC);   // server timed the keep-alive session out
+  pipeline_feeds();
+  TEST_ASSERT_EQUAL_UINT32(2, standInHandshakes(SWPC));
+  TEST_ASSERT_EQUAL_UINT32(6, standInRequests(SWPC));   // three on the dead session, three again
+}
+
+static void test_pipeline_quiet_server_is_not_asked_again() {
+  static const char *const quiet[] = { "/quiet/1", "/quiet/2", "/quiet/3" };
+  pipeline_feeds();   // warm session, so a stale-session retry would be allowed
+  const uint32_t before = standInRequests(SWPC);
+  const unsigned long t0 = millis();
+  Piped p;
+  TEST_ASSERT_EQUAL_INT(0, pool_pipeline(SWPC, quiet, 3, nullptr, piped_sink, &p));
+  const unsigned long took = millis() - t0;
+  printf("pipeline to a server that went quiet: gave up after %lu ms, %u request(s)\n",
+         took, (unsigned)(standInRequests(SWPC) - before));
+  TEST_ASSERT_EQUAL_INT(3, p.n);
+  for (int i = 0; i < 3; i++) TEST_ASSERT_EQUAL_INT(HTTPC_ERROR_READ_TIMEOUT, p.code[i]);
+  TEST_ASSERT_EQUAL_UINT32(before + 3, standInRequests(SWPC));   // each asked once
+  TEST_ASSERT_LESS_THAN_UINT32(POOL_TIMEOUT_MS + 1000, took);    // one timeout, not four
+}
+
+static void test_pipeline_redirect_goes_through_pool_get() {
+  static const char *const paths[] = { feeds[0], "/moved", feeds[2] };
+  Piped p;
+  TEST_ASSERT_EQUAL_INT(2, pool_pipeline(SWPC, paths, 3, nullptr, piped_sink, &p));
+  TEST_ASSERT_EQUAL_INT(3, p.n);   // the 302 itself never reaches the sink
+  for (int i = 0; i < 3; i++) TEST_ASSERT_EQUAL_INT(HTTP_CODE_OK, p.code[i]);
+  TEST_ASSERT_TRUE(p.body[1].find("/here") != std::string::npos);
+  TEST_ASSERT_TRUE(p.body[2].find(feeds[2]) != std::string::npos);
+  TEST_ASSERT_EQUAL_INT(2, standInCount(SWPC, "/moved"));   // pipelined, then again via pool_get()
+  TEST_ASSERT_EQUAL_INT(1, standInCount(SWPC, "/here"));
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_one_handshake_per_host_per_cycle);
+  RUN_TEST(test_back_to_back_cycles_stay_warm);
+  RUN_TEST(test_idle_sessions_close_between_cycles);
+  RUN_TEST(test_third_host_evicts_least_recently_used);
+  RUN_TEST(test_stale_session_reconnects_once);
+  RUN_TEST(test_quiet_server_is_not_asked_again);
+  RUN_TEST(test_pipeline_latency);
+  RUN_TEST(test_pipeline_dropped_session_retries_once);
+  RUN_TEST(test_pipeline_quiet_server_is_not_asked_again);
+  RUN_TEST(test_pipeline_redirect_goes_through_pool_get);
+  return UNITY_END();
+}
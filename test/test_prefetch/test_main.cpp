@@ -0,0 +1,85 @@
+// Neighbour prefetch across taps: while camera 0 is on screen the worker
+// prefetches camera 1 from a slow CDN. Tapping onto camera 1 mid-download
+// must let that download finish and decode it, not cancel it and start the
+// same transfer again cold. Tapping away so the cache no longer keeps
+// camera 1 must still abort it at once.
+#include <unity.h>
+
+#include "Firmware.h"
+#include "NoaaStandIn.h"
+
+#define HANDSHAKE_MS 900
+#define DRIP_BYTES   1460
+#define DRIP_MS      250
+
+static const char *path_of(int cam) { return CAMERAS[cam].url + strlen("https://" NOAA_GOES); }
+
+static int requests_for(int cam) {
+  int n = 0;
+  for (const auto &r : standIn().log) n += (r.path == path_of(cam));
+  return n;
+}
+
+static unsigned long hung_up_ms() { return standInFind(NOAA_GOES)->hung_up_ms; }
+
+static unsigned long transfer_ms(int cam) {
+  const std::string &f = noaaGoesFrame(path_of(cam), noaa().goes_default_version);
+  return (f.size() + DRIP_BYTES - 1) / DRIP_BYTES * DRIP_MS;
+}
+
+// Wait for the idle prefetch of cam to start and let it run for ms
+static void prefetching_for(int cam, unsigned long ms) {
+  TEST_ASSERT_TRUE(nativeRunUntil([=] { return prefetch_running == cam; }, 30000));
+  nativeRunFor(ms);
+  TEST_ASSERT_EQUAL_INT_MESSAGE(cam, prefetch_running, "prefetch finished too soon");
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_tap_onto_the_camera_being_prefetched_keeps_it() {
+  TEST_ASSERT_TRUE(nativeRunUntil([] { return goes_on_screen == 0; }, 2 * transfer_ms(0)));
+  prefetching_for(1, 2000);
+  const int requests = requests_for(1);
+
+  const unsigned long tap = millis();
+  nativeTap(NATIVE_TAP_NEXT);
+  TEST_ASSERT_EQUAL_INT(1, wc_camera_idx);
+  TEST_ASSERT_TRUE(nativeRunUntil([] { return goes_on_screen == 1; }, 2 * transfer_ms(1)));
+  const unsigned long shown = millis() - tap;
+
+  printf("tap onto camera 1, 2 s into its %lu ms prefetch: on screen after %lu ms, "
+         "%d request(s) for it\n", transfer_ms(1), shown, requests_for(1));
+  TEST_ASSERT_EQUAL_INT(requests, requests_for(1));   // the prefetch was the only download
+  TEST_ASSERT_TRUE(hung_up_ms() < tap);               // and it was never cut off
+  // A restart would have paid the handshake and the whole transfer again
+  TEST_ASSERT_LESS_THAN_UINT32(transfer_ms(1) - 2000 + 1000, shown);
+  // The bytes stay cached for the way back
+  TEST_ASSERT_NOT_NULL(prefetch_slots[1].data);
+}
+
+static void test_tap_away_from_it_cancels_it() {
+  // Camera 2 is now the neighbour being prefetched; going back to 0 drops it
+  prefetching_for(2, 2000);
+  const unsigned long tap = millis();
+  nativeTap(NATIVE_TAP_PREV);
+  nativeRunFor(500);
+  TEST_ASSERT_EQUAL_INT(0, wc_camera_idx);
+  TEST_ASSERT_TRUE(hung_up_ms() >= tap);
+  printf("tap away from camera 2's prefetch: aborted after %lu ms\n", hung_up_ms() - tap);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(100, hung_up_ms() - tap);
+  TEST_ASSERT_NULL(prefetch_slots[2].data);
+}
+
+int main(int argc, char **argv) {
+  const time_t now = 1782064800;   // 2026-06-21 18:00 UTC
+  nativeSetTime(now);
+  noaaServe(HANDSHAKE_MS, 100);
+  noaa().tle_epoch = now - 86400;
+  noaa().pace[NOAA_GOES] = { DRIP_BYTES, DRIP_MS };
+  nativeBoot();
+  UNITY_BEGIN();
+  RUN_TEST(test_tap_onto_the_camera_being_prefetched_keeps_it);
+  RUN_TEST(test_tap_away_from_it_cancels_it);
+  return UNITY_END();
+}
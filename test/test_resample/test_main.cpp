@@ -0,0 +1,203 @@
+// Area-averaging resampler (Resample.h) for "Show whole satellite frame".
+// Frames with detail in every pixel are fed to rsStrip() the way JPEGDraw
+// hands them over with JPEG_USES_DMA (16-row bands, 128-pixel strips, the
+// last MCU padded past the right edge) and pushed through the pixel
+// pipeline onto the panel stand-in. The panel is held to an exact
+// floating-point area average: PSNR bound, no channel more than 3 LSB off,
+// bars left black. Then the firmware's own path for the default camera with
+// the setting on, and the resampler's cost per frame.
+//
+// Cost is host CPU time of the decoding thread (the push runs on another
+// task), so it is a relative figure, not the ESP32's. Next to it is a cycle
+// model of the two passes on a 240 MHz ESP32, counted per pixel from their
+// inner loops; the virtual clock charges the resampler nothing, so the
+// whole-frame decode+display adds the model on top.
+#include <unity.h>
+
+#include <cmath>
+#include <ctime>
+
+#include "Firmware.h"
+#include "NoaaStandIn.h"
+
+#define BAND  16
+#define STRIP 128
+
+// ESP32 cycles per pixel of each pass (in-order LX6, one 32-bit MAC per
+// pixel for all three channels):
+#define CYC_H_SRC  10   // rsStrip, per source pixel: load, tap, spread, MAC, emit test
+#define CYC_H_OUT   6   // rsStrip, per band pixel emitted: pack, store, reload carry
+#define CYC_V_SRC   8   // rs_band, per band pixel: load, spread, MAC, accumulator load/store
+#define CYC_V_OUT   8   // rs_band, per output pixel: pack, byte swap, store
+#define ESP32_MHZ 240
+
+// Modelled ESP32 milliseconds to resample sw x sh down to dw x dh
+static double esp32_model_ms(int sw, int sh, int dw, int dh) {
+  const double cycles = (double)CYC_H_SRC * sw * sh + (double)CYC_H_OUT * dw * sh +
+                        (double)CYC_V_SRC * dw * sh + (double)CYC_V_OUT * dw * dh;
+  return cycles / (ESP32_MHZ * 1000.0);
+}
+
+// Source pixel (x, y): gradients plus a hash, so every pixel differs
+static uint16_t source_at(int x, int y) {
+  const uint32_t n = (uint32_t)(x * 73856093u) ^ (uint32_t)(y * 19349663u);
+  const int r = (x * 31 / 640 + (n & 7)) & 31;
+  const int g = (y * 63 / 400 + ((n >> 3) & 15)) & 63;
+  const int b = ((x + y) * 31 / 1000 + ((n >> 7) & 7)) & 31;
+  return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+// Exact area average of the sw x sh source over output pixel (i, j) of dw x dh
+static void area_average(int sw, int sh, int dw, int dh, int i, int j, double rgb[3]) {
+  const double x0 = (double)i * sw / dw, x1 = (double)(i + 1) * sw / dw;
+  const double y0 = (double)j * sh / dh, y1 = (double)(j + 1) * sh / dh;
+  double acc[3] = {}, area = 0;
+  for (int y = (int)y0; y < (int)std::ceil(y1); y++) {
+    const double wy = std::min(y1, y + 1.0) - std::max(y0, (double)y);
+    for (int x = (int)x0; x < (int)std::ceil(x1); x++) {
+      const double w = wy * (std::min(x1, x + 1.0) - std::max(x0, (double)x));
+      const uint16_t c = source_at(x, y);
+      acc[0] += w * (c >> 11);
+      acc[1] += w * ((c >> 5) & 63);
+      acc[2] += w * (c & 31);
+      area += w;
+    }
+  }
+  for (int k = 0; k < 3; k++) rgb[k] = acc[k] / area;
+}
+
+struct Quality { double psnr; double worst; bool bars_black; };
+
+// Panel against the exact average placed at (dx, dy); everything else black
+static Quality compare(int sw, int sh, int dw, int dh, int dx, int dy) {
+  static const double full[3] = { 31, 63, 31 };
+  Quality q = { 0, 0, true };
+  double se = 0;
+  for (int y = 0; y < gfx->height(); y++)
+    for (int x = 0; x < gfx->width(); x++) {
+      const uint16_t p = gfx->pixel(x, y);
+      if (x < dx || y < dy || x >= dx + dw || y >= dy + dh) {
+        q.bars_black &= p == RGB565_BLACK;
+        continue;
+      }
+      double want[3];
+      area_average(sw, sh, dw, dh, x - dx, y - dy, want);
+      const int got[3] = { p >> 11, (p >> 5) & 63, p & 31 };
+      for (int k = 0; k < 3; k++) {
+        const double d = got[k] - want[k];
+        q.worst = std::max(q.worst, std::fabs(d));
+        se += (d / full[k]) * (d / full[k]) / 3;
+      }
+    }
+  q.psnr = se ? 10 * std::log10(dw * dh / se) : INFINITY;
+  return q;
+}
+
+static double cpu_ms() {
+  timespec t;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t);
+  return t.tv_sec * 1e3 + t.tv_nsec / 1e6;
+}
+
+// Feed a sw x sh frame as JPEGDEC strips; CPU ms spent in the resampler
+static double feed(int sw, int sh) {
+  static uint16_t strip[BAND * STRIP];
+  double ms = 0;
+  for (int y = 0; y < sh; y += BAND) {
+    for (int x = 0; x < sw; x += STRIP) {
+      const int w = std::min(STRIP, (sw - x + 15) / 16 * 16);   // whole MCUs
+      for (int r = 0; r < BAND; r++)
+        for (int c = 0; c < w; c++)
+          strip[r * w + c] = x + c < sw && y + r < sh ? source_at(x + c, y + r) : 0xFFFF;
+      const double t0 = cpu_ms();
+      TEST_ASSERT_TRUE(rsStrip(x, y, w, BAND, w, strip));
+      ms += cpu_ms() - t0;
+    }
+  }
+  const double t0 = cpu_ms();
+  TEST_ASSERT_TRUE(rsFinish());
+  TEST_ASSERT_TRUE(pipeFlush());
+  return ms + cpu_ms() - t0;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_matches_the_exact_area_average() {
+  static const struct { int sw, sh, dw, dh; } frames[] = {
+    { 416, 250, 320, 192 },   // CONUS
+    { 339, 339, 240, 240 },   // Full Disk
+    { 625, 375, 320, 192 },   // 1250x750 CONUS decoded at 1/2
+    { 331, 245, 320, 237 },   // barely shrinking: many 1:1 taps
+  };
+  printf("source   -> output     PSNR   worst   resample ms/frame: host CPU  ESP32 model\n");
+  for (const auto &f : frames) {
+    gfx->fillScreen(RGB565_BLACK);
+    const int dx = (gfx->width() - f.dw) / 2, dy = (gfx->height() - f.dh) / 2;
+    pipeStart();
+    TEST_ASSERT_TRUE(rsBegin(f.sw, f.sh, f.dw, f.dh, dx, dy));
+    const double ms = feed(f.sw, f.sh);
+    rsEnd();
+    const Quality q = compare(f.sw, f.sh, f.dw, f.dh, dx, dy);
+
+    // The same frame again, best of 20, for the cost
+    double best = ms;
+    for (int i = 0; i < 20; i++) {
+      pipeStart();
+      rsBegin(f.sw, f.sh, f.dw, f.dh, dx, dy);
+      best = std::min(best, feed(f.sw, f.sh));
+      rsEnd();
+    }
+    printf("%dx%d -> %dx%d %6.1f dB %5.2f LSB %19.2f %12.1f\n", f.sw, f.sh, f.dw, f.dh, q.psnr, q.worst,
+           best, esp32_model_ms(f.sw, f.sh, f.dw, f.dh));
+    char msg[32];
+    snprintf(msg, sizeof(msg), "%dx%d -> %dx%d", f.sw, f.sh, f.dw, f.dh);
+    TEST_ASSERT_TRUE_MESSAGE(q.psnr >= 38.0, msg);
+    TEST_ASSERT_TRUE_MESSAGE(q.worst <= 3.0, msg);
+    TEST_ASSERT_TRUE_MESSAGE(q.bars_black, msg);
+  }
+}
+
+static void test_whole_conus_frame_on_the_panel() {
+  // The firmware's path for the default camera with the setting on
+  wc_fit_whole = true;
+  const std::string &f = noaaGoesFrame(CAMERAS[0].url + strlen("https://" NOAA_GOES), 1);
+  FetchJob job = {};
+  job.mode = 0;
+  job.gen  = fetch_gen;
+  HttpsJpeg img = {};
+  img.buf = (uint8_t *)f.data();
+  img.len = (int32_t)f.size();
+  gfx->fillScreen(RGB565_BLACK);
+  const unsigned long t0 = micros();
+  TEST_ASSERT_EQUAL_INT(FETCH_DRAWN, goesDecodeCached(job, &img));
+  const unsigned long whole = micros() - t0;
+  wc_fit_whole = false;
+  TEST_ASSERT_NULL(rs);
+
+  // 416x250 -> 320x192 at (0, 24): bars above and below, the frame's own
+  // last column and row on screen
+  for (int x = 0; x < gfx->width(); x += 7) {
+    TEST_ASSERT_EQUAL_HEX16(RGB565_BLACK, gfx->pixel(x, 23));
+    TEST_ASSERT_EQUAL_HEX16(RGB565_BLACK, gfx->pixel(x, 24 + 192));
+  }
+  gfx->fillScreen(RGB565_BLACK);
+  const unsigned long t1 = micros();
+  TEST_ASSERT_EQUAL_INT(FETCH_DRAWN, goesDecodeCached(job, &img));
+  const unsigned long cropped = micros() - t1;
+  const double model = esp32_model_ms(416, 250, 320, 192);
+  printf("CONUS decode+display on the virtual clock: cropped %.1f ms, whole frame %.1f ms "
+         "+ %.1f ms modelled resampling = %.1f ms\n", cropped / 1000.0, whole / 1000.0, model,
+         whole / 1000.0 + model);
+  // Every MCU is decoded instead of 320 of 416 and both passes run, but
+  // fewer pixels go out
+  TEST_ASSERT_TRUE(whole / 1000.0 + model < cropped / 1000.0 * 3 / 2);
+}
+
+int main(int argc, char **argv) {
+  nativeBoot();   // gfx up and the push task started; loop() is never run
+  UNITY_BEGIN();
+  RUN_TEST(test_matches_the_exact_area_average);
+  RUN_TEST(test_whole_conus_frame_on_the_panel);
+  return UNITY_END();
+}
@@ -0,0 +1,167 @@
+// Refresh scheduler on a fake clock. First Scheduler.h on its own: deadline
+// order, the visible source jumping the queue, schedCancel() out of the
+// middle of the heap, schedNoLaterThan() only ever pulling a deadline in, and
+// the background budget (SCHED_BG_GAP_MS spacing, SCHED_BG_MIN_HEAP floor).
+// Then the whole firmware for an hour on a GOES camera against fast
+// stand-ins, reporting fetches per hour and worst staleness per mode: every
+// text source must keep to its own cadence although none is on screen.
+#include <unity.h>
+
+#include "Firmware.h"
+#include "NoaaStandIn.h"
+
+void setUp() {}
+void tearDown() {}
+
+// Let the background gap from any earlier pop run out
+static void settle() { nativeAdvance(SCHED_BG_GAP_MS); }
+
+static void test_pops_in_deadline_order() {
+  schedInit();
+  settle();
+  const unsigned long t = millis();
+  schedAt(3, t + 300);
+  schedAt(1, t + 100);
+  schedAt(2, t + 200);
+  TEST_ASSERT_EQUAL_INT(-1, schedNext(-1, true));   // nothing due yet
+
+  static const int order[] = { 1, 2, 3 };
+  for (int src : order) {
+    nativeAdvance(100 + SCHED_BG_GAP_MS);
+    TEST_ASSERT_EQUAL_INT(src, schedNext(-1, true));
+    TEST_ASSERT_FALSE(schedPending(src));
+  }
+  TEST_ASSERT_EQUAL_INT(-1, schedNext(-1, true));
+}
+
+static void test_visible_source_goes_first() {
+  schedInit();
+  settle();
+  const unsigned long t = millis();
+  schedAt(4, t - 1000);   // long overdue, but background
+  schedAt(5, t);
+  TEST_ASSERT_EQUAL_INT(5, schedNext(5, false));
+  // Background held back while the user is tapping through modes...
+  TEST_ASSERT_EQUAL_INT(-1, schedNext(5, false));
+  // ...and allowed once they stop
+  TEST_ASSERT_EQUAL_INT(4, schedNext(5, true));
+}
+
+static void test_cancel_from_the_middle_keeps_the_heap() {
+  schedInit();
+  settle();
+  const unsigned long t = millis();
+  for (int src = 0; src < 10; src++) schedAt(src, t + 1000 + (src * 7 % 10) * 100);
+  schedCancel(4);
+  schedCancel(0);
+  schedCancel(4);   // not on it any more: no-op
+  TEST_ASSERT_FALSE(schedPending(4));
+
+  nativeAdvance(10000);
+  unsigned long last = 0;
+  int popped = 0;
+  for (int src; (src = schedNext(-1, true)) >= 0; popped++) {
+    TEST_ASSERT_TRUE(src != 0 && src != 4);
+    const unsigned long due = t + 1000 + (src * 7 % 10) * 100;
+    TEST_ASSERT_TRUE(due >= last);
+    last = due;
+    nativeAdvance(SCHED_BG_GAP_MS);
+  }
+  TEST_ASSERT_EQUAL_INT(8, popped);
+}
+
+static void test_no_later_than_only_pulls_in() {
+  schedInit();
+  const unsigned long t = millis();
+  schedAt(2, t + 60000);
+  schedNoLaterThan(2, t + 5000);
+  TEST_ASSERT_EQUAL_UINT32(t + 5000, schedDue(2));
+  schedNoLaterThan(2, t + 30000);   // later than what it has: kept
+  TEST_ASSERT_EQUAL_UINT32(t + 5000, schedDue(2));
+  schedNoLaterThan(3, t + 30000);   // not scheduled: added
+  TEST_ASSERT_EQUAL_UINT32(t + 30000, schedDue(3));
+  schedAt(2, t + 90000);            // schedAt() may push it back out
+  TEST_ASSERT_EQUAL_UINT32(t + 90000, schedDue(2));
+}
+
+static void test_background_budget() {
+  schedInit();
+  settle();
+  const unsigned long t = millis();
+  for (int src = 0; src < 3; src++) schedAt(src, t + src);
+  nativeAdvance(2);
+
+  // Everything is due, but background jobs go out SCHED_BG_GAP_MS apart
+  TEST_ASSERT_EQUAL_INT(0, schedNext(-1, true));
+  TEST_ASSERT_EQUAL_INT(-1, schedNext(-1, true));
+  nativeAdvance(SCHED_BG_GAP_MS - 1);
+  TEST_ASSERT_EQUAL_INT(-1, schedNext(-1, true));
+  nativeAdvance(1);
+  TEST_ASSERT_EQUAL_INT(1, schedNext(-1, true));
+
+  // Short on heap: background waits, the visible source does not
+  nativeAdvance(SCHED_BG_GAP_MS);
+  native_heap_used = NATIVE_HEAP_SIZE - SCHED_BG_MIN_HEAP + 1;
+  TEST_ASSERT_EQUAL_INT(-1, schedNext(-1, true));
+  schedAt(7, millis());
+  TEST_ASSERT_EQUAL_INT(7, schedNext(7, true));
+  native_heap_used = 0;
+  TEST_ASSERT_EQUAL_INT(2, schedNext(-1, true));
+}
+
+// ── One hour of the firmware on a GOES camera ───────────────────────────────
+
+#define SIM_MS (60UL * 60 * 1000)
+
+static void test_an_hour_on_a_camera() {
+  nativeBoot();   // camera 0 on screen; every text source off screen
+  TEST_ASSERT_TRUE(nativeRunUntil([] {
+    for (int m = NUM_CAMERAS; m < NUM_MODES; m++) if (!mode_data[m].data) return false;
+    return goes_on_screen == 0;
+  }, 60000));
+
+  uint16_t runs0[NUM_MODES];
+  unsigned long worst_age[NUM_MODES] = {};
+  for (int m = 0; m < NUM_MODES; m++) runs0[m] = sched_runs[m];
+  const unsigned long t0 = millis();
+  while (millis() - t0 < SIM_MS) {
+    nativeRunFor(1000);
+    for (int m = 0; m < NUM_MODES; m++) {
+      if (m > 0 && m < NUM_CAMERAS) continue;   // cameras off screen are prefetched instead
+      worst_age[m] = max(worst_age[m], millis() - mode_data[m].fetched_ms);
+    }
+  }
+
+  printf("mode               interval  fetches/h  worst age\n");
+  for (int m = 0; m < NUM_MODES; m++) {
+    if (m > 0 && m < NUM_CAMERAS) continue;
+    const unsigned long interval = modeInterval(m);
+    const unsigned runs = sched_runs[m] - runs0[m];
+    printf("%2d %-15.15s %6lus %10u %9lus\n", m, m < NUM_CAMERAS ? CAMERAS[m].name : "",
+           interval / 1000, runs, worst_age[m] / 1000);
+
+    // On cadence: about an hour's worth of fetches, no more
+    const unsigned expected = SIM_MS / interval;
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(expected + 1, runs);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(expected ? expected - 1 : 0, runs);
+    // Fresh, on screen or not: never older than its interval plus the
+    // wait for a background slot behind the other sources
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(min(interval, SIM_MS) + NUM_MODES * SCHED_BG_GAP_MS, worst_age[m]);
+  }
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_pops_in_deadline_order);
+  RUN_TEST(test_visible_source_goes_first);
+  RUN_TEST(test_cancel_from_the_middle_keeps_the_heap);
+  RUN_TEST(test_no_later_than_only_pulls_in);
+  RUN_TEST(test_background_budget);
+
+  const time_t now = 1782064800;   // 2026-06-21 18:00 UTC
+  nativeSetTime(now);
+  noaaServe(300, 60);
+  noaa().tle_epoch = now - 86400;
+  RUN_TEST(test_an_hour_on_a_camera);
+  return UNITY_END();
+}
@@ -0,0 +1,122 @@
+// Bytes pushed per refresh of each text mode, through the whole firmware on
+// the framebuffer stand-in. For every mode the fresh snapshot is drawn as the
+// firmware draws it (drawSnapshot / drawIss) onto the frame already on
+// screen, and the panel traffic counted: a full repaint (what every refresh
+// cost before the screen model: clear the content area, draw every label),
+// a refresh whose data did not change, and one where it did the way it does
+// in the field (forecast text, a new alert, Kp, the ISS 30 s on, the sun and
+// moon a minute on). An incremental frame must leave exactly the pixels a
+// full repaint of the same snapshot leaves.
+#include <unity.h>
+
+#include "Firmware.h"
+#include "NoaaStandIn.h"
+
+static const NoaaAlert FLOOD   = { "urn:oid:2.49.0.1.840.0.2", "Flood Watch", "Moderate",
+                                   "Flood Watch issued June 21 at 11:55AM MDT" };
+static const NoaaAlert TORNADO = { "urn:oid:2.49.0.1.840.0.1", "Tornado Warning", "Extreme",
+                                   "Tornado Warning issued June 21 at 11:50AM MDT" };
+
+struct Push { uint32_t windows; uint64_t bytes; };
+
+static uint32_t content() { return gfx->checksum(0, SCR_TOP, gfx->width(), gfx->height() - SCR_TOP); }
+
+// Redraw the mode's current snapshot and count what went over the bus
+static Push draw(int mode) {
+  gfx_native_stats = {};
+  drawSnapshot(mode, mode_data[mode].data);
+  return { gfx_native_stats.windows, gfx_native_stats.px * 2 };
+}
+
+// Fetch the mode again as the worker would and swap the snapshot in
+static void refetch(int mode) {
+  FetchJob job = {};
+  job.mode = mode;
+  strcpy(job.lat, wc_lat);
+  strcpy(job.lon, wc_lon);
+  FetchResult res = {};
+  if (mode == NWS_ALERTS_MODE) nws_alerts_where[0] = '\0';   // parse it even if unchanged
+  runFetchJob(job, res);
+  TEST_ASSERT_EQUAL_INT(FETCH_OK, res.status);
+  freeSnapshot(mode, mode_data[mode].data);
+  mode_data[mode].data = res.data;
+}
+
+static void go_to(int mode, int tap) {
+  while (wc_camera_idx != mode) {
+    nativeRunFor(500);   // touch debounce
+    nativeTap(tap);
+  }
+  TEST_ASSERT_TRUE(nativeRunUntil([=] {
+    return mode_data[mode].data && scr_screen == mode && fetch_running < 0 && prefetch_running < 0;
+  }, 60000));
+}
+
+static const char *name_of(int mode) {
+  switch (mode) {
+    case NWS_FORECAST_MODE:  return "forecast";
+    case NWS_ALERTS_MODE:    return "alerts";
+    case SPACE_WEATHER_MODE: return "space weather";
+    case ISS_MODE:           return "ISS";
+    default:                 return "sun & moon";
+  }
+}
+
+// Full, unchanged and changed refresh of the mode on screen
+template <class Change> static void measure(int mode, Change change) {
+  scrInvalidate();
+  const Push full = draw(mode);
+
+  refetch(mode);
+  const Push same = draw(mode);
+
+  change();
+  refetch(mode);
+  const Push moved = draw(mode);
+
+  const uint32_t incremental = content();
+  scrInvalidate();
+  draw(mode);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(content(), incremental, name_of(mode));
+
+  printf("%-14s %7llu B %4u win  %7llu B %4u win  %7llu B %4u win\n", name_of(mode),
+         (unsigned long long)full.bytes, (unsigned)full.windows, (unsigned long long)same.bytes,
+         (unsigned)same.windows, (unsigned long long)moved.bytes, (unsigned)moved.windows);
+  // The content-area clear alone was 140 KB per refresh
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(gfx->width() * (gfx->height() - SCR_TOP) * 2, (uint32_t)full.bytes);
+  TEST_ASSERT_LESS_THAN_UINT32((uint32_t)full.bytes / 3, (uint32_t)moved.bytes);
+  // ISS and sun & moon readouts follow the clock, which the fetch itself moves on
+  if (mode != ISS_MODE && mode != SUN_MOON_MODE) TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)same.bytes);
+  TEST_ASSERT_TRUE(moved.bytes > 0);
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_bytes_per_refresh() {
+  printf("mode              full repaint         unchanged            changed\n");
+  go_to(NWS_ALERTS_MODE, NATIVE_TAP_NEXT);
+  measure(NWS_ALERTS_MODE, [] { noaa().alerts = { FLOOD, TORNADO }; });
+  go_to(SPACE_WEATHER_MODE, NATIVE_TAP_NEXT);
+  measure(SPACE_WEATHER_MODE, [] { noaa().kp = "4.67"; });
+  go_to(ISS_MODE, NATIVE_TAP_NEXT);
+  measure(ISS_MODE, [] { nativeAdvance(30000); });
+  go_to(SUN_MOON_MODE, NATIVE_TAP_NEXT);
+  measure(SUN_MOON_MODE, [] { nativeAdvance(SUN_MOON_INTERVAL); });
+  go_to(NWS_FORECAST_MODE, NATIVE_TAP_PREV);
+  measure(NWS_FORECAST_MODE, [] { noaa().weather = "Chance Showers And Thunderstorms"; });
+}
+
+int main(int argc, char **argv) {
+  const time_t now = 1782064800;   // 2026-06-21 18:00 UTC
+  nativeSetTime(now);
+  noaaServe(300, 60);
+  noaa().tle_epoch = now - 86400;
+  noaa().alerts = { FLOOD };
+  NativeSettings s;
+  s.camera = NWS_ALERTS_MODE;
+  nativeBoot(s);
+  UNITY_BEGIN();
+  RUN_TEST(test_bytes_per_refresh);
+  return UNITY_END();
+}
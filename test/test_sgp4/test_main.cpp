@@ -0,0 +1,97 @@
+// SGP4.h against Vallado's published verification run (tcppver.out, WGS-72,
+// "improved" mode) for satellite 00005, the near-earth case with a high
+// eccentricity that exercises every drag term: TEME position and velocity at
+// epoch and six hours on. Then the same steps with the post-secular kernel
+// in float, for its error and host time per step next to double's.
+//
+// Every test parses the element set itself (setUp), so any one runs alone.
+//
+// Host time is wall-clock and only relative: on the ESP32 float has the FPU
+// and double is done in software, so the ratio there is far larger. Neither
+// figure is the device's; that is "SGP4 step N us" on the [ISS] log line.
+#include <unity.h>
+
+#include <chrono>
+
+#include "SGP4.h"
+
+static const char *L1 = "1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753";
+static const char *L2 = "2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667";
+
+struct Ref { double t, r[3], v[3]; };
+static const Ref REF[] = {
+  {   0.0, {  7022.46529266, -1400.08296755,     0.03995155 }, { 1.893841015,  6.405893759,  4.534807250 } },
+  { 360.0, { -7154.03120202, -3783.17682504, -3536.19412294 }, { 4.741887409, -4.151817765, -2.093935425 } },
+};
+
+static Sgp4 sat;
+
+static double dist(const double a[3], const double b[3]) {
+  return sqrt((a[0] - b[0]) * (a[0] - b[0]) + (a[1] - b[1]) * (a[1] - b[1]) + (a[2] - b[2]) * (a[2] - b[2]));
+}
+
+// Host microseconds per sgp4Propagate<T> step over a day of one-minute steps
+template <typename T> static double us_per_step() {
+  double r[3], v[3], sink = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int rep = 0; rep < 20; rep++) {
+    for (int m = 0; m < 1440; m++) {
+      sgp4Propagate<T>(&sat, m, r, v);
+      sink += r[0];
+    }
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  TEST_ASSERT_TRUE(sink == sink);   // keep the loop
+  return std::chrono::duration<double, std::micro>(t1 - t0).count() / (20 * 1440);
+}
+
+void setUp() { TEST_ASSERT_TRUE(sgp4Parse(L1, L2, &sat)); }
+void tearDown() {}
+
+static void test_parse_vallado_00005() {
+  TEST_ASSERT_FALSE(sat.isimp);   // perigee above 220 km: the full drag terms
+  TEST_ASSERT_DOUBLE_WITHIN(1e-9, 0.1859667, sat.ecco);
+  // Epoch 2000 day 179.78495062
+  TEST_ASSERT_DOUBLE_WITHIN(1e-3, (10957.0 + 178.78495062) * 86400.0, sat.epoch_unix);
+
+  // A flipped digit fails the checksum
+  char bad[70];
+  strcpy(bad, L2);
+  bad[20] = '9';
+  Sgp4 s;
+  TEST_ASSERT_FALSE(sgp4Parse(L1, bad, &s));
+}
+
+static void test_matches_reference_vectors() {
+  for (const Ref &ref : REF) {
+    double r[3], v[3];
+    TEST_ASSERT_TRUE(sgp4Propagate(&sat, ref.t, r, v));
+    printf("t=%5.0f min: r off by %.2e km, v off by %.2e km/s\n", ref.t, dist(r, ref.r), dist(v, ref.v));
+    for (int i = 0; i < 3; i++) {
+      TEST_ASSERT_DOUBLE_WITHIN(1e-6, ref.r[i], r[i]);
+      TEST_ASSERT_DOUBLE_WITHIN(1e-9, ref.v[i], v[i]);
+    }
+  }
+}
+
+static void test_float_kernel_error_and_time() {
+  double worst = 0;
+  for (const Ref &ref : REF) {
+    double r[3], v[3];
+    TEST_ASSERT_TRUE(sgp4Propagate<float>(&sat, ref.t, r, v));
+    worst = max(worst, dist(r, ref.r));
+  }
+  const double us_d = us_per_step<double>(), us_f = us_per_step<float>();
+  printf("per step on the host: double %.3f us, float %.3f us; float kernel off by up to %.3f km\n",
+         us_d, us_f, worst);
+  // The secular terms stay double, so float costs tens of metres, not kilometres
+  TEST_ASSERT_TRUE(worst < 0.05);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_parse_vallado_00005);
+  RUN_TEST(test_matches_reference_vectors);
+  RUN_TEST(test_float_kernel_error_and_time);
+  return UNITY_END();
+}
@@ -0,0 +1,118 @@
+// SunMoon.h kernels in float (what the ESP32's single-precision FPU runs)
+// against the same templates instantiated in double, over a century of
+// dates: 1950-2050 every 5 days, at the equator, mid-latitudes and the
+// Arctic. Sun events must agree to a small fraction of the minute shown on
+// screen, and the moon's altitude to well inside the arcminutes the series
+// are good to. Then host time per call in each type; on the board the
+// Serial log carries the cycle counts.
+#include <unity.h>
+
+#include <chrono>
+
+#include "SunMoon.h"
+
+Arduino_GFX *gfx = nullptr;
+
+static const double LATS[] = { 0.0, 40.015, 51.5074, 69.6492, -33.8688 };
+static const double LONS[] = { 0.0, -105.2705, -0.1278, 18.9553, 151.2093 };
+static const double ZENITHS[] = { SM_ZENITH_RISESET, SM_ZENITH_CIVIL, SM_ZENITH_NAUTICAL, SM_ZENITH_ASTRO };
+
+// Calendar date n days after 1950-01-01
+static void date_of(int n, int &y, int &m, int &d) {
+  time_t t = (time_t)(n - 7305) * 86400;
+  struct tm tm;
+  gmtime_r(&t, &tm);
+  y = tm.tm_year + 1900;
+  m = tm.tm_mon + 1;
+  d = tm.tm_mday;
+}
+
+static const int CENTURY = 36525;
+
+void setUp() {}
+void tearDown() {}
+
+static void test_sun_events_over_a_century() {
+  double worst = 0;
+  int events = 0, mismatched = 0;
+  for (int n = 0; n < CENTURY; n += 5) {
+    int y, m, d;
+    date_of(n, y, m, d);
+    for (int k = 0; k < 5; k++) {
+      for (double z : ZENITHS) {
+        for (int dir = -1; dir <= 1; dir += 2) {
+          const double f = sm_sun_event<float>(y, m, d, LATS[k], LONS[k], z, dir);
+          const double e = sm_sun_event<double>(y, m, d, LATS[k], LONS[k], z, dir);
+          if ((f < 0) != (e < 0)) { mismatched++; continue; }   // at the edge of polar day
+          if (e < 0) continue;
+          double diff = fabs(f - e);
+          if (diff > 720) diff = 1440 - diff;   // across midnight
+          worst = max(worst, diff);
+          events++;
+        }
+      }
+      const double f = sm_sun_event<float>(y, m, d, LATS[k], LONS[k], 0.0, 0);
+      const double e = sm_sun_event<double>(y, m, d, LATS[k], LONS[k], 0.0, 0);
+      worst = max(worst, fabs(f - e));
+    }
+  }
+  printf("sun, 1950-2050: %d events, float vs double at most %.4f min (%.1f s); "
+         "%d flipped at the polar-day edge\n", events, worst, worst * 60, mismatched);
+  TEST_ASSERT_TRUE(worst < 0.05);                  // 3 s: never changes the minute by more than one
+  TEST_ASSERT_LESS_OR_EQUAL_INT(2, mismatched);   // a day the two types put either side of polar day
+}
+
+static void test_moon_over_a_century() {
+  double worst_alt = 0, worst_pos = 0, worst_par = 0;
+  for (int n = 0; n < CENTURY; n += 5) {
+    const double d = n - 18262.5 + (n % 24) / 24.0;   // days since J2000, hour varying
+    float  ra_f, dec_f, par_f;
+    double ra_d, dec_d, par_d;
+    sm_moon_radec<float>(d, ra_f, dec_f, &par_f);
+    sm_moon_radec<double>(d, ra_d, dec_d, &par_d);
+    double dra = fabs(ra_f - ra_d);
+    if (dra > 180) dra = 360 - dra;
+    worst_pos = max(worst_pos, dra * cos(dec_d * M_PI / 180));
+    worst_pos = max(worst_pos, fabs(dec_f - dec_d));
+    worst_par = max(worst_par, fabs(par_f - par_d));
+    for (int k = 0; k < 5; k++) {
+      const double a = sm_moon_alt<float>(d, LATS[k], LONS[k]);
+      const double b = sm_moon_alt<double>(d, LATS[k], LONS[k]);
+      worst_alt = max(worst_alt, fabs(a - b));
+    }
+  }
+  // The moon's hour angle turns 0.25 deg a minute: express the altitude
+  // difference as the shift it makes in a rise or set at the equator
+  printf("moon, 1950-2050: float vs double position %.3f', parallax %.4f', altitude %.3f' "
+         "(~%.2f s of rise/set time)\n", worst_pos * 60, worst_par * 60, worst_alt * 60, worst_alt / 0.25 * 60);
+  TEST_ASSERT_TRUE(worst_pos * 60 < 0.5);
+  TEST_ASSERT_TRUE(worst_alt * 60 < 0.5);
+  TEST_ASSERT_TRUE(worst_alt / 0.25 < 0.05);   // under 3 s of rise/set time
+}
+
+template <typename T> static double ns_per(int which) {
+  const int reps = 20000;
+  volatile double sink = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < reps; i++) {
+    const double d = 8000.0 + i * 0.37;
+    if (which == 0) sink = sink + sm_sun_event<T>(2024, 1 + i % 12, 1 + i % 28, 51.5, -0.13, SM_ZENITH_RISESET, -1);
+    else            sink = sink + (double)sm_moon_alt<T>(d, 51.5, -0.13);
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / reps;
+}
+
+static void test_cost() {
+  printf("host ns per call      float  double\n");
+  printf("  sm_sun_event     %8.0f %7.0f\n", ns_per<float>(0), ns_per<double>(0));
+  printf("  sm_moon_alt      %8.0f %7.0f\n", ns_per<float>(1), ns_per<double>(1));
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_sun_events_over_a_century);
+  RUN_TEST(test_moon_over_a_century);
+  RUN_TEST(test_cost);
+  return UNITY_END();
+}
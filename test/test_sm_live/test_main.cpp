@@ -0,0 +1,131 @@
+// Live sun/moon panel, per 1 Hz tick. What a tick computes: alt/az of both
+// bodies from the snapshot's hourly Chebyshev fits, which must track the full
+// kernels to a fiftieth of the 0.1° the readouts show and cost a fraction of
+// them. What a tick pushes: an hour of ticks over Denver through the screen
+// model on the framebuffer stand-in, with the snapshot rebuilt every
+// SUN_MOON_INTERVAL as the firmware does, counted in windows, pixels and
+// bus time against a full repaint of the screen.
+//
+// Compute time is host wall-clock (the virtual clock only moves on the bus),
+// so it is a relative figure, not the ESP32's.
+#include <unity.h>
+
+#include <chrono>
+
+#include "SunMoon.h"
+
+Arduino_GFX *gfx = new Arduino_ILI9341(new Arduino_HWSPI(2, 15), GFX_NOT_DEFINED, 1);
+
+#define LAT   "39.7392"
+#define LON   "-104.9903"
+#define START 1782064800   // 2026-06-21 18:00 UTC
+
+struct Push { uint32_t windows; uint64_t px; unsigned long us; };
+
+// One frame of the Sun & Moon screen, as drawSnapshot() does it
+static Push frame(const SunMoonData *d) {
+  gfx_native_stats = {};
+  const unsigned long t0 = micros();
+  do {
+    scrBegin(0);   // any id: the model only tells screens apart
+    sunMoonDraw(d, time(nullptr));
+  } while (!scrEnd());
+  return { gfx_native_stats.windows, gfx_native_stats.px, micros() - t0 };
+}
+
+template <class Fn> static double ns_per_call(Fn fn, int reps = 20000) {
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < reps; i++) fn(i);
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / reps;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_fit_tracks_the_kernels() {
+  nativeSetTime(START + 1234);
+  SunMoonData *d = sunMoonFetch(LAT, LON);
+  TEST_ASSERT_NOT_NULL(d);
+  const time_t t0 = d->sky.t0;
+  TEST_ASSERT_EQUAL_INT(START, (int)t0);
+
+  // Two hours, off the fit's nodes: alt/az against a snapshot with no fit
+  SmSky none = d->sky;
+  none.t0 = 0;
+  double worst[2] = {};
+  for (int s = 0; s <= SM_CHEB_SPAN; s += 7) {
+    sm_real alt[2], az[2], alt_k[2], az_k[2];
+    TEST_ASSERT_TRUE(sm_sky_altaz(&d->sky, d->lat, d->lon, t0 + s, alt, az));
+    TEST_ASSERT_FALSE(sm_sky_altaz(&none, d->lat, d->lon, t0 + s, alt_k, az_k));
+    for (int b = SM_SUN; b <= SM_MOON; b++) {
+      double daz = std::fabs((double)az[b] - az_k[b]);
+      if (daz > 180) daz = 360 - daz;
+      worst[b] = max(worst[b], max(std::fabs((double)alt[b] - alt_k[b]), daz * std::cos(alt_k[b] * M_PI / 180)));
+    }
+  }
+
+  volatile sm_real sink = 0;
+  const double fit_ns = ns_per_call([&](int i) {
+    sm_real alt[2], az[2];
+    sm_sky_altaz(&d->sky, d->lat, d->lon, t0 + i % SM_CHEB_SPAN, alt, az);
+    sink = sink + alt[1];
+  });
+  const double kernel_ns = ns_per_call([&](int i) {
+    sm_real alt[2], az[2];
+    sm_sky_altaz(&none, d->lat, d->lon, t0 + i % SM_CHEB_SPAN, alt, az);
+    sink = sink + alt[1];
+  });
+  const double fit_build_ns = ns_per_call([&](int i) { sm_sky_fit(&none, t0 + i); }, 2000);
+  printf("tick alt/az (%s): fit %.0f ns, full kernels %.0f ns on the host; refit once a "
+         "minute %.0f ns; worst fit error sun %.5f deg, moon %.5f deg\n",
+         sizeof(sm_real) == 4 ? "float" : "double", fit_ns, kernel_ns, fit_build_ns, worst[SM_SUN], worst[SM_MOON]);
+  TEST_ASSERT_TRUE(worst[SM_SUN] < 0.002);
+  TEST_ASSERT_TRUE(worst[SM_MOON] < 0.002);
+  TEST_ASSERT_TRUE(fit_ns * 2 < kernel_ns);
+  delete d;
+}
+
+static void test_an_hour_of_ticks() {
+  nativeSetTime(START);
+  SunMoonData *d = sunMoonFetch(LAT, LON);
+  scrInvalidate();
+  const Push full = frame(d);
+
+  Push worst = {}, total = {};
+  int quiet = 0;
+  const int ticks = 3600;
+  for (int i = 1; i <= ticks; i++) {
+    nativeAdvance(SM_TICK_MS);
+    if (i % (SUN_MOON_INTERVAL / SM_TICK_MS) == 0) {   // the hourly-fit snapshot is rebuilt
+      delete d;
+      d = sunMoonFetch(LAT, LON);
+    }
+    const Push p = frame(d);
+    total.windows += p.windows;
+    total.px      += p.px;
+    total.us      += p.us;
+    if (p.us > worst.us) worst = p;
+    quiet += p.px == 0;
+  }
+  delete d;
+
+  printf("full repaint: %u windows, %llu px, %lu us of bus\n", (unsigned)full.windows,
+         (unsigned long long)full.px, full.us);
+  printf("%d ticks: mean %.1f windows, %.0f px, %.0f us of bus; worst %u windows, %llu px, "
+         "%lu us; %d pushed nothing\n", ticks, (double)total.windows / ticks, (double)total.px / ticks,
+         (double)total.us / ticks, (unsigned)worst.windows, (unsigned long long)worst.px, worst.us, quiet);
+  // Steady state pushes a sliver of the screen, and even the worst tick
+  // (a readout and the sky plot together) stays well inside the second
+  TEST_ASSERT_LESS_THAN_UINT32(full.us / 20, total.us / ticks);
+  TEST_ASSERT_LESS_THAN_UINT32(full.us / 2, worst.us);
+  TEST_ASSERT_LESS_THAN_UINT32(SM_TICK_MS * 1000 / 20, worst.us);
+}
+
+int main(int argc, char **argv) {
+  gfx->begin();
+  UNITY_BEGIN();
+  RUN_TEST(test_fit_tracks_the_kernels);
+  RUN_TEST(test_an_hour_of_ticks);
+  return UNITY_END();
+}
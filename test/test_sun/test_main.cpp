@@ -0,0 +1,95 @@
+// On-device solar ephemeris against published almanac times (UTC, to the
+// minute): what sunMoonFetch() puts on the Sun & Moon screen must be within
+// a minute of them. Midwinter in London, midsummer in Boulder (sunset falls
+// after UTC midnight and wraps onto the same day), and polar day and polar
+// night on Svalbard, where there is no rise or set to show. Then the host
+// cost of one event, in the firmware's float kernel and in double.
+#include <unity.h>
+
+#include <chrono>
+
+#include "SunMoon.h"
+
+Arduino_GFX *gfx = nullptr;
+
+// "HH:MM" -> minutes after midnight, -1 for "--:--"
+static int minutes(const char *hhmm) {
+  if (hhmm[0] == '-') return -1;
+  return atoi(hhmm) * 60 + atoi(hhmm + 3);
+}
+
+static SunMoonData *at(time_t utc, const char *lat, const char *lon) {
+  nativeSetTime(utc);
+  SunMoonData *d = sunMoonFetch(lat, lon);
+  TEST_ASSERT_NOT_NULL(d);
+  return d;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_london_midwinter() {
+  SunMoonData *d = at(1734782400, "51.5074", "-0.1278");   // 2024-12-21 12:00 UTC
+  printf("London 2024-12-21: rise %s set %s noon %s, civil %s-%s\n", d->sr, d->ss, d->noon, d->cdawn, d->cdusk);
+  TEST_ASSERT_INT_WITHIN(1, 8 * 60 + 4, minutes(d->sr));
+  TEST_ASSERT_INT_WITHIN(1, 15 * 60 + 54, minutes(d->ss));
+  TEST_ASSERT_INT_WITHIN(1, 11 * 60 + 58, minutes(d->noon));
+  // Twilights nest around the day, deepest outermost
+  TEST_ASSERT_TRUE(minutes(d->adawn) < minutes(d->ndawn) && minutes(d->ndawn) < minutes(d->cdawn));
+  TEST_ASSERT_TRUE(minutes(d->cdawn) < minutes(d->sr));
+  TEST_ASSERT_TRUE(minutes(d->ss) < minutes(d->cdusk) && minutes(d->cdusk) < minutes(d->ndusk));
+  TEST_ASSERT_TRUE(minutes(d->ndusk) < minutes(d->adusk));
+  delete d;
+}
+
+static void test_boulder_midsummer() {
+  SunMoonData *d = at(1718971200, "40.0150", "-105.2705");   // 2024-06-21 12:00 UTC
+  printf("Boulder 2024-06-21: rise %s set %s noon %s\n", d->sr, d->ss, d->noon);
+  // 05:32 / 20:33 MDT at these coordinates; a minute is 0.25 degrees of
+  // longitude, so tables for "Boulder" elsewhere in town differ by one
+  TEST_ASSERT_INT_WITHIN(1, 11 * 60 + 32, minutes(d->sr));
+  TEST_ASSERT_INT_WITHIN(1, 2 * 60 + 33, minutes(d->ss));
+  TEST_ASSERT_INT_WITHIN(1, 19 * 60 + 2, minutes(d->noon));
+  delete d;
+}
+
+static void test_svalbard_has_no_rise_or_set() {
+  SunMoonData *d = at(1718971200, "78.2232", "15.6267");   // polar day
+  TEST_ASSERT_EQUAL_STRING("--:--", d->sr);
+  TEST_ASSERT_EQUAL_STRING("--:--", d->ss);
+  TEST_ASSERT_EQUAL_STRING("--:--", d->cdawn);
+  TEST_ASSERT_TRUE(minutes(d->noon) >= 0);   // the sun still culminates
+  delete d;
+
+  d = at(1734782400, "78.2232", "15.6267");                // polar night
+  TEST_ASSERT_EQUAL_STRING("--:--", d->sr);
+  TEST_ASSERT_EQUAL_STRING("--:--", d->ss);
+  delete d;
+}
+
+template <typename T> static double ns_per_event() {
+  const int reps = 20000;
+  double sink = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < reps; i++) {
+    sink += sm_sun_event<T>(2024, 1 + i % 12, 1 + i % 28, 40.015, -105.2705, SM_ZENITH_RISESET, -1);
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  TEST_ASSERT_TRUE(sink > 0);
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / reps;
+}
+
+static void test_event_cost() {
+  const double f = ns_per_event<float>(), d = ns_per_event<double>();
+  printf("one rise/set/twilight event on the host: float %.0f ns, double %.0f ns; "
+         "a whole screen is 9 events\n", f, d);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_london_midwinter);
+  RUN_TEST(test_boulder_midsummer);
+  RUN_TEST(test_svalbard_has_no_rise_or_set);
+  RUN_TEST(test_event_cost);
+  return UNITY_END();
+}
@@ -0,0 +1,86 @@
+// SWPC tail fetch against the stand-in: swFetch() asks each feed for its
+// last SW_TAIL_BYTES with a suffix Range. A server that honours it answers
+// 206 and sends only the tail; one that ignores it sends the whole body (200,
+// several KB per feed) through the ring; a feed shorter than the ring
+// arrives whole either way. Each case must parse the same latest Kp, speed
+// and Bz/Bt as the full array, and reports body bytes per feed and the peak
+// heap swFetch() allocates (the ring is on its stack, so it is not in it).
+#include <unity.h>
+
+#include "NativeHeap.h"
+#include "Firmware.h"
+#include "NoaaStandIn.h"
+
+static const char *const labels[SW_FEEDS] = { "k-index", "plasma", "mag" };
+
+// Latest values in the stand-in's feeds of `rows` rows
+static float speed_of(int rows) { return 380 + (rows - 1) % 40 + 0.4f; }
+static float bz_of(int rows)    { return -((rows - 1) % 9 + 0.15f); }
+
+// One swFetch() after a warm-up (the session is pooled from then on); checks
+// the parsed values and that each feed moved `expect(body)` bytes
+template <class Expect> static void fetch_and_check(const char *what, Expect expect) {
+  delete swFetch();
+  const int64_t base = native_heap_used;
+  nativeHeapPeakReset();
+  SwData *d = swFetch();
+  const int64_t peak = nativeHeapPeakAbove(base);
+  TEST_ASSERT_NOT_NULL(d);
+
+  const int rows = noaa().swpc_rows;
+  TEST_ASSERT_EQUAL_FLOAT(3.33f, d->kp);
+  TEST_ASSERT_EQUAL_STRING("15:00", d->kpTime.c_str());
+  TEST_ASSERT_EQUAL_FLOAT(speed_of(rows), d->speed);
+  TEST_ASSERT_EQUAL_FLOAT(bz_of(rows), d->bz);
+  TEST_ASSERT_EQUAL_FLOAT(5.71f, d->bt);
+  delete d;
+
+  printf("%-28s", what);
+  for (int i = 0; i < SW_FEEDS; i++) {
+    const size_t body = noaaSwpcJson(sw_feed_paths[i]).size();
+    printf("  %s %5d/%5u B", labels[i], (int)sw_feed_bytes[i], (unsigned)body);
+    TEST_ASSERT_EQUAL_INT32((int32_t)expect(body), sw_feed_bytes[i]);
+  }
+  printf("  peak heap %lld B\n", (long long)peak);
+  // What swFetch() keeps and the pipelined request, never a body or the ring
+  TEST_ASSERT_LESS_THAN_INT64(SW_TAIL_BYTES, peak);
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_range_answered_with_tails() {
+  noaa().swpc_range = true;
+  noaa().swpc_rows  = 200;
+  fetch_and_check("206, 200 rows:", [](size_t body) {
+    TEST_ASSERT_GREATER_THAN_UINT32(4 * SW_TAIL_BYTES, body);
+    return SW_TAIL_BYTES;
+  });
+}
+
+static void test_full_body_through_the_ring() {
+  noaa().swpc_range = false;
+  noaa().swpc_rows  = 200;
+  fetch_and_check("200 full body, 200 rows:", [](size_t body) { return body; });
+}
+
+static void test_body_shorter_than_the_ring() {
+  noaa().swpc_rows = 3;
+  for (bool range : { false, true }) {
+    noaa().swpc_range = range;
+    fetch_and_check(range ? "206, 3 rows:" : "200 full body, 3 rows:", [](size_t body) {
+      TEST_ASSERT_LESS_THAN_UINT32(SW_TAIL_BYTES, body);
+      return body;
+    });
+  }
+}
+
+int main(int argc, char **argv) {
+  TEST_ASSERT_TRUE_MESSAGE(NATIVE_HEAP_TRACKED, "heap tracking needs glibc");
+  noaaServe(300, 60);
+  UNITY_BEGIN();
+  RUN_TEST(test_range_answered_with_tails);
+  RUN_TEST(test_full_body_through_the_ring);
+  RUN_TEST(test_body_shorter_than_the_ring);
+  return UNITY_END();
+}